@@ -23,6 +23,7 @@ function M.get_fov(id) end
 ---@param z number 世界坐标 Z
 ---@return number screen_x 屏幕坐标 X
 ---@return number screen_y 屏幕坐标 Y
+---@overload fun(id: integer|native_node.Node, v: native_math.Vector3): number, number
 function M.unproject_position(id, x, y, z) end
 
 return M
@@ -3,9 +3,18 @@
 ---@class native_core
 local M = {}
 
+--- 帧阶段，按数值顺序执行。
+--- PRE_PHYSICS / PHYSICS 在 LuaHost.tick（物理帧）中派发，
+--- PROCESS / LATE / RENDER_PREP 在 LuaHost.process（渲染帧）中派发。
+M.PHASE_PRE_PHYSICS = 0
+M.PHASE_PHYSICS = 1
+M.PHASE_PROCESS = 2
+M.PHASE_LATE = 3
+M.PHASE_RENDER_PREP = 4
+
 --- native_core.bind_update(func) -> void
 --- 绑定 update 回调函数。
---- 该函数将在每个物理帧被调用。
+--- 该函数将在每个物理帧被调用，等价于 bind_phase(PHASE_PHYSICS, func, 0)；重复调用时替换上一次绑定。
 ---@param func fun(delta: number): void 接收 delta 参数的回调函数
 ---@return nil 绑定失败时由底层忽略或报错
 function M.bind_update(func) end
@@ -17,6 +26,21 @@ function M.bind_update(func) end
 ---@return nil 绑定失败时由底层忽略或报错
 function M.bind_shutdown(func) end
 
+--- native_core.bind_phase(phase, func, priority) -> integer
+--- 在指定阶段注册回调。同一阶段内 priority 小的先执行，相同优先级按注册顺序。
+--- 派发期间注册的回调从下一次派发开始生效；单个回调出错只打印，不影响后续回调。
+---@param phase integer 阶段（PHASE_*）
+---@param func fun(delta: number) 回调函数
+---@param priority? integer 优先级，默认 0
+---@return integer id 回调 id
+function M.bind_phase(phase, func, priority) end
+
+--- native_core.unbind_phase(id) -> boolean
+--- 注销回调。派发期间注销时，本次派发中不再调用。
+---@param id integer bind_phase 返回的 id
+---@return boolean ok id 有效时返回 true
+function M.unbind_phase(id) end
+
 --- native_core.quit(exit_code) -> void
 --- 请求优雅退出。
 ---@param exit_code? integer 退出码，默认 0
@@ -35,4 +59,99 @@ function M.set_time_scale(scale) end
 ---@return number 当前时间缩放倍率
 function M.get_time_scale() end
 
+--- native_core.get_fixed_delta() -> number
+--- 返回固定步长（秒），由 LuaHost.set_fixed_timestep 设置；未启用时返回 0。
+---@return number
+function M.get_fixed_delta() end
+
+--- native_core.get_interpolation_alpha() -> number
+--- 返回当前渲染帧位于最近两个固定步之间的比例（0..1），用于在 PROCESS / RENDER_PREP 阶段自行插值。
+--- 未启用固定步长时返回 1。
+---@return number
+function M.get_interpolation_alpha() end
+
+--- native_core.interpolate(node_id, enabled) -> boolean
+--- 登记 / 取消 Node3D 的原生变换插值。启用固定步长后，宿主在每个固定步结束时记录节点局部变换，
+--- 渲染帧在最近两个记录之间插值写回；下一个固定步开始前恢复为未插值的状态。
+--- 登记的节点只应在固定步（PRE_PHYSICS / PHYSICS 阶段、协程与定时器）中移动。
+---@param node_id integer native_node 句柄
+---@param enabled? boolean 默认 true
+---@return boolean ok 操作成功返回 true
+function M.interpolate(node_id, enabled) end
+
+--- native_core.reset_interpolation(node_id) -> boolean
+--- 以节点当前变换重置插值记录，用于瞬移，避免插值拖影。
+---@param node_id integer native_node 句柄
+---@return boolean ok 节点已登记时返回 true
+function M.reset_interpolation(node_id) end
+
+--- native_core.spawn(func, ...) -> integer
+--- 创建由原生调度器管理的协程，并立即运行到第一次等待。
+--- 协程内可调用 wait_frames / wait_seconds / wait_signal；直接 coroutine.yield() 视为等待一帧。
+--- 协程中的错误会带 traceback 打印，协程随即结束。
+---@param func function 协程函数
+---@param ... any 传给 func 的参数
+---@return integer handle 协程句柄
+function M.spawn(func, ...) end
+
+--- native_core.wait_frames(n) -> void
+--- 挂起当前协程 n 帧（tick 次数）。只能在 spawn 创建的协程中调用。
+---@param n? integer 帧数，默认 1，最少 1
+---@return nil
+function M.wait_frames(n) end
+
+--- native_core.wait_seconds(seconds) -> void
+--- 挂起当前协程指定的游戏时间（按 tick 的 delta 累计，受时间缩放影响）。
+--- seconds <= 0 时等待一帧。只能在 spawn 创建的协程中调用。
+---@param seconds number 秒数
+---@return nil
+function M.wait_seconds(seconds) end
+
+--- native_core.wait_signal(name) -> ...
+--- 挂起当前协程直到 emit_signal(name, ...) 被调用，返回 emit 的参数。
+--- 只能在 spawn 创建的协程中调用。
+---@param name string 信号名
+---@return any ... emit_signal 传入的参数
+function M.wait_signal(name) end
+
+--- native_core.emit_signal(name, ...) -> integer
+--- 唤醒所有等待该信号的协程，被唤醒的协程在下一次 tick 时恢复。
+---@param name string 信号名
+---@param ... any 作为 wait_signal 返回值的参数
+---@return integer count 被唤醒的协程数
+function M.emit_signal(name, ...) end
+
+--- native_core.cancel(handle) -> boolean
+--- 取消协程。协程取消自身时在下一次挂起后生效。
+---@param handle integer spawn 返回的句柄
+---@return boolean ok 句柄有效时返回 true
+function M.cancel(handle) end
+
+--- native_core.is_alive(handle) -> boolean
+--- 协程是否仍在调度中（未结束且未取消）。
+---@param handle integer spawn 返回的句柄
+---@return boolean
+function M.is_alive(handle) end
+
+---@class native_core.FloatBuffer
+--- 连续 float 数组，批量接口直接读写其内存。buf[i] 读写第 i 个元素（1 起始），#buf 为长度。
+--- 元素以 32 位浮点存储，写入的 number 会损失精度。
+local FloatBuffer = {}
+
+---@return integer size 元素个数
+function FloatBuffer:size() end
+
+---@param value number
+---@return native_core.FloatBuffer self
+function FloatBuffer:fill(value) end
+
+---@return number[] values 复制出的 Lua 数组
+function FloatBuffer:to_table() end
+
+--- native_core.float_buffer(size) -> FloatBuffer
+--- 创建元素初始化为 0 的 float 缓冲区。
+---@param size integer 元素个数
+---@return native_core.FloatBuffer buffer
+function M.float_buffer(size) end
+
 return M
@@ -0,0 +1,172 @@
+---@meta
+
+---@class native_debug
+local M = {}
+
+--- native_debug.profiler_start(interval) -> void
+--- 开始采样 Lua 调用栈。
+--- 每执行 interval 条 Lua 指令记录一次调用栈；重复调用只更新采样间隔。
+--- 开始之前已存在的协程不会被采样。
+---@param interval? integer 采样间隔（指令数），默认 1000
+---@return nil
+function M.profiler_start(interval) end
+
+--- native_debug.profiler_stop() -> void
+--- 停止采样，已有样本保留。
+---@return nil
+function M.profiler_stop() end
+
+--- native_debug.profiler_is_running() -> boolean
+--- 是否正在采样。
+---@return boolean
+function M.profiler_is_running() end
+
+--- native_debug.profiler_dump() -> string
+--- 导出 collapsed stack 文本，可直接交给 flamegraph.pl 或 speedscope。
+--- 每行格式："root;caller;callee <hits>"。
+---@return string text collapsed stack 文本
+function M.profiler_dump() end
+
+--- native_debug.profiler_get_sample_count() -> integer
+--- 返回累计样本数。
+---@return integer
+function M.profiler_get_sample_count() end
+
+--- native_debug.profiler_reset() -> void
+--- 清空所有样本。
+---@return nil
+function M.profiler_reset() end
+
+--- native_debug.alloc_track_start(interval) -> void
+--- 开始按 Lua 调用点（source:line）统计分配，用于定位热点函数中的临时表。
+--- 每 interval 次分配采样一次，样本归属到下一条执行的 Lua 指令所在行；
+--- 在 C 函数（如 string.format）内的分配归属到调用它的 Lua 行。
+---@param interval? integer 采样间隔（分配次数），默认 64
+---@return nil
+function M.alloc_track_start(interval) end
+
+--- native_debug.alloc_track_stop() -> void
+--- 停止统计，已有统计保留。
+---@return nil
+function M.alloc_track_stop() end
+
+--- native_debug.alloc_track_is_running() -> boolean
+---@return boolean
+function M.alloc_track_is_running() end
+
+---@class native_debug.AllocSite
+---@field site string 调用点，格式 "source:line"
+---@field bytes integer 估算分配字节数（样本字节数 × 采样间隔）
+---@field count integer 估算分配次数
+
+--- native_debug.alloc_top(n, frame) -> table
+--- 返回分配字节数最多的 n 个调用点（降序）。
+---@param n? integer 最多返回的调用点数，默认 20
+---@param frame? boolean 为 true 时按上一帧统计，否则按自 start / reset 起的累计值
+---@return native_debug.AllocSite[]
+function M.alloc_top(n, frame) end
+
+--- native_debug.alloc_track_reset() -> void
+--- 清空所有调用点统计。
+---@return nil
+function M.alloc_track_reset() end
+
+--- native_debug.zone_begin(name) -> integer
+--- 开始一个时间线区间，返回令牌，传给 zone_end 结束。未在记录时直接返回 0，可常驻代码中。
+--- 未结束的区间（如 update 中途出错跳过了 zone_end）在下一次 tick 开始时丢弃。
+---@param name string 区间名
+---@return integer token
+function M.zone_begin(name) end
+
+--- native_debug.zone_end(token) -> void
+--- 结束 token 对应的区间，其上未结束的区间一并丢弃；省略 token 时结束最近一个区间，token 为 0 时什么也不做。
+---@param token? integer zone_begin 返回的令牌
+---@return nil
+function M.zone_end(token) end
+
+--- native_debug.trace_start(capacity) -> void
+--- 开始记录帧时间线（原生区间与 Lua 区间）并清空已有事件。
+--- 原生区间包括 LuaHost.tick、core_call_update、input_dispatch_event、GC 步进、
+--- 调试绘制提交、动画更新与碰撞查询。
+---@param capacity? integer 环形缓冲容量（事件数），默认 65536，写满后覆盖最旧的事件
+---@return nil
+function M.trace_start(capacity) end
+
+--- native_debug.trace_stop() -> void
+--- 停止记录，已有事件保留。
+---@return nil
+function M.trace_stop() end
+
+--- native_debug.trace_dump() -> string
+--- 导出 Chrome trace event JSON，可在 chrome://tracing 或 Perfetto UI 中打开。
+---@return string
+function M.trace_dump() end
+
+---@class native_debug.MemoryStat
+---@field entries integer 条目数（lua.heap 为 0，debug_draw.buckets 为顶点数）
+---@field bytes integer 估算字节数（容器与记录内数组，不含引用的 Godot 对象与资源）
+---@field peak_entries integer 条目数高水位
+---@field peak_bytes integer 字节数高水位
+---@field delta_entries integer diff 模式下相对上一次快照的变化
+---@field delta_bytes integer diff 模式下相对上一次快照的变化
+
+--- native_debug.memory_stats(diff) -> table
+--- 返回各模块表（native_node.nodes、native_anim.animators、native_audio.players、
+--- signal_binding.bindings、native_res.loaded_resources、native_debug_draw.* 等）与 Lua 堆的占用估算。
+--- diff 为 true 时计算相对上一次 diff 查询的变化，并记录新的快照，用于排查泄漏。
+---@param diff? boolean
+---@return table<string, native_debug.MemoryStat>
+function M.memory_stats(diff) end
+
+--- native_debug.memory_stats_reset() -> void
+--- 清除高水位与 diff 快照。
+---@return nil
+function M.memory_stats_reset() end
+
+--- native_debug.binding_stats_enabled() -> boolean
+--- 构建时是否启用了绑定统计（CMake 选项 LUAGD_BINDING_STATS）。
+---@return boolean
+function M.binding_stats_enabled() end
+
+---@class native_debug.BindingStat
+---@field calls integer 自上次重置起的调用次数
+---@field nsec integer 自上次重置起的累计耗时（纳秒）
+---@field frame_calls integer 上一帧的调用次数
+---@field frame_nsec integer 上一帧的累计耗时（纳秒）
+
+--- native_debug.binding_stats() -> table
+--- 返回每个原生绑定函数的调用统计，按模块与函数名索引。
+--- 例：stats.native_node.get_position.calls
+--- 未启用绑定统计时返回空表。
+---@return table<string, table<string, native_debug.BindingStat>>
+function M.binding_stats() end
+
+--- native_debug.binding_stats_reset() -> void
+--- 清零所有绑定统计。
+---@return nil
+function M.binding_stats_reset() end
+
+---@class native_debug.ErrorRecord
+---@field func string 出错的函数，如 "native_transform.set_position"
+---@field message string 最近一次输出的消息
+---@field count integer 自上次重置起的累计次数（含被抑制的）
+---@field suppressed integer 自上次输出以来被抑制的次数
+
+--- native_debug.error_summary() -> table
+--- 返回原生模块参数 / 句柄错误的汇总，按累计次数降序。
+--- 同一函数的同一种错误每个输出间隔内只输出一次，其余只计数。
+---@return native_debug.ErrorRecord[]
+function M.error_summary() end
+
+--- native_debug.error_summary_reset() -> void
+--- 清空错误汇总。
+---@return nil
+function M.error_summary_reset() end
+
+--- native_debug.set_error_interval(msec) -> void
+--- 设置同一错误的最短输出间隔。
+---@param msec integer 间隔（毫秒），默认 1000，0 表示每次都输出
+---@return nil
+function M.set_error_interval(msec) end
+
+return M
@@ -0,0 +1,281 @@
+---@meta
+
+---@class native_math
+--- userdata 形式的 Vector3 / Quaternion / Transform3D。
+--- 运算符（+ - * / 等）返回新对象；*_in_place 方法直接修改自身并返回 self，每帧重复使用同一对象时不产生垃圾。
+--- native_transform / native_physics / native_camera / native_skeleton 中接受 x, y, z 的参数可直接传入 Vector3，
+--- 返回 x, y, z 的 getter 可传入 Vector3 作为输出参数。
+--- 角度均为度数，欧拉角顺序为 YXZ（与 Node3D 默认一致）。
+---
+---   local velocity = native_math.vec3(0, 0, 0)
+---   local position = native_transform.get_position(id, false, native_math.vec3())
+---   position:add_scaled_in_place(velocity, delta)
+---   native_transform.set_position(id, position)
+local M = {}
+
+-- ============================================================================
+-- Vector3
+-- ============================================================================
+
+---@class native_math.Vector3
+---@field x number
+---@field y number
+---@field z number
+---@operator add(native_math.Vector3): native_math.Vector3
+---@operator sub(native_math.Vector3): native_math.Vector3
+---@operator mul(native_math.Vector3|number): native_math.Vector3
+---@operator div(native_math.Vector3|number): native_math.Vector3
+---@operator unm: native_math.Vector3
+local Vector3 = {}
+
+---@return number
+function Vector3:length() end
+
+---@return number
+function Vector3:length_squared() end
+
+---@return native_math.Vector3
+function Vector3:normalized() end
+
+---@param b native_math.Vector3
+---@return number
+function Vector3:dot(b) end
+
+---@param b native_math.Vector3
+---@return native_math.Vector3
+function Vector3:cross(b) end
+
+---@param b native_math.Vector3
+---@return number
+function Vector3:distance_to(b) end
+
+---@param b native_math.Vector3
+---@return number
+function Vector3:distance_squared_to(b) end
+
+---@param b native_math.Vector3
+---@param t number
+---@return native_math.Vector3
+function Vector3:lerp(b, t) end
+
+---@return native_math.Vector3
+function Vector3:copy() end
+
+---@return number x
+---@return number y
+---@return number z
+function Vector3:unpack() end
+
+--- 设置分量：v:set(x, y, z) 或 v:set(b)。
+---@param x number|native_math.Vector3
+---@param y? number
+---@param z? number
+---@return native_math.Vector3 self
+function Vector3:set(x, y, z) end
+
+---@param b native_math.Vector3
+---@return native_math.Vector3 self
+function Vector3:add_in_place(b) end
+
+---@param b native_math.Vector3
+---@return native_math.Vector3 self
+function Vector3:sub_in_place(b) end
+
+---@param b native_math.Vector3|number
+---@return native_math.Vector3 self
+function Vector3:mul_in_place(b) end
+
+--- self += b * s，常用于 position += velocity * delta。
+---@param b native_math.Vector3
+---@param s number
+---@return native_math.Vector3 self
+function Vector3:add_scaled_in_place(b, s) end
+
+---@return native_math.Vector3 self
+function Vector3:normalize_in_place() end
+
+---@param b native_math.Vector3
+---@param t number
+---@return native_math.Vector3 self
+function Vector3:lerp_in_place(b, t) end
+
+-- ============================================================================
+-- Quaternion
+-- ============================================================================
+
+---@class native_math.Quaternion
+---@field x number
+---@field y number
+---@field z number
+---@field w number
+---@operator mul(native_math.Quaternion): native_math.Quaternion
+---@operator mul(native_math.Vector3): native_math.Vector3
+local Quaternion = {}
+
+---@return native_math.Quaternion
+function Quaternion:normalized() end
+
+---@return native_math.Quaternion
+function Quaternion:inverse() end
+
+---@param b native_math.Quaternion
+---@return number
+function Quaternion:dot(b) end
+
+---@param b native_math.Quaternion
+---@param t number
+---@return native_math.Quaternion
+function Quaternion:slerp(b, t) end
+
+--- 旋转向量，等价于 q * v。
+---@param v native_math.Vector3
+---@return native_math.Vector3
+function Quaternion:xform(v) end
+
+--- 欧拉角（度数，YXZ 顺序）。
+---@return native_math.Vector3
+function Quaternion:to_euler() end
+
+---@return native_math.Quaternion
+function Quaternion:copy() end
+
+---@return number x
+---@return number y
+---@return number z
+---@return number w
+function Quaternion:unpack() end
+
+---@param b native_math.Quaternion
+---@return native_math.Quaternion self
+function Quaternion:set(b) end
+
+---@param b native_math.Quaternion
+---@return native_math.Quaternion self
+function Quaternion:mul_in_place(b) end
+
+---@return native_math.Quaternion self
+function Quaternion:normalize_in_place() end
+
+---@param b native_math.Quaternion
+---@param t number
+---@return native_math.Quaternion self
+function Quaternion:slerp_in_place(b, t) end
+
+-- ============================================================================
+-- Transform3D
+-- ============================================================================
+
+---@class native_math.Transform3D
+---@operator mul(native_math.Transform3D): native_math.Transform3D
+---@operator mul(native_math.Vector3): native_math.Vector3
+local Transform3D = {}
+
+--- 平移分量。out 为 Vector3 时写入并返回 out。
+---@param out? native_math.Vector3
+---@return native_math.Vector3
+function Transform3D:origin(out) end
+
+--- 缩放分量。out 为 Vector3 时写入并返回 out。
+---@param out? native_math.Vector3
+---@return native_math.Vector3
+function Transform3D:scale(out) end
+
+---@return native_math.Quaternion
+function Transform3D:rotation() end
+
+--- 仿射逆（允许缩放）。
+---@return native_math.Transform3D
+function Transform3D:inverse() end
+
+--- 变换点，等价于 t * v。
+---@param v native_math.Vector3
+---@return native_math.Vector3
+function Transform3D:xform(v) end
+
+--- 逆变换点，仅适用于正交基（无缩放）。
+---@param v native_math.Vector3
+---@return native_math.Vector3
+function Transform3D:xform_inv(v) end
+
+---@return native_math.Transform3D
+function Transform3D:copy() end
+
+---@param b native_math.Transform3D
+---@return native_math.Transform3D self
+function Transform3D:set(b) end
+
+---@param x number|native_math.Vector3
+---@param y? number
+---@param z? number
+---@return native_math.Transform3D self
+function Transform3D:set_origin(x, y, z) end
+
+--- 设置旋转，保留缩放。
+---@param q native_math.Quaternion
+---@return native_math.Transform3D self
+function Transform3D:set_rotation(q) end
+
+--- 设置缩放，保留旋转。
+---@param x number|native_math.Vector3
+---@param y? number
+---@param z? number
+---@return native_math.Transform3D self
+function Transform3D:set_scale(x, y, z) end
+
+--- 世界空间平移。
+---@param x number|native_math.Vector3
+---@param y? number
+---@param z? number
+---@return native_math.Transform3D self
+function Transform3D:translate_in_place(x, y, z) end
+
+--- self = self * b
+---@param b native_math.Transform3D
+---@return native_math.Transform3D self
+function Transform3D:mul_in_place(b) end
+
+-- ============================================================================
+-- 构造
+-- ============================================================================
+
+--- native_math.vec3(x, y, z) -> Vector3
+--- 省略参数时为零向量；也可传入 Vector3 复制。
+---@param x? number|native_math.Vector3
+---@param y? number
+---@param z? number
+---@return native_math.Vector3
+function M.vec3(x, y, z) end
+
+--- native_math.quat(x, y, z, w) -> Quaternion
+--- 省略参数时为单位四元数。
+---@param x? number
+---@param y? number
+---@param z? number
+---@param w? number
+---@return native_math.Quaternion
+function M.quat(x, y, z, w) end
+
+--- native_math.quat_from_euler(x, y, z) -> Quaternion
+--- 由欧拉角（度数，YXZ 顺序）构造，也可传入 Vector3。
+---@param x number|native_math.Vector3
+---@param y? number
+---@param z? number
+---@return native_math.Quaternion
+function M.quat_from_euler(x, y, z) end
+
+--- native_math.quat_from_axis_angle(axis, degrees) -> Quaternion
+--- axis 会被归一化，不能为零向量。
+---@param axis native_math.Vector3
+---@param degrees number
+---@return native_math.Quaternion
+function M.quat_from_axis_angle(axis, degrees) end
+
+--- native_math.transform(origin?, rotation?, scale?) -> Transform3D
+--- 省略的部分取单位值。
+---@param origin? native_math.Vector3
+---@param rotation? native_math.Quaternion
+---@param scale? native_math.Vector3
+---@return native_math.Transform3D
+function M.transform(origin, rotation, scale) end
+
+return M
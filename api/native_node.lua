@@ -1,8 +1,31 @@
 ---@meta
 
 ---@class native_node
+--- 节点句柄为不透明整数（槽位 + 代数），不是 Godot 的 ObjectID。
+--- 节点被释放或 destroy 后旧句柄失效；碰撞回调等返回的 ObjectID 需经 find_registered_ancestor 转为句柄。
+--- find / wrap / Node:get_child 返回 native_node.Node userdata，所有接受节点句柄的 native 接口都可直接传入。
 local M = {}
 
+---@class native_node.Node
+--- userdata 节点句柄。同一节点始终返回同一个 userdata，可用作表键。
+--- 方法：本模块的 get_child / get_child_by_path / id / is_valid / destroy / get_name / get_type / get_child_count，
+--- 以及已 require 的 native_transform / native_physics / native_camera / native_skeleton / native_ui / native_particles
+--- 中以节点为第一个参数的函数（h:set_position(v) 等价于 native_transform.set_position(h, v)）；
+--- 批量与变换组接口（set_positions、create_group、group_* 等）不是方法。
+--- 被回收时：若该节点的整数句柄从未交给 Lua（未调用 id()，也不是由返回整数的接口取得），释放 native 记录；节点本身不受影响。
+local Node = {}
+
+--- Node:get_child(path) -> Node|nil
+--- 查找子节点并返回 userdata 句柄。
+---@param path string 子节点路径
+---@return native_node.Node|nil child 子节点，失败返回 nil
+function Node:get_child(path) end
+
+--- Node:id() -> int
+--- 返回整数句柄。调用后该节点记录不再随 userdata 回收释放，需 destroy 释放。
+---@return integer id 节点句柄
+function Node:id() end
+
 -- ============================================================================
 -- 节点引用管理
 -- ============================================================================
@@ -23,7 +46,7 @@ function M.instantiate(scene_path) end
 --- native_node.destroy(id) -> void
 --- 销毁节点或释放节点记录。
 --- 通过 instantiate 创建的节点会 queue_free；引用节点仅释放 native 记录。
----@param id integer 节点句柄
+---@param id integer|native_node.Node 节点句柄
 ---@return nil id 无效时通常会被底层忽略
 function M.destroy(id) end
 
@@ -35,45 +58,57 @@ function M.get_node_by_path(path) end
 
 --- native_node.get_child_by_path(id, path) -> int
 --- 基于指定节点查找任意类型的子节点并返回句柄。
----@param id integer 父节点句柄
+---@param id integer|native_node.Node 父节点句柄
 ---@param path string 子节点路径（如 "target" 或 "bones/spine"）
 ---@return integer child_id 子节点句柄，失败返回 -1
 function M.get_child_by_path(id, path) end
 
 --- native_node.is_valid(id) -> boolean
---- 检查节点引用是否有效。
----@param id integer 节点句柄
+--- 检查节点引用是否有效（句柄未失效且节点在场景树内）。
+---@param id integer|native_node.Node 节点句柄
 ---@return boolean valid 是否有效
 function M.is_valid(id) end
 
+--- native_node.find(path) -> Node|nil
+--- 与 get_node_by_path 相同，但返回 userdata 句柄。
+---@param path string 全局节点路径
+---@return native_node.Node|nil node 节点，失败返回 nil
+function M.find(path) end
+
+--- native_node.wrap(id) -> Node|nil
+--- 把整数句柄包装为 userdata 句柄。整数句柄已经流出，回收 userdata 不会释放记录。
+---@param id integer|native_node.Node 节点句柄
+---@return native_node.Node|nil node 节点，句柄无效时返回 nil
+function M.wrap(id) end
+
 -- ============================================================================
 -- 信息
 -- ============================================================================
 
 --- native_node.get_name(id) -> string
 --- 获取节点名称。
----@param id integer 节点句柄
+---@param id integer|native_node.Node 节点句柄
 ---@return string name 节点名称
 function M.get_name(id) end
 
 --- native_node.get_type(id) -> string
 --- 获取节点当前的 Godot 运行时类型。
----@param id integer 节点句柄
+---@param id integer|native_node.Node 节点句柄
 ---@return string type 节点类型字符串（如 "Node3D"、"CharacterBody3D"、"Control"、"CanvasLayer"）
 function M.get_type(id) end
 
 --- native_node.get_child_count(id, include_internal) -> int
 --- 获取节点直接子节点数量。
----@param id integer 节点句柄
+---@param id integer|native_node.Node 节点句柄
 ---@param include_internal boolean (可选) 是否计入内部子节点，默认 false
 ---@return integer count 子节点数量，节点无效时返回 -1
 function M.get_child_count(id, include_internal) end
 
 --- native_node.find_registered_ancestor(node_id) -> int
---- 从给定的节点 ID 向上查找第一个已注册的祖先节点。
---- 如果节点本身已注册，返回自己的 ID。
----@param node_id integer 任意节点的 ObjectID（可以是未注册的）
----@return integer ancestor_id 已注册祖先节点的 ID，如果找不到返回 -1
+--- 从给定的节点 ObjectID 向上查找第一个已注册的祖先节点。
+--- 如果节点本身已注册，返回自己的句柄。
+---@param node_id integer 任意节点的 ObjectID（可以是未注册的），如碰撞回调返回的 body_id
+---@return integer ancestor_id 已注册祖先节点的句柄，如果找不到返回 -1
 function M.find_registered_ancestor(node_id) end
 
 return M
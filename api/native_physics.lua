@@ -33,6 +33,7 @@ function M.move_and_slide(id) end
 ---@return number position_y
 ---@return number position_z
 ---@return integer collider_id
+---@overload fun(id: integer|native_node.Node, motion: native_math.Vector3, test_only?: boolean, safe_margin?: number, recovery_as_collision?: boolean, max_collisions?: integer): boolean, number, number, number, number, number, number, number, number, number, number, number, number, integer
 function M.move_and_collide(id, x, y, z, test_only, safe_margin, recovery_as_collision, max_collisions) end
 
 --- native_physics.set_velocity(id, x, y, z) -> void
@@ -41,6 +42,7 @@ function M.move_and_collide(id, x, y, z, test_only, safe_margin, recovery_as_col
 ---@param x number
 ---@param y number
 ---@param z number
+---@overload fun(id: integer|native_node.Node, v: native_math.Vector3)
 function M.set_velocity(id, x, y, z) end
 
 --- native_physics.get_velocity(id) -> number, number, number
@@ -49,6 +51,7 @@ function M.set_velocity(id, x, y, z) end
 ---@return number x
 ---@return number y
 ---@return number z
+---@overload fun(id: integer|native_node.Node, out: native_math.Vector3): native_math.Vector3
 function M.get_velocity(id) end
 
 --- native_physics.get_real_velocity(id) -> number, number, number
@@ -57,6 +60,7 @@ function M.get_velocity(id) end
 ---@return number x
 ---@return number y
 ---@return number z
+---@overload fun(id: integer|native_node.Node, out: native_math.Vector3): native_math.Vector3
 function M.get_real_velocity(id) end
 
 --- native_physics.is_on_floor(id) -> boolean
@@ -83,6 +87,7 @@ function M.is_on_ceiling(id) end
 ---@return number nx
 ---@return number ny
 ---@return number nz
+---@overload fun(id: integer|native_node.Node, out: native_math.Vector3): native_math.Vector3
 function M.get_floor_normal(id) end
 
 --- native_physics.set_collision_layer(id, layer) -> void
@@ -31,6 +31,7 @@ function M.get_bone_name(skeleton_node_id, bone_idx) end
 ---@param y number Y 坐标
 ---@param z number Z 坐标
 ---@param is_global? boolean true=世界坐标，false=局部坐标
+---@overload fun(skeleton_node_id: integer|native_node.Node, bone_name: string, v: native_math.Vector3, is_global?: boolean)
 function M.set_bone_position(skeleton_node_id, bone_name, x, y, z, is_global) end
 
 --- native_skeleton.get_bone_position(skeleton_node_id, bone_name, is_global) -> number, number, number
@@ -51,6 +52,7 @@ function M.get_bone_position(skeleton_node_id, bone_name, is_global) end
 ---@param y number Y 轴旋转（度数）
 ---@param z number Z 轴旋转（度数）
 ---@param is_global? boolean true=世界旋转，false=局部旋转
+---@overload fun(skeleton_node_id: integer|native_node.Node, bone_name: string, v: native_math.Vector3, is_global?: boolean)
 function M.set_bone_rotation(skeleton_node_id, bone_name, x, y, z, is_global) end
 
 --- native_skeleton.get_bone_rotation(skeleton_node_id, bone_name, is_global) -> number, number, number
@@ -71,6 +73,7 @@ function M.get_bone_rotation(skeleton_node_id, bone_name, is_global) end
 ---@param y number Y 缩放
 ---@param z number Z 缩放
 ---@param is_global? boolean true=世界缩放，false=局部缩放
+---@overload fun(skeleton_node_id: integer|native_node.Node, bone_name: string, v: native_math.Vector3, is_global?: boolean)
 function M.set_bone_scale(skeleton_node_id, bone_name, x, y, z, is_global) end
 
 --- native_skeleton.get_bone_scale(skeleton_node_id, bone_name, is_global) -> number, number, number
@@ -0,0 +1,44 @@
+---@meta
+
+---@class native_timer
+local M = {}
+
+--- native_timer.after(seconds, callback) -> integer
+--- 在 seconds 秒后调用一次 callback(handle)。时间随 LuaHost.tick 的 delta 推进，精度 1 毫秒。
+--- seconds <= 0 时在下一次 tick 触发。
+---@param seconds number 延迟秒数
+---@param callback fun(handle: integer) 回调
+---@return integer handle 定时器句柄
+function M.after(seconds, callback) end
+
+--- native_timer.every(seconds, callback) -> integer
+--- 每隔 seconds 秒调用 callback(handle)，直到 cancel。
+--- 一帧跨过多个周期时只触发一次，不补发。
+---@param seconds number 间隔秒数（至少 1 毫秒）
+---@param callback fun(handle: integer) 回调
+---@return integer handle 定时器句柄
+function M.every(seconds, callback) end
+
+--- native_timer.cancel(handle) -> boolean
+--- 取消定时器，可在回调中调用。
+---@param handle integer
+---@return boolean ok 句柄有效时返回 true
+function M.cancel(handle) end
+
+--- native_timer.is_active(handle) -> boolean
+---@param handle integer
+---@return boolean
+function M.is_active(handle) end
+
+--- native_timer.remaining(handle) -> number|nil
+--- 返回距下次触发的秒数；句柄无效时返回 nil。
+---@param handle integer
+---@return number|nil
+function M.remaining(handle) end
+
+--- native_timer.count() -> integer
+--- 返回活动定时器数量。
+---@return integer
+function M.count() end
+
+return M
@@ -1,27 +1,32 @@
 ---@meta
 
 ---@class native_transform
+--- 接受 x, y, z 的接口同样接受 native_math.Vector3；返回 x, y, z 的 getter 可传入 Vector3 作为输出参数。
 local M = {}
 
 --- native_transform.set_position(id, x, y, z?, is_global?) -> void
 --- 设置节点位置。
 --- Node3D: 需要 x, y, z 三个参数，第 5 个参数为 is_global。
 --- Control: 需要 x, y 两个参数，第 3 或第 4 个参数为 is_global。
+--- 也可传入 native_math.Vector3，此时 is_global 紧随其后（Control 忽略 z）。
 ---@param id integer 节点句柄
 ---@param x number X 坐标
 ---@param y number Y 坐标
 ---@param z? number Z 坐标（Control 可省略）
 ---@param is_global? boolean true 为世界坐标，false 为局部坐标
+---@overload fun(id: integer|native_node.Node, v: native_math.Vector3, is_global?: boolean)
 function M.set_position(id, x, y, z, is_global) end
 
 --- native_transform.get_position(id, is_global?) -> number, number, number | number, number
 --- 获取节点位置。
 --- Node3D 返回 (x, y, z)，Control 返回 (x, y)。
+--- 第 3 个参数为 native_math.Vector3 时写入并返回它（Control 的 z 为 0），不产生新对象。
 ---@param id integer 节点句柄
 ---@param is_global? boolean true 为世界坐标，false 为局部坐标
 ---@return number x
 ---@return number y
 ---@return number? z Node3D 返回 z，Control 不返回
+---@overload fun(id: integer|native_node.Node, is_global: boolean|nil, out: native_math.Vector3): native_math.Vector3
 function M.get_position(id, is_global) end
 
 --- native_transform.get_scale(id, is_global?) -> number, number, number | number, number
@@ -32,6 +37,7 @@ function M.get_position(id, is_global) end
 ---@return number x
 ---@return number y
 ---@return number? z Node3D 返回 z，Control 不返回
+---@overload fun(id: integer|native_node.Node, is_global: boolean|nil, out: native_math.Vector3): native_math.Vector3
 function M.get_scale(id, is_global) end
 
 --- native_transform.set_scale(id, x, y, z?) -> void
@@ -41,15 +47,17 @@ function M.get_scale(id, is_global) end
 ---@param x number X 缩放
 ---@param y number Y 缩放
 ---@param z? number Z 缩放（Control 可省略）
+---@overload fun(id: integer|native_node.Node, v: native_math.Vector3)
 function M.set_scale(id, x, y, z) end
 
 --- native_transform.set_rotation(id, x, y, z, is_global) -> void
---- 设置节点旋转（度数）。
+--- 设置节点旋转（度数）。也可传入 native_math.Vector3（度数）或 native_math.Quaternion（保留缩放）。
 ---@param id integer 节点句柄
 ---@param x number X 轴旋转
 ---@param y number Y 轴旋转
 ---@param z number Z 轴旋转
 ---@param is_global? boolean true 为世界旋转，false 为局部旋转
+---@overload fun(id: integer|native_node.Node, v: native_math.Vector3|native_math.Quaternion, is_global?: boolean)
 function M.set_rotation(id, x, y, z, is_global) end
 
 --- native_transform.get_rotation(id, is_global) -> number, number, number
@@ -59,6 +67,7 @@ function M.set_rotation(id, x, y, z, is_global) end
 ---@return number x
 ---@return number y
 ---@return number z
+---@overload fun(id: integer|native_node.Node, is_global: boolean|nil, out: native_math.Vector3): native_math.Vector3
 function M.get_rotation(id, is_global) end
 
 --- native_transform.look_at(id, target_x, target_y, target_z, use_model_front) -> void
@@ -68,6 +77,7 @@ function M.get_rotation(id, is_global) end
 ---@param target_y number 目标 Y 坐标
 ---@param target_z number 目标 Z 坐标
 ---@param use_model_front? boolean true 时 +Z 指向目标，false 时 -Z 指向目标
+---@overload fun(id: integer|native_node.Node, target: native_math.Vector3, use_model_front?: boolean)
 function M.look_at(id, target_x, target_y, target_z, use_model_front) end
 
 --- native_transform.get_forward(id, is_global, use_model_front) -> number, number, number
@@ -78,6 +88,145 @@ function M.look_at(id, target_x, target_y, target_z, use_model_front) end
 ---@return number x
 ---@return number y
 ---@return number z
+---@overload fun(id: integer|native_node.Node, is_global: boolean|nil, use_model_front: boolean|nil, out: native_math.Vector3): native_math.Vector3
 function M.get_forward(id, is_global, use_model_front) end
 
+--- native_transform.set_transform(id, transform, is_global?) -> void
+--- 以 native_math.Transform3D 设置节点变换。仅支持 Node3D。
+---@param id integer|native_node.Node 节点句柄
+---@param transform native_math.Transform3D
+---@param is_global? boolean true 为世界变换，false 为局部变换
+function M.set_transform(id, transform, is_global) end
+
+--- native_transform.get_transform(id, is_global?, out?) -> Transform3D
+--- 获取节点变换。out 为 native_math.Transform3D 时写入并返回它，否则新建。仅支持 Node3D。
+---@param id integer|native_node.Node 节点句柄
+---@param is_global? boolean true 为世界变换，false 为局部变换
+---@param out? native_math.Transform3D
+---@return native_math.Transform3D|nil transform 节点无效时返回 nil
+function M.get_transform(id, is_global, out) end
+
+-- ============================================================================
+-- 批量接口
+-- ids 为句柄数组，values 为按实体连续排列的 float 数据（native_core.float_buffer 或 Lua 数组），
+-- 一次调用处理所有实体。单个实体无效时报告错误并跳过。FloatBuffer 直接读写内存，比 Lua 数组更快。
+-- ============================================================================
+
+--- native_transform.set_positions(ids, values, is_global?) -> int
+--- 批量设置位置，每个实体 3 个元素 (x, y, z)。Control 使用 (x, y)，忽略 z。
+---@param ids (integer|native_node.Node)[] 节点句柄数组
+---@param values native_core.FloatBuffer|number[] 至少 #ids * 3 个元素
+---@param is_global? boolean true 为世界坐标，false 为局部坐标
+---@return integer applied 成功设置的实体数
+function M.set_positions(ids, values, is_global) end
+
+--- native_transform.get_positions(ids, is_global?, out?) -> FloatBuffer|number[]
+--- 批量读取位置，每个实体写入 3 个元素 (x, y, z)。Control 写入 (x, y, 0)，无效实体写入 (0, 0, 0)。
+---@param ids (integer|native_node.Node)[] 节点句柄数组
+---@param is_global? boolean true 为世界坐标，false 为局部坐标
+---@param out? native_core.FloatBuffer|number[] 输出位置，省略时新建 Lua 数组；FloatBuffer 需至少 #ids * 3 个元素
+---@return native_core.FloatBuffer|number[] out
+function M.get_positions(ids, is_global, out) end
+
+--- native_transform.set_rotations(ids, values, is_global?) -> int
+--- 批量设置旋转（度数），每个实体 3 个元素 (x, y, z)。仅支持 Node3D。
+---@param ids (integer|native_node.Node)[] 节点句柄数组
+---@param values native_core.FloatBuffer|number[] 至少 #ids * 3 个元素
+---@param is_global? boolean true 为世界旋转，false 为局部旋转
+---@return integer applied 成功设置的实体数
+function M.set_rotations(ids, values, is_global) end
+
+--- native_transform.set_transforms(ids, values, is_global?) -> int
+--- 批量设置位置、旋转（度数）与缩放，每个实体 9 个元素 (px, py, pz, rx, ry, rz, sx, sy, sz)。
+--- Node3D 每个实体只调用一次 set_transform，旋转按节点的 rotation_order 合成。
+--- Control 使用 (px, py)、rz 与 (sx, sy)，is_global 只影响位置。
+---@param ids (integer|native_node.Node)[] 节点句柄数组
+---@param values native_core.FloatBuffer|number[] 至少 #ids * 9 个元素
+---@param is_global? boolean true 为世界变换，false 为局部变换
+---@return integer applied 成功设置的实体数
+function M.set_transforms(ids, values, is_global) end
+
+-- ============================================================================
+-- 变换组
+-- 登记的 Node3D 的位置 / 旋转（度数）/ 缩放分别保存在三个 FloatBuffer 中，实体 i 的 x, y, z
+-- 位于 [(i - 1) * 3 + 1, (i - 1) * 3 + 3]。脚本直接读写缓冲区，每次 update 之后（或调用 group_flush 时）
+-- 只把有变化的实体写回节点，每个实体一次 set_transform。
+--
+--   local group = native_transform.create_group(1024)
+--   local index = native_transform.group_add(group, enemy)
+--   local positions = native_transform.group_buffers(group)
+--   positions[(index - 1) * 3 + 2] = positions[(index - 1) * 3 + 2] + dy
+-- ============================================================================
+
+--- native_transform.create_group(capacity, is_global?) -> int
+--- 创建变换组。缓冲区按容量一次分配，之后地址不变。
+---@param capacity integer 最大实体数
+---@param is_global? boolean true 时读写世界变换，false 为局部变换
+---@return integer group_id 组 id
+function M.create_group(capacity, is_global) end
+
+--- native_transform.destroy_group(group_id) -> void
+--- 销毁变换组，不影响节点。仍持有的缓冲区保持有效，但不再写回。
+---@param group_id integer 组 id
+function M.destroy_group(group_id) end
+
+--- native_transform.group_add(group_id, id) -> int|nil
+--- 把 Node3D 加入组，读取其当前变换作为初值。组持有句柄，userdata 句柄被回收时不会释放节点记录。
+---@param group_id integer 组 id
+---@param id integer|native_node.Node 节点句柄
+---@return integer|nil index 1 起始的实体序号，组已满或节点不是 Node3D 时返回 nil
+function M.group_add(group_id, id) end
+
+--- native_transform.group_remove(group_id, index) -> int|nil
+--- 移除实体，最后一个实体移动到 index 以保持数组紧密。
+---@param group_id integer 组 id
+---@param index integer 实体序号
+---@return integer|nil moved_from 被移动实体原来的序号，移除的就是最后一个时返回 nil
+function M.group_remove(group_id, index) end
+
+--- native_transform.group_count(group_id) -> int
+---@param group_id integer 组 id
+---@return integer count 实体数
+function M.group_count(group_id) end
+
+--- native_transform.group_get_node(group_id, index) -> int
+---@param group_id integer 组 id
+---@param index integer 实体序号
+---@return integer id 节点句柄
+function M.group_get_node(group_id, index) end
+
+--- native_transform.group_buffers(group_id) -> FloatBuffer, FloatBuffer, FloatBuffer
+--- 返回组的位置、旋转（度数）、缩放缓冲区，每个实体 3 个元素。
+---@param group_id integer 组 id
+---@return native_core.FloatBuffer positions
+---@return native_core.FloatBuffer rotations
+---@return native_core.FloatBuffer scales
+function M.group_buffers(group_id) end
+
+--- native_transform.group_mark_dirty(group_id, index, count?) -> void
+--- 强制下一次 flush 写回 [index, index + count) 的实体，即使缓冲区的值未变（节点被其他逻辑改动后用于覆盖）。
+--- 直接写缓冲区不需要调用：flush 会与上次写回的值比较，自动发现变化。
+---@param group_id integer 组 id
+---@param index integer 起始实体序号
+---@param count? integer 实体数，默认 1
+function M.group_mark_dirty(group_id, index, count) end
+
+--- native_transform.group_pull(group_id) -> int
+--- 从节点重新读取所有实体的变换，丢弃未写回的修改。
+---@param group_id integer 组 id
+---@return integer pulled 成功读取的实体数
+function M.group_pull(group_id) end
+
+--- native_transform.group_flush(group_id) -> int
+--- 立即把有变化的实体写回节点。
+---@param group_id integer 组 id
+---@return integer written 写回的实体数
+function M.group_flush(group_id) end
+
+--- native_transform.group_set_auto_flush(group_id, enabled) -> void
+--- 设置是否在每次 update 之后自动 flush，默认开启。
+---@param group_id integer 组 id
+---@param enabled boolean
+function M.group_set_auto_flush(group_id, enabled) end
+
 return M
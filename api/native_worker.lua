@@ -0,0 +1,37 @@
+---@meta
+
+---@class native_worker
+local M = {}
+
+--- native_worker.configure(script_path, worker_count) -> boolean
+--- 设置任务脚本与 worker 数量。
+--- 任务脚本在每个 worker 的独立 lua_State 中执行，只能使用 base / table / string / math / utf8，
+--- 不能访问 native_* 模块。脚本需返回任务函数表：
+---   return { find_path = function(grid, from, to) ... return path end }
+--- 仍有未完成任务时配置失败。
+---@param script_path string 任务脚本路径（如 "res://jobs/path_jobs.lua"）
+---@param worker_count? integer worker 数量，默认 CPU 核数 - 1
+---@return boolean ok 是否配置成功
+function M.configure(script_path, worker_count) end
+
+--- native_worker.submit(job_name, callback, ...) -> integer|nil
+--- 提交任务，在工作线程执行任务函数 job_name(...)。
+--- 参数与返回值只支持 nil / boolean / number / string 与（非循环的）table。
+--- 回调在主线程 tick 中调用：成功时为 callback(true, ...)，失败时为 callback(false, error_message)。
+---@param job_name string 任务函数名
+---@param callback? fun(ok: boolean, ...: any) 完成回调，为 nil 时忽略结果
+---@param ... any 任务参数
+---@return integer|nil job_id 任务 id，失败返回 nil
+function M.submit(job_name, callback, ...) end
+
+--- native_worker.pending() -> integer
+--- 返回排队中与执行中的任务数。
+---@return integer
+function M.pending() end
+
+--- native_worker.worker_count() -> integer
+--- 返回 worker 数量，未配置时为 0。
+---@return integer
+function M.worker_count() end
+
+return M
@@ -1,5 +1,7 @@
 #include "debug_draw_types.h"
 
+#include "../host/host_trace.h"
+
 #include <godot_cpp/classes/mesh.hpp>
 #include <godot_cpp/classes/viewport.hpp>
 #include <godot_cpp/core/math.hpp>
@@ -181,6 +183,7 @@ static void _commit_bucket(DebugBucket *p_bucket) {
 
 // 构建并提交所有调试绘制命令。
 bool debug_draw_build_and_submit() {
+	LUAGD_TRACE_ZONE("debug_draw_build_and_submit");
 	DebugDrawState &state = debug_draw_get_state();
 	if (!debug_draw_ensure_scene()) {
 		return false;
@@ -6,9 +6,16 @@
 #include <godot_cpp/godot.hpp>
 #include <godot_cpp/classes/engine.hpp>
 
+#include "host_monitors.h"
+#include "host_thread_check.h"
 #include "lua_host.h"
+#include "lua_tick_node.h"
 #include "../lua/lua_runtime.h"
+#include "../lua/lua_worker_pool.h"
+#if LUAGD_MODULE_COLLISION
 #include "../modules/collision_module.h"
+#endif
+#include "../modules/node_module.h"
 
 using namespace godot;
 
@@ -19,18 +26,34 @@ void initialize_luagd_module(ModuleInitializationLevel p_level) {
 		return;
 	}
 
+	// 记录主线程，之后的主线程检查只比较 thread_local 缓存
+	luagd::host_thread_check_init();
+
 	// 初始化 Lua 运行时
 	luagd::LuaRuntime::initialize();
 
+	// 注册工作线程任务执行器类型
+	luagd::lua_worker_pool_register_types();
+
+	// 注册节点句柄的场景树信号观察者
+	luagd::node_register_types();
+
+#if LUAGD_MODULE_COLLISION
 	// 注册信号接收器类型
 	luagd::collision_register_signal_receivers();
+#endif
 
 	// 注册 LuaHost 类
 	GDREGISTER_CLASS(luagd::LuaHost);
+	// 注册原生驱动节点
+	GDREGISTER_CLASS(luagd::LuaTickNode);
 
 	// 创建并注册单例
 	lua_host_singleton = memnew(luagd::LuaHost);
 	Engine::get_singleton()->register_singleton("LuaHost", lua_host_singleton);
+
+	// 注册 Performance 自定义监视器
+	luagd::host_monitors_register();
 }
 
 void uninitialize_luagd_module(ModuleInitializationLevel p_level) {
@@ -38,6 +61,9 @@ void uninitialize_luagd_module(ModuleInitializationLevel p_level) {
 		return;
 	}
 
+	// 移除 Performance 自定义监视器
+	luagd::host_monitors_unregister();
+
 	// 注销单例
 	Engine::get_singleton()->unregister_singleton("LuaHost");
 	if (lua_host_singleton != nullptr) {
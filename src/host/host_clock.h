@@ -0,0 +1,26 @@
+#ifndef LUAGD_HOST_CLOCK_H
+#define LUAGD_HOST_CLOCK_H
+
+#include <chrono>
+#include <cstdint>
+
+namespace luagd {
+
+// 单调时钟（微秒）。
+// 用于帧内计时，不经过 Godot 单例调用，开销仅为一次 steady_clock 读取。
+inline uint64_t host_clock_usec() {
+	return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now().time_since_epoch())
+			.count();
+}
+
+// 单调时钟（纳秒）。
+inline uint64_t host_clock_nsec() {
+	return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch())
+			.count();
+}
+
+} // namespace luagd
+
+#endif // LUAGD_HOST_CLOCK_H
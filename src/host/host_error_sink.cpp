@@ -0,0 +1,89 @@
+#include "host_error_sink.h"
+
+#include <godot_cpp/templates/hash_map.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include "host_clock.h"
+
+namespace luagd {
+
+static uint64_t interval_usec = (uint64_t)HOST_ERROR_DEFAULT_INTERVAL_MSEC * 1000;
+
+// 调用点 -> records 中的链表头，同一调用点的不同函数沿 next 链查找
+static godot::HashMap<const void *, int32_t> site_heads;
+static godot::LocalVector<HostErrorRecord> records;
+
+HostErrorRecord *host_error_report(const void *p_site, const char *p_module, const char *p_func) {
+	HostErrorRecord *record = nullptr;
+	int32_t *head = site_heads.getptr(p_site);
+	for (int32_t index = head != nullptr ? *head : -1; index >= 0; index = records[index].next) {
+		// 函数名为静态字符串，通常比较指针即可；共享辅助函数的调用方字面量可能未合并，回退到内容比较
+		if (records[index].func == p_func || strcmp(records[index].func, p_func) == 0) {
+			record = &records[index];
+			break;
+		}
+	}
+
+	if (record == nullptr) {
+		HostErrorRecord new_record;
+		new_record.site = p_site;
+		new_record.module = p_module;
+		new_record.func = p_func;
+		new_record.count = 0;
+		new_record.suppressed = 0;
+		new_record.last_emit_usec = 0;
+		new_record.emitted = false;
+		new_record.next = head != nullptr ? *head : -1;
+		site_heads[p_site] = (int32_t)records.size();
+		records.push_back(new_record);
+		record = &records[records.size() - 1];
+	}
+
+	record->count += 1;
+	const uint64_t now = host_clock_usec();
+	if (record->emitted && now - record->last_emit_usec < interval_usec) {
+		record->suppressed += 1;
+		return nullptr;
+	}
+	record->last_emit_usec = now;
+	record->emitted = true;
+	return record;
+}
+
+void host_error_emit(HostErrorRecord *p_record, const godot::String &p_message) {
+	p_record->message = p_message;
+	if (p_record->suppressed > 0) {
+		godot::UtilityFunctions::printerr(p_record->module, ".", p_record->func, ": ", p_message,
+				" (", p_record->suppressed, " similar suppressed)");
+	} else {
+		godot::UtilityFunctions::printerr(p_record->module, ".", p_record->func, ": ", p_message);
+	}
+	p_record->suppressed = 0;
+}
+
+void host_error_set_interval_msec(int64_t p_msec) {
+	const int64_t msec = p_msec >= 0 ? p_msec : HOST_ERROR_DEFAULT_INTERVAL_MSEC;
+	interval_usec = (uint64_t)msec * 1000;
+}
+
+int64_t host_error_get_interval_msec() {
+	return (int64_t)(interval_usec / 1000);
+}
+
+void host_error_get_summary(godot::LocalVector<const HostErrorRecord *> &r_records) {
+	r_records.clear();
+	for (uint32_t i = 0; i < records.size(); i++) {
+		r_records.push_back(&records[i]);
+	}
+	std::sort(r_records.ptr(), r_records.ptr() + r_records.size(),
+			[](const HostErrorRecord *p_a, const HostErrorRecord *p_b) { return p_a->count > p_b->count; });
+}
+
+void host_error_reset() {
+	site_heads.clear();
+	records.clear();
+}
+
+} // namespace luagd
@@ -0,0 +1,75 @@
+#ifndef LUAGD_HOST_ERROR_SINK_H
+#define LUAGD_HOST_ERROR_SINK_H
+
+#include <cstdint>
+
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+#include "host_thread_check.h"
+
+// 模块内的参数 / 句柄错误上报，替代直接 printerr。
+// 按（调用点，函数）去重计数，同一错误每个输出间隔内最多输出一次，
+// 被抑制的次数附在下一次输出中。消息参数只在真正输出时才格式化，循环中反复失败的句柄只多一次哈希查找。
+// m_module: 模块名（如 "native_node"），需为静态字符串。
+// m_func: 函数名（如 "set_position"），需为静态字符串；共享的解析辅助函数传入调用方的 p_func_name。
+// 其余参数：消息片段，与 printerr 相同，拼接时不加分隔符。
+// 检查级别为 0 时只计数，不格式化也不输出。
+#define LUAGD_REPORT_ERROR(m_module, m_func, ...)                                                      \
+	do {                                                                                               \
+		static const char luagd_error_site = 0;                                                        \
+		::luagd::HostErrorRecord *luagd_error_record =                                                 \
+				::luagd::host_error_report(&luagd_error_site, m_module, m_func);                       \
+		if (LUAGD_CHECK_LEVEL >= 1 && luagd_error_record != nullptr) {                                 \
+			::luagd::host_error_emit(luagd_error_record, ::godot::UtilityFunctions::str(__VA_ARGS__)); \
+		}                                                                                              \
+	} while (0)
+
+namespace luagd {
+
+// 默认输出间隔：同一错误每秒最多输出一次。
+static const int64_t HOST_ERROR_DEFAULT_INTERVAL_MSEC = 1000;
+
+// 一种错误（调用点 + 函数）的统计。
+struct HostErrorRecord {
+	const void *site;
+	const char *module;
+	const char *func;
+	// 最近一次输出的消息（不含 "module.func: " 前缀）
+	godot::String message;
+	// 自上次 reset 起的累计次数
+	int64_t count;
+	// 自上次输出以来被抑制的次数
+	int64_t suppressed;
+	uint64_t last_emit_usec;
+	bool emitted;
+	// 同一调用点的下一条记录（不同 p_func），-1 表示结束
+	int32_t next;
+};
+
+// 记录一次错误。
+// 返回：本次需要输出时返回记录（调用方格式化后交给 host_error_emit），否则返回 nullptr。
+// 返回的指针在下一次 host_error_report 之前有效。
+// 约束：只允许在主线程调用。
+HostErrorRecord *host_error_report(const void *p_site, const char *p_module, const char *p_func);
+
+// 输出错误："module.func: message"，若此前有被抑制的同类错误则附上次数。
+void host_error_emit(HostErrorRecord *p_record, const godot::String &p_message);
+
+// 设置同一错误的最短输出间隔。
+// p_msec: 间隔（毫秒），0 表示每次都输出（仍计数），< 0 时使用默认值。
+void host_error_set_interval_msec(int64_t p_msec);
+
+// 返回：当前输出间隔（毫秒）。
+int64_t host_error_get_interval_msec();
+
+// 返回所有记录，按累计次数降序。指针在下一次 host_error_report 或 reset 之前有效。
+void host_error_get_summary(godot::LocalVector<const HostErrorRecord *> &r_records);
+
+// 清空所有记录。
+void host_error_reset();
+
+} // namespace luagd
+
+#endif // LUAGD_HOST_ERROR_SINK_H
@@ -0,0 +1,126 @@
+#include "host_interpolation.h"
+
+#include "../modules/node_module.h"
+
+#include <godot_cpp/classes/node3d.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/transform3d.hpp>
+
+namespace luagd {
+
+struct InterpolatedNode {
+	NodeHandle handle;
+	godot::Transform3D previous;
+	godot::Transform3D current;
+};
+
+// 登记数通常只有几十到几百个，按数组顺序遍历；增删不在热路径上，线性查找即可
+static godot::LocalVector<InterpolatedNode> interpolated_nodes;
+
+static int _find(NodeHandle p_handle) {
+	for (uint32_t i = 0; i < interpolated_nodes.size(); i++) {
+		if (interpolated_nodes[i].handle == p_handle) {
+			return (int)i;
+		}
+	}
+	return -1;
+}
+
+bool host_interpolation_add(NodeHandle p_handle) {
+	godot::Node3D *node = node_resolve(p_handle);
+	if (node == nullptr) {
+		return false;
+	}
+
+	const godot::Transform3D transform = node->get_transform();
+	const int index = _find(p_handle);
+	if (index >= 0) {
+		interpolated_nodes[index].previous = transform;
+		interpolated_nodes[index].current = transform;
+		return true;
+	}
+
+	// 登记期间保持记录有效，传入的 userdata 被回收后句柄仍可解析
+	node_retain(p_handle);
+	interpolated_nodes.push_back({p_handle, transform, transform});
+	return true;
+}
+
+bool host_interpolation_remove(NodeHandle p_handle) {
+	const int index = _find(p_handle);
+	if (index < 0) {
+		return false;
+	}
+
+	// 取消登记时把节点留在最近一次固定步的位置，而不是某个插值中间态
+	godot::Node3D *node = node_resolve(p_handle);
+	if (node != nullptr) {
+		node->set_transform(interpolated_nodes[index].current);
+	}
+	interpolated_nodes.remove_at_unordered(index);
+	node_unretain(p_handle);
+	return true;
+}
+
+bool host_interpolation_reset(NodeHandle p_handle) {
+	if (_find(p_handle) < 0) {
+		return false;
+	}
+	return host_interpolation_add(p_handle);
+}
+
+void host_interpolation_restore() {
+	for (uint32_t i = 0; i < interpolated_nodes.size(); i++) {
+		godot::Node3D *node = node_resolve(interpolated_nodes[i].handle);
+		if (node != nullptr) {
+			node->set_transform(interpolated_nodes[i].current);
+		}
+	}
+}
+
+void host_interpolation_capture() {
+	for (uint32_t i = 0; i < interpolated_nodes.size(); i++) {
+		InterpolatedNode &entry = interpolated_nodes[i];
+		godot::Node3D *node = node_resolve(entry.handle);
+		if (node == nullptr) {
+			continue;
+		}
+		entry.previous = entry.current;
+		entry.current = node->get_transform();
+	}
+}
+
+void host_interpolation_apply(double p_alpha) {
+	const real_t alpha = (real_t)p_alpha;
+	uint32_t i = 0;
+	while (i < interpolated_nodes.size()) {
+		const InterpolatedNode &entry = interpolated_nodes[i];
+		godot::Node3D *node = node_resolve(entry.handle);
+		if (node == nullptr) {
+			// 只移除已失效的句柄；暂时离开场景树的节点（如 reparent 中）保留登记，回到树内后继续插值
+			if (node_is_alive(entry.handle)) {
+				i++;
+				continue;
+			}
+			const NodeHandle handle = entry.handle;
+			interpolated_nodes.remove_at_unordered(i);
+			node_unretain(handle);
+			continue;
+		}
+		node->set_transform(entry.previous.interpolate_with(entry.current, alpha));
+		i++;
+	}
+}
+
+int host_interpolation_get_count() {
+	return (int)interpolated_nodes.size();
+}
+
+void host_interpolation_cleanup() {
+	for (uint32_t i = 0; i < interpolated_nodes.size(); i++) {
+		node_unretain(interpolated_nodes[i].handle);
+	}
+	interpolated_nodes.clear();
+}
+
+} // namespace luagd
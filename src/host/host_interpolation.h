@@ -0,0 +1,42 @@
+#ifndef LUAGD_HOST_INTERPOLATION_H
+#define LUAGD_HOST_INTERPOLATION_H
+
+#include "../modules/node_module.h"
+
+namespace luagd {
+
+// 固定步长下的 Node3D 变换插值。
+// 记录每个登记节点最近两个固定步结束时的局部变换，渲染帧按 alpha 在两者之间插值写回节点。
+// 约束：所有函数只允许在主线程调用。由 LuaHost::tick 驱动。
+
+// 登记节点（native_node 句柄）。重复登记时以当前变换重置两个快照。
+// 返回：节点无效或不是 Node3D 时返回 false。
+bool host_interpolation_add(NodeHandle p_handle);
+
+// 取消登记。
+// 返回：节点已登记时返回 true。
+bool host_interpolation_remove(NodeHandle p_handle);
+
+// 把两个快照都重置为节点当前变换（用于瞬移，避免插值拖影）。
+// 返回：节点已登记时返回 true。
+bool host_interpolation_reset(NodeHandle p_handle);
+
+// 固定步开始前调用：把节点恢复为最近一次固定步结束时的变换，逻辑代码看到的是未插值的状态。
+void host_interpolation_restore();
+
+// 每个固定步结束后调用：上一快照 = 当前快照，当前快照 = 节点变换。
+void host_interpolation_capture();
+
+// 所有固定步结束后调用：按 p_alpha（0..1）在两个快照之间插值并写回节点。
+// 句柄失效或节点已释放的登记在此移除；暂时离开场景树的节点跳过，保留登记。
+void host_interpolation_apply(double p_alpha);
+
+// 返回：已登记节点数。
+int host_interpolation_get_count();
+
+// 清空登记。在 LuaRuntime::shutdown 时调用。
+void host_interpolation_cleanup();
+
+} // namespace luagd
+
+#endif // LUAGD_HOST_INTERPOLATION_H
@@ -0,0 +1,121 @@
+#include "host_memory_stats.h"
+
+#include <godot_cpp/variant/string.hpp>
+
+#include "../lua/lua_runtime.h"
+#include "../lua/lua_signal_binding.h"
+#include "../modules/node_module.h"
+#if LUAGD_MODULE_ANIM
+#include "../modules/anim_module.h"
+#endif
+#if LUAGD_MODULE_AUDIO
+#include "../modules/audio_module.h"
+#endif
+#if LUAGD_MODULE_RES
+#include "../modules/res_module.h"
+#endif
+#if LUAGD_MODULE_DEBUG_DRAW
+#include "../modules/debug_draw_module.h"
+#endif
+#if LUAGD_MODULE_TRANSFORM
+#include "../modules/transform_module.h"
+#endif
+
+extern "C" {
+#include <lua.h>
+}
+
+namespace luagd {
+
+struct MemoryWatermark {
+	int64_t peak_entries;
+	int64_t peak_bytes;
+	int64_t snapshot_entries;
+	int64_t snapshot_bytes;
+};
+
+// 按表名索引；表名为各模块中的静态字符串
+static godot::HashMap<godot::String, MemoryWatermark> watermarks;
+
+static void _collect_tables(godot::LocalVector<HostMemoryTable> &r_tables) {
+	lua_State *L = LuaRuntime::get_state();
+	if (L != nullptr) {
+		const int64_t heap_bytes = (int64_t)lua_gc(L, LUA_GCCOUNT) * 1024 + (int64_t)lua_gc(L, LUA_GCCOUNTB);
+		r_tables.push_back({"lua.heap", 0, heap_bytes});
+	}
+
+	node_collect_memory(r_tables);
+	lua_signal_binding_collect_memory(r_tables);
+#if LUAGD_MODULE_ANIM
+	anim_collect_memory(r_tables);
+#endif
+#if LUAGD_MODULE_AUDIO
+	audio_collect_memory(r_tables);
+#endif
+#if LUAGD_MODULE_RES
+	res_collect_memory(r_tables);
+#endif
+#if LUAGD_MODULE_DEBUG_DRAW
+	debug_draw_collect_memory(r_tables);
+#endif
+#if LUAGD_MODULE_TRANSFORM
+	transform_collect_memory(r_tables);
+#endif
+}
+
+static MemoryWatermark &_update_watermark(const HostMemoryTable &p_table) {
+	const godot::String key = p_table.name;
+	MemoryWatermark *mark = watermarks.getptr(key);
+	if (mark == nullptr) {
+		mark = &watermarks.insert(key, {p_table.entries, p_table.bytes, 0, 0})->value;
+	}
+	if (p_table.entries > mark->peak_entries) {
+		mark->peak_entries = p_table.entries;
+	}
+	if (p_table.bytes > mark->peak_bytes) {
+		mark->peak_bytes = p_table.bytes;
+	}
+	return *mark;
+}
+
+void host_memory_collect(godot::LocalVector<HostMemoryReport> &r_reports, bool p_diff) {
+	godot::LocalVector<HostMemoryTable> tables;
+	_collect_tables(tables);
+
+	r_reports.clear();
+	for (uint32_t i = 0; i < tables.size(); i++) {
+		const HostMemoryTable &table = tables[i];
+		MemoryWatermark &mark = _update_watermark(table);
+
+		HostMemoryReport report;
+		report.name = table.name;
+		report.entries = table.entries;
+		report.bytes = table.bytes;
+		report.peak_entries = mark.peak_entries;
+		report.peak_bytes = mark.peak_bytes;
+		report.delta_entries = 0;
+		report.delta_bytes = 0;
+		if (p_diff) {
+			// 首次 diff 的基线为 0，结果即当前值
+			report.delta_entries = table.entries - mark.snapshot_entries;
+			report.delta_bytes = table.bytes - mark.snapshot_bytes;
+			mark.snapshot_entries = table.entries;
+			mark.snapshot_bytes = table.bytes;
+		}
+		r_reports.push_back(report);
+	}
+}
+
+void host_memory_sample() {
+	godot::LocalVector<HostMemoryTable> tables;
+	_collect_tables(tables);
+	for (uint32_t i = 0; i < tables.size(); i++) {
+		_update_watermark(tables[i]);
+	}
+}
+
+void host_memory_reset() {
+	watermarks.clear();
+}
+
+} // namespace luagd
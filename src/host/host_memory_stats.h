@@ -0,0 +1,60 @@
+#ifndef LUAGD_HOST_MEMORY_STATS_H
+#define LUAGD_HOST_MEMORY_STATS_H
+
+#include <cstdint>
+
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+
+namespace luagd {
+
+// 单张模块表的占用估算。
+// bytes 只统计容器本身与记录内直接持有的数组 / 字符串，不含记录引用的 Godot 对象与资源。
+struct HostMemoryTable {
+	const char *name;
+	int64_t entries;
+	int64_t bytes;
+};
+
+// 带高水位与增量的统计结果。
+struct HostMemoryReport {
+	const char *name;
+	int64_t entries;
+	int64_t bytes;
+	int64_t peak_entries;
+	int64_t peak_bytes;
+	// 仅 diff 模式有效：相对上一次 diff 快照的变化
+	int64_t delta_entries;
+	int64_t delta_bytes;
+};
+
+// 估算 HashMap 占用：桶数组（元素指针 + 哈希）与逐个分配的元素节点。
+template <typename K, typename V>
+inline int64_t host_memory_hash_map_bytes(const godot::HashMap<K, V> &p_map) {
+	const int64_t buckets = p_map.is_empty() ? 0 : (int64_t)p_map.get_capacity();
+	return buckets * (int64_t)(sizeof(void *) + sizeof(uint32_t)) +
+			(int64_t)p_map.size() * (int64_t)(sizeof(K) + sizeof(V) + 2 * sizeof(void *));
+}
+
+// 估算 HashSet 占用：开放寻址，按容量分配键数组与三张索引表。
+template <typename K>
+inline int64_t host_memory_hash_set_bytes(const godot::HashSet<K> &p_set) {
+	const int64_t capacity = p_set.is_empty() ? 0 : (int64_t)p_set.get_capacity();
+	return capacity * (int64_t)(sizeof(K) + 3 * sizeof(uint32_t));
+}
+
+// 采集所有模块表与 Lua 堆的当前占用，更新高水位。
+// p_diff: 为 true 时计算相对上一次 diff 快照的增量，并把本次结果记为新的快照。
+// 约束：只允许在主线程调用。
+void host_memory_collect(godot::LocalVector<HostMemoryReport> &r_reports, bool p_diff);
+
+// 只更新高水位，不产生报告。由 LuaHost::tick 每隔若干帧调用，避免两次查询之间的峰值丢失。
+void host_memory_sample();
+
+// 清除高水位与 diff 快照。
+void host_memory_reset();
+
+} // namespace luagd
+
+#endif // LUAGD_HOST_MEMORY_STATS_H
@@ -0,0 +1,186 @@
+#include "host_monitors.h"
+
+#include <godot_cpp/classes/performance.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/memory.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/callable.hpp>
+#include <godot_cpp/variant/string_name.hpp>
+
+#include "lua_host.h"
+#include "../lua/lua_binding_stats.h"
+#include "../lua/lua_gc_pacer.h"
+#include "../lua/lua_runtime.h"
+#include "../lua/lua_signal_binding.h"
+#include "../modules/node_module.h"
+#if LUAGD_MODULE_ANIM
+#include "../modules/anim_module.h"
+#endif
+#if LUAGD_MODULE_AUDIO
+#include "../modules/audio_module.h"
+#endif
+#if LUAGD_MODULE_DEBUG_DRAW
+#include "../debug_draw/debug_draw_types.h"
+#include "../modules/debug_draw_module.h"
+#endif
+
+extern "C" {
+#include <lua.h>
+}
+
+namespace luagd {
+
+enum HostMonitor {
+	HOST_MONITOR_HEAP_KB = 0,
+	HOST_MONITOR_GC_STEP_USEC,
+	HOST_MONITOR_UPDATE_USEC,
+	HOST_MONITOR_BINDING_CALLS,
+	HOST_MONITOR_NODES,
+	HOST_MONITOR_SIGNAL_BINDINGS,
+	HOST_MONITOR_ANIMATORS,
+	HOST_MONITOR_AUDIO_PLAYERS,
+	HOST_MONITOR_DEBUG_DRAW_POINT_VERTICES,
+	HOST_MONITOR_DEBUG_DRAW_LINE_VERTICES,
+	HOST_MONITOR_DEBUG_DRAW_FACE_VERTICES,
+};
+
+struct HostMonitorDesc {
+	const char *id;
+	HostMonitor metric;
+};
+
+// 监视器 id 为 "分类/名称"，在 Monitors 面板中按分类分组
+static const HostMonitorDesc monitor_descs[] = {
+	{"Lua/Heap (KB)", HOST_MONITOR_HEAP_KB},
+	{"Lua/GC Step (usec)", HOST_MONITOR_GC_STEP_USEC},
+	{"Lua/Update (usec)", HOST_MONITOR_UPDATE_USEC},
+	{"Lua/Binding Calls", HOST_MONITOR_BINDING_CALLS},
+	{"Lua Records/Nodes", HOST_MONITOR_NODES},
+	{"Lua Records/Signal Bindings", HOST_MONITOR_SIGNAL_BINDINGS},
+#if LUAGD_MODULE_ANIM
+	{"Lua Records/Animators", HOST_MONITOR_ANIMATORS},
+#endif
+#if LUAGD_MODULE_AUDIO
+	{"Lua Records/Audio Players", HOST_MONITOR_AUDIO_PLAYERS},
+#endif
+#if LUAGD_MODULE_DEBUG_DRAW
+	{"Lua Debug Draw/Point Vertices", HOST_MONITOR_DEBUG_DRAW_POINT_VERTICES},
+	{"Lua Debug Draw/Line Vertices", HOST_MONITOR_DEBUG_DRAW_LINE_VERTICES},
+	{"Lua Debug Draw/Face Vertices", HOST_MONITOR_DEBUG_DRAW_FACE_VERTICES},
+#endif
+	{nullptr, HOST_MONITOR_HEAP_KB}
+};
+
+// LuaMonitorSource：Performance 自定义监视器的回调目标，sample 在主线程由 Performance 调用。
+class LuaMonitorSource : public godot::Object {
+	GDCLASS(LuaMonitorSource, godot::Object);
+
+protected:
+	static void _bind_methods();
+
+public:
+	double sample(int p_metric);
+};
+
+static LuaMonitorSource *monitor_source = nullptr;
+
+void LuaMonitorSource::_bind_methods() {
+	godot::ClassDB::bind_method(godot::D_METHOD("sample", "metric"), &LuaMonitorSource::sample);
+}
+
+double LuaMonitorSource::sample(int p_metric) {
+	switch ((HostMonitor)p_metric) {
+		case HOST_MONITOR_HEAP_KB: {
+			lua_State *L = LuaRuntime::get_state();
+			if (L == nullptr) {
+				return 0.0;
+			}
+			return (double)lua_gc(L, LUA_GCCOUNT) + (double)lua_gc(L, LUA_GCCOUNTB) / 1024.0;
+		}
+		case HOST_MONITOR_GC_STEP_USEC:
+			return (double)lua_gc_pacer_get_frame_stats().step_usec;
+		case HOST_MONITOR_UPDATE_USEC: {
+			const LuaHost *host = LuaHost::get_singleton();
+			return host != nullptr ? (double)host->get_frame_update_usec() : 0.0;
+		}
+		case HOST_MONITOR_BINDING_CALLS: {
+			// 未启用 LUAGD_BINDING_STATS 时记录为空，恒为 0
+			const godot::LocalVector<LuaBindingRecord *> &records = lua_binding_stats_get_records();
+			int64_t calls = 0;
+			for (uint32_t i = 0; i < records.size(); i++) {
+				calls += records[i]->frame_calls;
+			}
+			return (double)calls;
+		}
+		case HOST_MONITOR_NODES:
+			return (double)node_get_count();
+		case HOST_MONITOR_SIGNAL_BINDINGS:
+			return (double)lua_signal_binding_get_count();
+#if LUAGD_MODULE_ANIM
+		case HOST_MONITOR_ANIMATORS:
+			return (double)anim_get_animator_count();
+#endif
+#if LUAGD_MODULE_AUDIO
+		case HOST_MONITOR_AUDIO_PLAYERS:
+			return (double)audio_get_player_count();
+#endif
+#if LUAGD_MODULE_DEBUG_DRAW
+		case HOST_MONITOR_DEBUG_DRAW_POINT_VERTICES:
+		case HOST_MONITOR_DEBUG_DRAW_LINE_VERTICES:
+		case HOST_MONITOR_DEBUG_DRAW_FACE_VERTICES: {
+			const DebugFrameStats *stats = debug_draw_get_frame_stats();
+			if (stats == nullptr) {
+				return 0.0;
+			}
+			if (p_metric == HOST_MONITOR_DEBUG_DRAW_POINT_VERTICES) {
+				return (double)stats->points_vertex_count;
+			}
+			if (p_metric == HOST_MONITOR_DEBUG_DRAW_LINE_VERTICES) {
+				return (double)stats->lines_vertex_count;
+			}
+			return (double)stats->faces_vertex_count;
+		}
+#endif
+		default:
+			return 0.0;
+	}
+}
+
+void host_monitors_register() {
+	godot::Performance *performance = godot::Performance::get_singleton();
+	if (performance == nullptr) {
+		return;
+	}
+
+	GDREGISTER_CLASS(LuaMonitorSource);
+	if (monitor_source == nullptr) {
+		monitor_source = godot::memnew(LuaMonitorSource);
+	}
+
+	for (const HostMonitorDesc *desc = monitor_descs; desc->id != nullptr; desc++) {
+		const godot::StringName id(desc->id);
+		if (performance->has_custom_monitor(id)) {
+			continue;
+		}
+		performance->add_custom_monitor(id, godot::Callable(monitor_source, "sample").bind((int)desc->metric));
+	}
+}
+
+void host_monitors_unregister() {
+	godot::Performance *performance = godot::Performance::get_singleton();
+	if (performance != nullptr) {
+		for (const HostMonitorDesc *desc = monitor_descs; desc->id != nullptr; desc++) {
+			const godot::StringName id(desc->id);
+			if (performance->has_custom_monitor(id)) {
+				performance->remove_custom_monitor(id);
+			}
+		}
+	}
+
+	if (monitor_source != nullptr) {
+		godot::memdelete(monitor_source);
+		monitor_source = nullptr;
+	}
+}
+
+} // namespace luagd
@@ -0,0 +1,16 @@
+#ifndef LUAGD_HOST_MONITORS_H
+#define LUAGD_HOST_MONITORS_H
+
+namespace luagd {
+
+// 向 Performance 注册 Lua 运行时的自定义监视器（调试器 Monitors 面板与 Performance.get_monitor 可见）：
+// Lua 堆大小、GC 步进耗时、update 耗时、每帧原生绑定调用数、各模块记录数与调试绘制顶点数。
+// 约束：只允许在主线程调用。在 LuaHost 单例创建后调用。
+void host_monitors_register();
+
+// 移除已注册的监视器。在 LuaRuntime::shutdown 之前调用。
+void host_monitors_unregister();
+
+} // namespace luagd
+
+#endif // LUAGD_HOST_MONITORS_H
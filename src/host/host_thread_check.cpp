@@ -1,15 +1,34 @@
 #include "host_thread_check.h"
 
 #include <godot_cpp/classes/os.hpp>
-#include <godot_cpp/variant/utility_functions.hpp>
+
+#include <thread>
 
 namespace luagd {
 
+static std::thread::id main_thread_id;
+static bool main_thread_captured = false;
+
+void host_thread_check_init() {
+	main_thread_id = std::this_thread::get_id();
+	main_thread_captured = true;
+}
+
 bool is_main_thread() {
-	return godot::OS::get_singleton()->get_thread_caller_id() == godot::OS::get_singleton()->get_main_thread_id();
+	if (!main_thread_captured) {
+		// 初始化之前不缓存，回退到 OS 查询
+		return godot::OS::get_singleton()->get_thread_caller_id() == godot::OS::get_singleton()->get_main_thread_id();
+	}
+
+	// -1 = 尚未比较，0 = 否，1 = 是
+	thread_local int8_t t_is_main = -1;
+	if (t_is_main < 0) {
+		t_is_main = std::this_thread::get_id() == main_thread_id ? 1 : 0;
+	}
+	return t_is_main == 1;
 }
 
-bool ensure_main_thread(const godot::String &p_context) {
+bool ensure_main_thread(const char *p_context) {
 	if (!is_main_thread()) {
 		godot::String err_msg = p_context;
 		err_msg += ": must be called from main thread";
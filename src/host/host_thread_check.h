@@ -1,18 +1,38 @@
 #ifndef LUAGD_HOST_THREAD_CHECK_H
 #define LUAGD_HOST_THREAD_CHECK_H
 
-#include <godot_cpp/variant/string.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+// 运行时检查级别，由构建系统设置（LUAGD_CHECK_LEVEL）：
+// 2 = 主线程检查 + 参数错误消息（debug 构建默认）
+// 1 = 只保留参数错误消息
+// 0 = 全部移除，LUAGD_REPORT_ERROR 只计数（template_release 构建默认）
+// Lua 回调错误、脚本加载错误等运行时错误不受影响，始终输出。
+#ifndef LUAGD_CHECK_LEVEL
+#define LUAGD_CHECK_LEVEL 2
+#endif
+
+// 模块内的主线程断言。检查级别 < 2 时恒为 true，不产生任何调用。
+#if LUAGD_CHECK_LEVEL >= 2
+#define LUAGD_ENSURE_MAIN_THREAD(m_context) (::luagd::ensure_main_thread(m_context))
+#else
+#define LUAGD_ENSURE_MAIN_THREAD(m_context) true
+#endif
 
 namespace luagd {
 
+// 记录主线程。在扩展初始化时（主线程上）调用一次。
+void host_thread_check_init();
+
 // 检查当前是否在主线程执行。
+// 每个线程首次调用时与记录的主线程 id 比较一次，结果缓存在 thread_local 中。
 // 返回：在主线程返回 true，否则返回 false。
 bool is_main_thread();
 
 // 断言当前在主线程执行。
 // 如果不在主线程，打印错误消息并返回 false。
 // p_context: 用于错误消息的函数/模块名称（如 "LuaHost.run_file"）
-bool ensure_main_thread(const godot::String &p_context);
+bool ensure_main_thread(const char *p_context);
 
 } // namespace luagd
 
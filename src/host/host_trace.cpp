@@ -0,0 +1,239 @@
+#include "host_trace.h"
+
+#include "host_clock.h"
+
+#include <godot_cpp/core/memory.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+
+#include <atomic>
+#include <cstring>
+
+namespace luagd {
+
+struct TraceEvent {
+	const char *name;
+	uint64_t start_usec;
+	uint32_t duration_usec;
+	uint32_t thread_id;
+};
+
+// 事件数组与容量放在一起发布：写入方一次读取得到一致的指针和掩码
+struct TraceBuffer {
+	TraceEvent *events;
+	uint32_t capacity;
+};
+
+static std::atomic<TraceBuffer *> trace_buffer(nullptr);
+// 改变容量时被替换下来的缓冲。其他线程可能刚读到旧指针、仍在写入，
+// 追踪运行期间无法确定何时写完，因此保留到 host_trace_cleanup（worker 已全部结束）再释放
+static godot::LocalVector<TraceBuffer *> retired_buffers;
+static std::atomic<bool> trace_running(false);
+// 单调递增的写入序号，slot = 序号 & (capacity - 1)
+static std::atomic<uint64_t> trace_write_index(0);
+static uint64_t trace_origin_usec = 0;
+
+static std::atomic<uint32_t> next_thread_id(1);
+
+static godot::HashMap<godot::String, char *> interned_names;
+
+struct TraceOpenZone {
+	const char *name;
+	uint64_t start_usec;
+	uint32_t token;
+};
+
+// 手动区间栈，只在主线程访问；每个 tick 开始时清空
+static godot::LocalVector<TraceOpenZone> open_zones;
+static uint32_t next_zone_token = 1;
+
+static uint32_t _current_thread_id() {
+	// 首次写入事件时分配，主线程通常最先写入而得到 1
+	thread_local uint32_t t_thread_id = 0;
+	if (t_thread_id == 0) {
+		t_thread_id = next_thread_id.fetch_add(1, std::memory_order_relaxed);
+	}
+	return t_thread_id;
+}
+
+static uint32_t _round_up_pow2(uint32_t p_value) {
+	uint32_t result = 1;
+	while (result < p_value && result < (1u << 31)) {
+		result <<= 1;
+	}
+	return result;
+}
+
+void host_trace_start(uint32_t p_capacity) {
+	trace_running.store(false, std::memory_order_release);
+
+	const uint32_t capacity = _round_up_pow2(p_capacity > 0 ? p_capacity : HOST_TRACE_DEFAULT_CAPACITY);
+	TraceBuffer *buffer = trace_buffer.load(std::memory_order_relaxed);
+	if (buffer == nullptr || buffer->capacity != capacity) {
+		if (buffer != nullptr) {
+			retired_buffers.push_back(buffer);
+		}
+		buffer = godot::memnew(TraceBuffer);
+		buffer->events = (TraceEvent *)godot::memalloc(sizeof(TraceEvent) * capacity);
+		buffer->capacity = capacity;
+	}
+	// 复用同一缓冲时，刚通过运行检查的写入可能与清零交错，最多留下一条起点早于本次追踪的事件，导出时被过滤
+	memset(buffer->events, 0, sizeof(TraceEvent) * capacity);
+	trace_buffer.store(buffer, std::memory_order_release);
+
+	trace_write_index.store(0, std::memory_order_relaxed);
+	trace_origin_usec = host_clock_usec();
+	trace_running.store(true, std::memory_order_release);
+}
+
+void host_trace_stop() {
+	trace_running.store(false, std::memory_order_release);
+}
+
+bool host_trace_is_running() {
+	return trace_running.load(std::memory_order_relaxed);
+}
+
+uint64_t host_trace_now() {
+	return host_clock_usec();
+}
+
+void host_trace_record(const char *p_name, uint64_t p_start_usec, uint64_t p_end_usec) {
+	if (!trace_running.load(std::memory_order_acquire)) {
+		return;
+	}
+
+	const TraceBuffer *buffer = trace_buffer.load(std::memory_order_acquire);
+	const uint64_t index = trace_write_index.fetch_add(1, std::memory_order_relaxed);
+	TraceEvent &event = buffer->events[index & (buffer->capacity - 1)];
+	event.name = p_name;
+	event.start_usec = p_start_usec;
+	event.duration_usec = p_end_usec > p_start_usec ? (uint32_t)(p_end_usec - p_start_usec) : 0;
+	event.thread_id = _current_thread_id();
+}
+
+const char *host_trace_intern(const char *p_name) {
+	const godot::String key = godot::String::utf8(p_name);
+	char **existing = interned_names.getptr(key);
+	if (existing != nullptr) {
+		return *existing;
+	}
+
+	const size_t length = strlen(p_name);
+	char *copy = (char *)godot::memalloc(length + 1);
+	memcpy(copy, p_name, length + 1);
+	interned_names.insert(key, copy);
+	return copy;
+}
+
+uint32_t host_trace_zone_begin(const char *p_name) {
+	if (!trace_running.load(std::memory_order_relaxed)) {
+		return 0;
+	}
+
+	const uint32_t token = next_zone_token;
+	next_zone_token = next_zone_token == UINT32_MAX ? 1 : next_zone_token + 1;
+	open_zones.push_back({host_trace_intern(p_name), host_clock_usec(), token});
+	return token;
+}
+
+bool host_trace_zone_end(uint32_t p_token) {
+	int64_t index = (int64_t)open_zones.size() - 1;
+	if (p_token != 0) {
+		while (index >= 0 && open_zones[index].token != p_token) {
+			index--;
+		}
+	}
+	if (index < 0) {
+		return false;
+	}
+
+	const TraceOpenZone zone = open_zones[index];
+	open_zones.resize((uint32_t)index);
+	host_trace_record(zone.name, zone.start_usec, host_clock_usec());
+	return true;
+}
+
+void host_trace_end_frame() {
+	open_zones.clear();
+}
+
+static void _append_json_string(godot::String &r_out, const char *p_text) {
+	godot::LocalVector<char> escaped;
+	escaped.push_back('"');
+	for (const char *c = p_text; *c != '\0'; c++) {
+		if (*c == '"' || *c == '\\') {
+			escaped.push_back('\\');
+			escaped.push_back(*c);
+		} else if ((unsigned char)*c < 0x20) {
+			escaped.push_back(' ');
+		} else {
+			escaped.push_back(*c);
+		}
+	}
+	escaped.push_back('"');
+	r_out += godot::String::utf8(escaped.ptr(), (int)escaped.size());
+}
+
+godot::String host_trace_dump_json() {
+	godot::String out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	const TraceBuffer *buffer = trace_buffer.load(std::memory_order_acquire);
+	const uint64_t written = trace_write_index.load(std::memory_order_acquire);
+	if (buffer != nullptr && written > 0) {
+		// 已覆盖时从最旧的事件开始导出
+		const uint64_t first = written > buffer->capacity ? written - buffer->capacity : 0;
+		bool first_event = true;
+		for (uint64_t i = first; i < written; i++) {
+			const TraceEvent &event = buffer->events[i & (buffer->capacity - 1)];
+			if (event.name == nullptr || event.start_usec < trace_origin_usec) {
+				continue;
+			}
+			if (!first_event) {
+				out += ",";
+			}
+			first_event = false;
+			out += "{\"name\":";
+			_append_json_string(out, event.name);
+			out += ",\"ph\":\"X\",\"pid\":1,\"tid\":";
+			out += godot::String::num_int64(event.thread_id);
+			out += ",\"ts\":";
+			out += godot::String::num_int64((int64_t)(event.start_usec - trace_origin_usec));
+			out += ",\"dur\":";
+			out += godot::String::num_int64(event.duration_usec);
+			out += "}";
+		}
+	}
+	out += "]}";
+	return out;
+}
+
+uint32_t host_trace_get_event_count() {
+	const TraceBuffer *buffer = trace_buffer.load(std::memory_order_acquire);
+	if (buffer == nullptr) {
+		return 0;
+	}
+	const uint64_t written = trace_write_index.load(std::memory_order_acquire);
+	return written > buffer->capacity ? buffer->capacity : (uint32_t)written;
+}
+
+void host_trace_cleanup() {
+	trace_running.store(false, std::memory_order_release);
+	TraceBuffer *buffer = trace_buffer.exchange(nullptr, std::memory_order_acq_rel);
+	if (buffer != nullptr) {
+		retired_buffers.push_back(buffer);
+	}
+	for (uint32_t i = 0; i < retired_buffers.size(); i++) {
+		godot::memfree(retired_buffers[i]->events);
+		godot::memdelete(retired_buffers[i]);
+	}
+	retired_buffers.clear();
+	trace_write_index.store(0, std::memory_order_relaxed);
+
+	for (const godot::KeyValue<godot::String, char *> &entry : interned_names) {
+		godot::memfree(entry.value);
+	}
+	interned_names.clear();
+	open_zones.clear();
+}
+
+} // namespace luagd
@@ -0,0 +1,97 @@
+#ifndef LUAGD_HOST_TRACE_H
+#define LUAGD_HOST_TRACE_H
+
+#include <cstdint>
+
+#include <godot_cpp/variant/string.hpp>
+
+namespace luagd {
+
+// 帧时间线追踪：区间（zone）结束时写入一条完整事件到固定容量的环形缓冲，写入只做一次原子自增，
+// 不加锁；缓冲写满后覆盖最旧的事件，始终保留最近一段时间线。
+// 未开始追踪时 zone 只有一次 relaxed 原子读取。
+// 导出格式为 Chrome trace event JSON（"X" 事件），可直接在 chrome://tracing 或 Perfetto UI 中打开。
+
+// 默认环形缓冲容量（事件数）。
+static const uint32_t HOST_TRACE_DEFAULT_CAPACITY = 65536;
+
+// 开始追踪并清空已有事件。
+// p_capacity: 环形缓冲容量，向上取整到 2 的幂。容量变化时换用新缓冲，
+// 旧缓冲可能仍有其他线程在写入，保留到 host_trace_cleanup 才释放。
+// 约束：只允许在主线程调用。
+void host_trace_start(uint32_t p_capacity = HOST_TRACE_DEFAULT_CAPACITY);
+
+// 停止追踪，已有事件保留。
+void host_trace_stop();
+
+// 返回：是否正在追踪。
+bool host_trace_is_running();
+
+// 返回：当前单调时钟（微秒），用于 zone 起点。
+uint64_t host_trace_now();
+
+// 写入一条完整事件。p_name 必须在导出前保持有效（静态字符串或 host_trace_intern 的返回值）。
+// 可在任意线程调用。
+void host_trace_record(const char *p_name, uint64_t p_start_usec, uint64_t p_end_usec);
+
+// 驻留动态名称（如 Lua 传入的 zone 名），返回的指针在 host_trace_cleanup 前保持有效。
+// 约束：只允许在主线程调用。
+const char *host_trace_intern(const char *p_name);
+
+// 开始一个需要手动结束的区间（供 native_debug.zone_begin 使用），名称会被驻留。
+// 未在追踪时直接返回 0，不驻留名称也不入栈。
+// 返回：区间令牌（非 0），传给 host_trace_zone_end 结束该区间。
+// 约束：只允许在主线程调用。
+uint32_t host_trace_zone_begin(const char *p_name);
+
+// 结束 p_token 对应的区间；p_token 为 0 时结束最近一个区间。
+// 栈中位于该区间之上、未正常结束的区间（如 Lua 错误跳过了 zone_end）一并丢弃。
+// 返回：找不到对应区间时返回 false。
+// 约束：只允许在主线程调用。
+bool host_trace_zone_end(uint32_t p_token);
+
+// 帧边界：丢弃所有未结束的手动区间，手动区间不能跨越 tick。由 LuaHost::tick 调用。
+// 约束：只允许在主线程调用。
+void host_trace_end_frame();
+
+// 导出为 Chrome trace event JSON。
+// 约束：只允许在主线程调用；导出期间其他线程写入的事件可能不完整。
+godot::String host_trace_dump_json();
+
+// 返回：缓冲中的事件数。
+uint32_t host_trace_get_event_count();
+
+// 释放缓冲（含替换下来的旧缓冲）与驻留名称。在 LuaRuntime::shutdown 时调用，
+// 调用时不能再有其他线程写入事件（worker 池已先行清理）。
+void host_trace_cleanup();
+
+// RAII 区间：构造时记录起点，析构时写入事件。
+class HostTraceZone {
+public:
+	explicit HostTraceZone(const char *p_name) :
+			name(host_trace_is_running() ? p_name : nullptr),
+			start_usec(name != nullptr ? host_trace_now() : 0) {}
+
+	~HostTraceZone() {
+		if (name != nullptr) {
+			host_trace_record(name, start_usec, host_trace_now());
+		}
+	}
+
+	HostTraceZone(const HostTraceZone &) = delete;
+	HostTraceZone &operator=(const HostTraceZone &) = delete;
+
+private:
+	const char *name;
+	uint64_t start_usec;
+};
+
+#define LUAGD_TRACE_CONCAT_IMPL(m_a, m_b) m_a##m_b
+#define LUAGD_TRACE_CONCAT(m_a, m_b) LUAGD_TRACE_CONCAT_IMPL(m_a, m_b)
+
+// 在当前作用域内记录一个区间，p_name 需为静态字符串。
+#define LUAGD_TRACE_ZONE(m_name) ::luagd::HostTraceZone LUAGD_TRACE_CONCAT(_luagd_trace_zone_, __LINE__)(m_name)
+
+} // namespace luagd
+
+#endif // LUAGD_HOST_TRACE_H
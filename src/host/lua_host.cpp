@@ -2,15 +2,42 @@
 
 #include <godot_cpp/core/class_db.hpp>
 
+#include "host_clock.h"
+#include "host_error_sink.h"
+#include "host_interpolation.h"
+#include "host_memory_stats.h"
 #include "host_thread_check.h"
+#include "host_trace.h"
+#include "../lua/lua_alloc_profiler.h"
+#include "../lua/lua_allocator.h"
+#include "../lua/lua_binding_stats.h"
+#include "../lua/lua_chunk_cache.h"
+#include "../lua/lua_gc_pacer.h"
+#include "../lua/lua_module_searcher.h"
+#include "../lua/lua_profiler.h"
 #include "../lua/lua_runtime.h"
+#include "../lua/lua_worker_pool.h"
 #include "../modules/core_module.h"
 #include "../modules/input_module.h"
+#if LUAGD_MODULE_TIMER
+#include "../modules/timer_module.h"
+#endif
+#if LUAGD_MODULE_TRANSFORM
+#include "../modules/transform_module.h"
+#endif
 
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/file_access.hpp>
 #include <godot_cpp/classes/input_event.hpp>
+#include <godot_cpp/core/math.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
 
 namespace luagd {
 
+// 模块表高水位采样间隔（tick 数）
+static const uint32_t MEMORY_SAMPLE_INTERVAL_TICKS = 30;
+
 LuaHost *LuaHost::singleton = nullptr;
 
 LuaHost::LuaHost() {
@@ -29,8 +56,40 @@ void LuaHost::_bind_methods() {
 	godot::ClassDB::bind_method(godot::D_METHOD("run_file", "path"), &LuaHost::run_file);
 	godot::ClassDB::bind_method(godot::D_METHOD("run_string", "code"), &LuaHost::run_string);
 	godot::ClassDB::bind_method(godot::D_METHOD("tick", "delta"), &LuaHost::tick);
+	godot::ClassDB::bind_method(godot::D_METHOD("process", "delta"), &LuaHost::process);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_fixed_timestep", "step", "max_steps"), &LuaHost::set_fixed_timestep, DEFVAL(5));
+	godot::ClassDB::bind_method(godot::D_METHOD("get_fixed_timestep"), &LuaHost::get_fixed_timestep);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_interpolation_alpha"), &LuaHost::get_interpolation_alpha);
 	godot::ClassDB::bind_method(godot::D_METHOD("shutdown"), &LuaHost::shutdown);
 	godot::ClassDB::bind_method(godot::D_METHOD("input", "event"), &LuaHost::input);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_bytecode_cache", "enabled", "cache_dir"), &LuaHost::set_bytecode_cache, DEFVAL(""));
+	godot::ClassDB::bind_method(godot::D_METHOD("get_bytecode_cache_stats"), &LuaHost::get_bytecode_cache_stats);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_module_roots", "roots"), &LuaHost::set_module_roots);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_module_roots"), &LuaHost::get_module_roots);
+	godot::ClassDB::bind_method(godot::D_METHOD("rebuild_module_index"), &LuaHost::rebuild_module_index);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_allocator_stats"), &LuaHost::get_allocator_stats);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_gc_budget_usec", "budget_usec"), &LuaHost::set_gc_budget_usec);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_gc_budget_usec"), &LuaHost::get_gc_budget_usec);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_gc_mode", "mode"), &LuaHost::set_gc_mode);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_gc_stats"), &LuaHost::get_gc_stats);
+	godot::ClassDB::bind_method(godot::D_METHOD("profiler_start", "interval"), &LuaHost::profiler_start, DEFVAL(LUA_PROFILER_DEFAULT_INTERVAL));
+	godot::ClassDB::bind_method(godot::D_METHOD("profiler_stop"), &LuaHost::profiler_stop);
+	godot::ClassDB::bind_method(godot::D_METHOD("profiler_dump", "path"), &LuaHost::profiler_dump, DEFVAL(""));
+	godot::ClassDB::bind_method(godot::D_METHOD("profiler_reset"), &LuaHost::profiler_reset);
+	godot::ClassDB::bind_method(godot::D_METHOD("alloc_track_start", "interval"), &LuaHost::alloc_track_start, DEFVAL(LUA_ALLOC_PROFILER_DEFAULT_INTERVAL));
+	godot::ClassDB::bind_method(godot::D_METHOD("alloc_track_stop"), &LuaHost::alloc_track_stop);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_alloc_report", "top_n", "frame"), &LuaHost::get_alloc_report, DEFVAL(20), DEFVAL(false));
+	godot::ClassDB::bind_method(godot::D_METHOD("alloc_track_reset"), &LuaHost::alloc_track_reset);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_memory_stats", "diff"), &LuaHost::get_memory_stats, DEFVAL(false));
+	godot::ClassDB::bind_method(godot::D_METHOD("reset_memory_stats"), &LuaHost::reset_memory_stats);
+	godot::ClassDB::bind_method(godot::D_METHOD("trace_start", "capacity"), &LuaHost::trace_start, DEFVAL((int)HOST_TRACE_DEFAULT_CAPACITY));
+	godot::ClassDB::bind_method(godot::D_METHOD("trace_stop"), &LuaHost::trace_stop);
+	godot::ClassDB::bind_method(godot::D_METHOD("trace_dump", "path"), &LuaHost::trace_dump, DEFVAL(""));
+	godot::ClassDB::bind_method(godot::D_METHOD("get_binding_stats"), &LuaHost::get_binding_stats);
+	godot::ClassDB::bind_method(godot::D_METHOD("reset_binding_stats"), &LuaHost::reset_binding_stats);
+	godot::ClassDB::bind_method(godot::D_METHOD("get_error_summary"), &LuaHost::get_error_summary);
+	godot::ClassDB::bind_method(godot::D_METHOD("reset_error_summary"), &LuaHost::reset_error_summary);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_error_interval_msec", "msec"), &LuaHost::set_error_interval_msec);
 }
 
 int LuaHost::run_file(const godot::String &p_path) {
@@ -47,6 +106,23 @@ int LuaHost::run_string(const godot::String &p_code) {
 	return LuaRuntime::run_string(p_code);
 }
 
+int LuaHost::_run_step(lua_State *p_L, double p_delta) {
+	const uint64_t update_start_usec = host_clock_usec();
+	const int result = core_call_update(p_L, p_delta);
+	frame_update_usec += host_clock_usec() - update_start_usec;
+	// 恢复到期的调度协程
+	core_scheduler_tick(p_L, p_delta);
+#if LUAGD_MODULE_TIMER
+	// 派发本帧到期的定时器
+	timer_tick(p_L, p_delta);
+#endif
+#if LUAGD_MODULE_TRANSFORM
+	// 本步对变换组的修改一次性写回节点，插值采样看到的是写回后的状态
+	transform_flush_groups();
+#endif
+	return result;
+}
+
 int LuaHost::tick(double p_delta) {
 	if (!ensure_main_thread("LuaHost.tick")) {
 		return -1;
@@ -55,7 +131,106 @@ int LuaHost::tick(double p_delta) {
 	if (L == nullptr) {
 		return -1;
 	}
-	return core_call_update(L, p_delta);
+	return tick_state(L, p_delta);
+}
+
+int LuaHost::tick_state(lua_State *p_L, double p_delta) {
+	LUAGD_TRACE_ZONE("LuaHost.tick");
+	// 以 tick 为帧边界，上一帧包含两次 tick 之间的所有绑定调用
+	lua_binding_stats_end_frame();
+	lua_alloc_profiler_end_frame();
+	host_trace_end_frame();
+	frame_update_usec = 0;
+	// 先派发已完成的工作线程任务回调，update 中即可看到结果
+	lua_worker_pool_drain(p_L);
+
+	int result = 0;
+	if (fixed_timestep <= 0.0) {
+		result = _run_step(p_L, p_delta);
+	} else {
+		fixed_accumulator += p_delta;
+		int steps = 0;
+		while (fixed_accumulator >= fixed_timestep && steps < max_fixed_steps) {
+			if (steps == 0) {
+				// 上一帧写回的是插值结果，固定步逻辑应从最近一次固定步的状态继续
+				host_interpolation_restore();
+			}
+			const int step_result = _run_step(p_L, fixed_timestep);
+			if (result == 0) {
+				result = step_result;
+			}
+			host_interpolation_capture();
+			fixed_accumulator -= fixed_timestep;
+			steps++;
+		}
+		if (fixed_accumulator >= fixed_timestep) {
+			// 追帧达到上限时丢弃积压时间，避免后续帧持续追赶（spiral of death）
+			fixed_accumulator = godot::Math::fmod(fixed_accumulator, fixed_timestep);
+		}
+		interpolation_alpha = fixed_accumulator / fixed_timestep;
+		core_set_frame_timing(fixed_timestep, interpolation_alpha);
+		host_interpolation_apply(interpolation_alpha);
+		last_tick_usec = host_clock_usec();
+	}
+
+	// update 结束后在剩余帧时间内推进 GC，避免回收停顿落在脚本逻辑中间
+	lua_gc_pacer_step(p_L);
+
+	// 定期采样模块表占用，记录两次查询之间的高水位
+	if (memory_sample_countdown == 0) {
+		memory_sample_countdown = MEMORY_SAMPLE_INTERVAL_TICKS;
+		host_memory_sample();
+	}
+	memory_sample_countdown -= 1;
+	return result;
+}
+
+void LuaHost::set_fixed_timestep(double p_step, int p_max_steps) {
+	if (!ensure_main_thread("LuaHost.set_fixed_timestep")) {
+		return;
+	}
+	fixed_timestep = p_step > 0.0 ? p_step : 0.0;
+	max_fixed_steps = p_max_steps > 0 ? p_max_steps : 1;
+	fixed_accumulator = 0.0;
+	interpolation_alpha = 1.0;
+	last_tick_usec = host_clock_usec();
+	core_set_frame_timing(fixed_timestep, 1.0);
+}
+
+uint64_t LuaHost::get_frame_update_usec() const {
+	return frame_update_usec;
+}
+
+double LuaHost::get_fixed_timestep() const {
+	return fixed_timestep;
+}
+
+double LuaHost::get_interpolation_alpha() const {
+	return fixed_timestep > 0.0 ? interpolation_alpha : 1.0;
+}
+
+int LuaHost::process(double p_delta) {
+	if (!ensure_main_thread("LuaHost.process")) {
+		return -1;
+	}
+	lua_State *L = LuaRuntime::get_state();
+	if (L == nullptr) {
+		return -1;
+	}
+	return process_state(L, p_delta);
+}
+
+int LuaHost::process_state(lua_State *p_L, double p_delta) {
+	if (fixed_timestep > 0.0) {
+		// tick 通常由物理帧驱动，两次 tick 之间的渲染帧按墙钟时间（乘以时间缩放）推进插值比例。
+		// 不做外推：超过一个步长时停在最近一次固定步的状态，等待下一次 tick。
+		const double since_tick = (double)(host_clock_usec() - last_tick_usec) / 1000000.0 * godot::Engine::get_singleton()->get_time_scale();
+		const double alpha = (fixed_accumulator + since_tick) / fixed_timestep;
+		interpolation_alpha = alpha < 0.0 ? 0.0 : (alpha > 1.0 ? 1.0 : alpha);
+		core_set_frame_timing(fixed_timestep, interpolation_alpha);
+		host_interpolation_apply(interpolation_alpha);
+	}
+	return core_call_process(p_L, p_delta);
 }
 
 void LuaHost::shutdown() {
@@ -80,4 +255,300 @@ void LuaHost::input(const godot::Ref<godot::InputEvent> &p_event) {
 	input_dispatch_event(L, p_event.ptr());
 }
 
+void LuaHost::set_bytecode_cache(bool p_enabled, const godot::String &p_cache_dir) {
+	if (!ensure_main_thread("LuaHost.set_bytecode_cache")) {
+		return;
+	}
+	LuaRuntime::set_bytecode_cache(p_enabled, p_cache_dir);
+}
+
+godot::Dictionary LuaHost::get_bytecode_cache_stats() const {
+	const LuaChunkCacheStats stats = lua_chunk_cache_get_stats();
+	godot::Dictionary result;
+	result["hits"] = stats.hits;
+	result["misses"] = stats.misses;
+	result["stale"] = stats.stale;
+	result["writes"] = stats.writes;
+	return result;
+}
+
+void LuaHost::set_module_roots(const godot::PackedStringArray &p_roots) {
+	if (!ensure_main_thread("LuaHost.set_module_roots")) {
+		return;
+	}
+	lua_module_searcher_set_roots(p_roots);
+}
+
+godot::PackedStringArray LuaHost::get_module_roots() const {
+	return lua_module_searcher_get_roots();
+}
+
+void LuaHost::rebuild_module_index() {
+	if (!ensure_main_thread("LuaHost.rebuild_module_index")) {
+		return;
+	}
+	lua_module_searcher_rebuild_index();
+}
+
+godot::Dictionary LuaHost::get_allocator_stats() const {
+	godot::Dictionary result;
+	const LuaPoolAllocator *allocator = LuaRuntime::get_allocator();
+	result["enabled"] = allocator != nullptr;
+	if (allocator == nullptr) {
+		return result;
+	}
+
+	const LuaAllocatorStats &stats = allocator->get_stats();
+	godot::Array classes;
+	for (int i = 0; i < LUA_ALLOCATOR_CLASS_COUNT; i++) {
+		const LuaAllocatorClassStats &class_stats = stats.classes[i];
+		godot::Dictionary entry;
+		entry["block_size"] = class_stats.block_size;
+		entry["live_blocks"] = class_stats.live_blocks;
+		entry["live_bytes"] = class_stats.live_bytes;
+		entry["peak_bytes"] = class_stats.peak_bytes;
+		classes.push_back(entry);
+	}
+
+	result["reserved_bytes"] = stats.reserved_bytes;
+	result["large_live_bytes"] = stats.large_live_bytes;
+	result["large_peak_bytes"] = stats.large_peak_bytes;
+	result["classes"] = classes;
+	return result;
+}
+
+void LuaHost::set_gc_budget_usec(int64_t p_budget_usec) {
+	if (!ensure_main_thread("LuaHost.set_gc_budget_usec")) {
+		return;
+	}
+	lua_gc_pacer_set_budget(LuaRuntime::get_state(), p_budget_usec);
+}
+
+int64_t LuaHost::get_gc_budget_usec() const {
+	return lua_gc_pacer_get_budget();
+}
+
+void LuaHost::set_gc_mode(int p_mode) {
+	if (!ensure_main_thread("LuaHost.set_gc_mode")) {
+		return;
+	}
+	if (p_mode < LUA_GC_MODE_AUTO || p_mode > LUA_GC_MODE_GENERATIONAL) {
+		godot::UtilityFunctions::printerr("LuaHost.set_gc_mode: invalid mode ", p_mode);
+		return;
+	}
+	lua_gc_pacer_set_mode(LuaRuntime::get_state(), (LuaGcMode)p_mode);
+}
+
+godot::Dictionary LuaHost::get_gc_stats() const {
+	const LuaGcFrameStats &stats = lua_gc_pacer_get_frame_stats();
+	godot::Dictionary result;
+	result["budget_usec"] = lua_gc_pacer_get_budget();
+	result["mode"] = (int)lua_gc_pacer_get_mode();
+	result["active_mode"] = (int)lua_gc_pacer_get_active_mode();
+	result["step_usec"] = stats.step_usec;
+	result["max_step_usec"] = stats.max_step_usec;
+	result["steps"] = stats.steps;
+	result["bytes_freed"] = stats.bytes_freed;
+	result["heap_bytes"] = stats.heap_bytes;
+	result["cycle_completed"] = stats.cycle_completed;
+	return result;
+}
+
+void LuaHost::profiler_start(int p_interval) {
+	if (!ensure_main_thread("LuaHost.profiler_start")) {
+		return;
+	}
+	lua_profiler_start(LuaRuntime::get_state(), p_interval);
+}
+
+void LuaHost::profiler_stop() {
+	if (!ensure_main_thread("LuaHost.profiler_stop")) {
+		return;
+	}
+	lua_profiler_stop(LuaRuntime::get_state());
+}
+
+godot::String LuaHost::profiler_dump(const godot::String &p_path) {
+	const godot::String text = lua_profiler_dump();
+	if (p_path.is_empty()) {
+		return text;
+	}
+
+	godot::Ref<godot::FileAccess> file = godot::FileAccess::open(p_path, godot::FileAccess::WRITE);
+	if (!file.is_valid()) {
+		godot::UtilityFunctions::printerr("LuaHost.profiler_dump: cannot open file '", p_path, "'");
+		return text;
+	}
+	file->store_string(text);
+	file->close();
+	return text;
+}
+
+void LuaHost::profiler_reset() {
+	if (!ensure_main_thread("LuaHost.profiler_reset")) {
+		return;
+	}
+	lua_profiler_reset();
+}
+
+void LuaHost::alloc_track_start(int p_interval) {
+	if (!ensure_main_thread("LuaHost.alloc_track_start")) {
+		return;
+	}
+	lua_alloc_profiler_start(LuaRuntime::get_state(), p_interval);
+}
+
+void LuaHost::alloc_track_stop() {
+	if (!ensure_main_thread("LuaHost.alloc_track_stop")) {
+		return;
+	}
+	lua_alloc_profiler_stop(LuaRuntime::get_state());
+}
+
+godot::Array LuaHost::get_alloc_report(int p_top_n, bool p_frame) const {
+	godot::Array result;
+	godot::LocalVector<const LuaAllocSite *> top;
+	lua_alloc_profiler_get_top(top, p_top_n, p_frame);
+	for (uint32_t i = 0; i < top.size(); i++) {
+		const LuaAllocSite *site = top[i];
+		godot::Dictionary entry;
+		entry["site"] = site->site;
+		entry["bytes"] = p_frame ? site->frame_bytes : site->bytes;
+		entry["count"] = p_frame ? site->frame_count : site->count;
+		result.push_back(entry);
+	}
+	return result;
+}
+
+void LuaHost::alloc_track_reset() {
+	if (!ensure_main_thread("LuaHost.alloc_track_reset")) {
+		return;
+	}
+	lua_alloc_profiler_reset();
+}
+
+void LuaHost::trace_start(int p_capacity) {
+	if (!ensure_main_thread("LuaHost.trace_start")) {
+		return;
+	}
+	host_trace_start(p_capacity > 0 ? (uint32_t)p_capacity : HOST_TRACE_DEFAULT_CAPACITY);
+}
+
+void LuaHost::trace_stop() {
+	if (!ensure_main_thread("LuaHost.trace_stop")) {
+		return;
+	}
+	host_trace_stop();
+}
+
+godot::String LuaHost::trace_dump(const godot::String &p_path) {
+	if (!ensure_main_thread("LuaHost.trace_dump")) {
+		return godot::String();
+	}
+	const godot::String text = host_trace_dump_json();
+	if (p_path.is_empty()) {
+		return text;
+	}
+
+	godot::Ref<godot::FileAccess> file = godot::FileAccess::open(p_path, godot::FileAccess::WRITE);
+	if (!file.is_valid()) {
+		godot::UtilityFunctions::printerr("LuaHost.trace_dump: cannot open file '", p_path, "'");
+		return text;
+	}
+	file->store_string(text);
+	file->close();
+	return text;
+}
+
+godot::Dictionary LuaHost::get_memory_stats(bool p_diff) {
+	godot::Dictionary result;
+	if (!ensure_main_thread("LuaHost.get_memory_stats")) {
+		return result;
+	}
+
+	godot::LocalVector<HostMemoryReport> reports;
+	host_memory_collect(reports, p_diff);
+	for (uint32_t i = 0; i < reports.size(); i++) {
+		const HostMemoryReport &report = reports[i];
+		godot::Dictionary entry;
+		entry["entries"] = report.entries;
+		entry["bytes"] = report.bytes;
+		entry["peak_entries"] = report.peak_entries;
+		entry["peak_bytes"] = report.peak_bytes;
+		entry["delta_entries"] = report.delta_entries;
+		entry["delta_bytes"] = report.delta_bytes;
+		result[report.name] = entry;
+	}
+	return result;
+}
+
+void LuaHost::reset_memory_stats() {
+	if (!ensure_main_thread("LuaHost.reset_memory_stats")) {
+		return;
+	}
+	host_memory_reset();
+}
+
+godot::Dictionary LuaHost::get_binding_stats() const {
+	godot::Dictionary modules;
+	const godot::LocalVector<LuaBindingRecord *> &records = lua_binding_stats_get_records();
+	for (uint32_t i = 0; i < records.size(); i++) {
+		const LuaBindingRecord *record = records[i];
+		const godot::String module_name = record->module_name;
+		if (!modules.has(module_name)) {
+			modules[module_name] = godot::Dictionary();
+		}
+
+		godot::Dictionary entry;
+		entry["calls"] = record->calls;
+		entry["nsec"] = record->nsec;
+		entry["frame_calls"] = record->frame_calls;
+		entry["frame_nsec"] = record->frame_nsec;
+		godot::Dictionary funcs = modules[module_name];
+		funcs[record->func_name] = entry;
+	}
+
+	godot::Dictionary result;
+	result["enabled"] = lua_binding_stats_is_enabled();
+	result["modules"] = modules;
+	return result;
+}
+
+void LuaHost::reset_binding_stats() {
+	if (!ensure_main_thread("LuaHost.reset_binding_stats")) {
+		return;
+	}
+	lua_binding_stats_reset();
+}
+
+godot::Array LuaHost::get_error_summary() const {
+	godot::Array result;
+	godot::LocalVector<const HostErrorRecord *> summary;
+	host_error_get_summary(summary);
+	for (uint32_t i = 0; i < summary.size(); i++) {
+		const HostErrorRecord *record = summary[i];
+		godot::Dictionary entry;
+		entry["func"] = godot::String(record->module) + "." + godot::String(record->func);
+		entry["message"] = record->message;
+		entry["count"] = record->count;
+		entry["suppressed"] = record->suppressed;
+		result.push_back(entry);
+	}
+	return result;
+}
+
+void LuaHost::reset_error_summary() {
+	if (!ensure_main_thread("LuaHost.reset_error_summary")) {
+		return;
+	}
+	host_error_reset();
+}
+
+void LuaHost::set_error_interval_msec(int64_t p_msec) {
+	if (!ensure_main_thread("LuaHost.set_error_interval_msec")) {
+		return;
+	}
+	host_error_set_interval_msec(p_msec);
+}
+
 } // namespace luagd
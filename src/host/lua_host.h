@@ -3,8 +3,13 @@
 
 #include <godot_cpp/classes/object.hpp>
 #include <godot_cpp/classes/ref.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
 #include <godot_cpp/variant/string.hpp>
 
+struct lua_State;
+
 namespace godot { class InputEvent; }
 
 namespace luagd {
@@ -28,11 +33,44 @@ public:
 	// p_code: Lua 源代码
 	int run_string(const godot::String &p_code);
 
-	// 调用 Lua 的 update 回调。
+	// 派发 PRE_PHYSICS 与 PHYSICS 阶段回调（含 bind_update 绑定的 update 回调）。
+	// update 之前派发已完成的工作线程任务回调；之后恢复到期的调度协程、派发到期定时器，并按预算推进 GC。
+	// 启用固定步长时，把 p_delta 累加后执行 0..max_steps 个固定步（每步执行 update、协程与定时器），
+	// 之后按插值比例写回登记的 Node3D 变换。
 	// 返回：成功返回 0，失败返回非零值。
-	// p_delta: 距上一物理帧的秒数。
+	// p_delta: 距上一次 tick 的秒数。
 	int tick(double p_delta);
 
+	// 同 tick，但跳过主线程检查与 Lua 状态查找，供 LuaTickNode 等原生调用方使用。
+	// 约束：只允许在主线程调用；p_L 为 LuaRuntime::get_state() 返回的非空状态。
+	int tick_state(lua_State *p_L, double p_delta);
+
+	// 返回：最近一次 tick 中 update 阶段（core_call_update，含所有固定步）的耗时（微秒）。
+	uint64_t get_frame_update_usec() const;
+
+	// 设置固定步长。
+	// p_step: 固定步长（秒，如 1.0 / 30.0），<= 0 时关闭，tick 直接使用传入的 delta。
+	// p_max_steps: 每次 tick 最多执行的固定步数，超出的积压时间被丢弃。
+	void set_fixed_timestep(double p_step, int p_max_steps);
+
+	// 返回：固定步长（秒），0 表示未启用。
+	double get_fixed_timestep() const;
+
+	// 返回：当前帧位于最近两个固定步之间的比例（0..1），未启用固定步长时返回 1。
+	// 渲染帧（process）中为按距上次 tick 的时间推进后的值。
+	double get_interpolation_alpha() const;
+
+	// 派发 PROCESS、LATE、RENDER_PREP 阶段回调，由 GDScript 的 _process 调用。
+	// 启用固定步长时先按 (积压时间 + 距上次 tick 的时间) / 步长 更新插值比例并写回登记的 Node3D 变换，
+	// 逻辑以 30 Hz 运行时，渲染帧仍逐帧插值。
+	// 返回：成功返回 0，失败返回非零值。
+	// p_delta: 距上一渲染帧的秒数。
+	int process(double p_delta);
+
+	// 同 process，但跳过主线程检查与 Lua 状态查找，供 LuaTickNode 等原生调用方使用。
+	// 约束：只允许在主线程调用；p_L 为 LuaRuntime::get_state() 返回的非空状态。
+	int process_state(lua_State *p_L, double p_delta);
+
 	// 调用 Lua 的 shutdown 回调。
 	// 错误只打印，不影响退出流程。
 	void shutdown();
@@ -41,6 +79,115 @@ public:
 	// p_event: Godot InputEvent。
 	void input(const godot::Ref<godot::InputEvent> &p_event);
 
+	// 配置字节码缓存。
+	// p_enabled: 是否启用缓存。
+	// p_cache_dir: 缓存目录，为空时使用 "user://luagd_bytecode"。
+	void set_bytecode_cache(bool p_enabled, const godot::String &p_cache_dir);
+
+	// 返回字节码缓存统计：{ hits, misses, stale, writes }。
+	godot::Dictionary get_bytecode_cache_stats() const;
+
+	// 设置 require 的模块根目录（如 ["res://scripts"]）并立即扫描建立索引，默认 ["res://"]。
+	// 应在 require 任何模块之前设置，已加载的模块不会按新根目录重新解析。
+	// 模块名 "a.b" 解析为 <root>/a/b.lua 或 <root>/a/b/init.lua。
+	void set_module_roots(const godot::PackedStringArray &p_roots);
+
+	// 返回：当前 require 模块根目录。
+	godot::PackedStringArray get_module_roots() const;
+
+	// 重新扫描根目录建立模块索引，耗时与根目录下文件数成正比。
+	void rebuild_module_index();
+
+	// 返回 Lua 池分配器统计：
+	// { enabled, reserved_bytes, large_live_bytes, large_peak_bytes,
+	//   classes: [{ block_size, live_blocks, live_bytes, peak_bytes }, ...] }。
+	// 构建时未启用 LUAGD_POOLED_ALLOCATOR 时只返回 { enabled = false }。
+	godot::Dictionary get_allocator_stats() const;
+
+	// 设置每帧 GC 时间预算（微秒）。
+	// p_budget_usec > 0 时停止 Lua 自动回收，改为在 tick 末尾按预算步进；<= 0 时恢复自动回收。
+	void set_gc_budget_usec(int64_t p_budget_usec);
+
+	// 返回：当前每帧 GC 预算（微秒），0 表示未接管。
+	int64_t get_gc_budget_usec() const;
+
+	// 设置 GC 模式：0 = AUTO，1 = 增量，2 = 分代。
+	void set_gc_mode(int p_mode);
+
+	// 返回最近一帧的 GC 统计：
+	// { budget_usec, mode, active_mode, step_usec, max_step_usec, steps, bytes_freed, heap_bytes, cycle_completed }。
+	godot::Dictionary get_gc_stats() const;
+
+	// 开始采样 Lua 调用栈，详见 lua_profiler_start()。
+	// p_interval: 采样间隔（指令数），默认 1000。
+	void profiler_start(int p_interval);
+
+	// 停止采样，已有样本保留。
+	void profiler_stop();
+
+	// 导出 collapsed stack 文本（flamegraph 格式）。
+	// p_path: 非空时同时写入该文件（如 "user://lua_profile.folded"）。
+	// 返回：collapsed stack 文本。
+	godot::String profiler_dump(const godot::String &p_path);
+
+	// 清空所有样本。
+	void profiler_reset();
+
+	// 开始按 Lua 调用点统计分配，详见 lua_alloc_profiler_start()。
+	// p_interval: 采样间隔（分配次数），默认 64。
+	void alloc_track_start(int p_interval);
+
+	// 停止统计，已有统计保留。
+	void alloc_track_stop();
+
+	// 返回分配字节数最多的调用点：[{ site, bytes, count }, ...]（降序，bytes / count 为估算值）。
+	// p_top_n: 最多返回的调用点数。
+	// p_frame: 为 true 时按上一帧统计，否则按自 start / reset 起的累计值。
+	godot::Array get_alloc_report(int p_top_n, bool p_frame) const;
+
+	// 清空所有调用点统计。
+	void alloc_track_reset();
+
+	// 开始记录帧时间线（原生区间与 native_debug.zone_begin / zone_end），清空已有事件。
+	// p_capacity: 环形缓冲容量（事件数），写满后覆盖最旧的事件。
+	void trace_start(int p_capacity);
+
+	// 停止记录，已有事件保留。
+	void trace_stop();
+
+	// 导出 Chrome trace event JSON（chrome://tracing 与 Perfetto UI 可直接打开）。
+	// p_path: 非空时同时写入该文件（如 "user://lua_trace.json"）。
+	// 返回：JSON 文本。
+	godot::String trace_dump(const godot::String &p_path);
+
+	// 返回各模块表与 Lua 堆的占用估算：
+	// { name: { entries, bytes, peak_entries, peak_bytes, delta_entries, delta_bytes } }。
+	// 高水位在查询时与每 30 次 tick 采样更新。
+	// p_diff: 为 true 时 delta_* 为相对上一次 diff 查询的变化，并把本次结果记为新的快照；否则 delta_* 为 0。
+	godot::Dictionary get_memory_stats(bool p_diff);
+
+	// 清除高水位与 diff 快照。
+	void reset_memory_stats();
+
+	// 返回原生绑定调用统计：
+	// { enabled, modules: { native_x: { func: { calls, nsec, frame_calls, frame_nsec } } } }。
+	// 构建时需启用 LUAGD_BINDING_STATS，否则 modules 为空。
+	godot::Dictionary get_binding_stats() const;
+
+	// 清零原生绑定调用统计。
+	void reset_binding_stats();
+
+	// 返回原生模块参数 / 句柄错误汇总（按累计次数降序）：
+	// [{ func, message, count, suppressed }, ...]。
+	godot::Array get_error_summary() const;
+
+	// 清空错误汇总。
+	void reset_error_summary();
+
+	// 设置同一错误的最短输出间隔。
+	// p_msec: 间隔（毫秒），0 表示每次都输出，< 0 时恢复默认值 1000。
+	void set_error_interval_msec(int64_t p_msec);
+
 	// 单例访问
 	static LuaHost *get_singleton();
 
@@ -49,6 +196,18 @@ protected:
 
 private:
 	static LuaHost *singleton;
+
+	double fixed_timestep = 0.0;
+	int max_fixed_steps = 5;
+	double fixed_accumulator = 0.0;
+	double interpolation_alpha = 1.0;
+	// 最近一次 tick 结束的时刻，渲染帧据此推进插值比例
+	uint64_t last_tick_usec = 0;
+	uint64_t frame_update_usec = 0;
+	uint32_t memory_sample_countdown = 0;
+
+	// 执行一步逻辑：update 回调、协程调度与定时器。
+	int _run_step(lua_State *p_L, double p_delta);
 };
 
 } // namespace luagd
@@ -0,0 +1,97 @@
+#include "lua_tick_node.h"
+
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/core/class_db.hpp>
+
+#include "lua_host.h"
+#include "../lua/lua_runtime.h"
+#include "../modules/input_module.h"
+
+namespace luagd {
+
+// 编辑器中打开场景时节点同样会进树，此时不驱动 Lua
+static bool _is_editor() {
+	return godot::Engine::get_singleton()->is_editor_hint();
+}
+
+void LuaTickNode::_bind_methods() {
+	godot::ClassDB::bind_method(godot::D_METHOD("set_physics_enabled", "enabled"), &LuaTickNode::set_physics_enabled);
+	godot::ClassDB::bind_method(godot::D_METHOD("is_physics_enabled"), &LuaTickNode::is_physics_enabled);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_process_enabled", "enabled"), &LuaTickNode::set_process_enabled);
+	godot::ClassDB::bind_method(godot::D_METHOD("is_process_enabled"), &LuaTickNode::is_process_enabled);
+	godot::ClassDB::bind_method(godot::D_METHOD("set_input_enabled", "enabled"), &LuaTickNode::set_input_enabled);
+	godot::ClassDB::bind_method(godot::D_METHOD("is_input_enabled"), &LuaTickNode::is_input_enabled);
+
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::BOOL, "physics_enabled"), "set_physics_enabled", "is_physics_enabled");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::BOOL, "process_enabled"), "set_process_enabled", "is_process_enabled");
+	ADD_PROPERTY(godot::PropertyInfo(godot::Variant::BOOL, "input_enabled"), "set_input_enabled", "is_input_enabled");
+}
+
+void LuaTickNode::_ready() {
+	// Node 在 READY 时会为覆写了虚函数的类自动开启对应处理，这里按开关重新设置
+	const bool editor = _is_editor();
+	set_physics_process(physics_enabled && !editor);
+	set_process(process_enabled && !editor);
+	set_process_input(input_enabled && !editor);
+}
+
+void LuaTickNode::_physics_process(double p_delta) {
+	LuaHost *host = LuaHost::get_singleton();
+	lua_State *L = LuaRuntime::get_state();
+	if (host == nullptr || L == nullptr) {
+		return;
+	}
+	host->tick_state(L, p_delta);
+}
+
+void LuaTickNode::_process(double p_delta) {
+	LuaHost *host = LuaHost::get_singleton();
+	lua_State *L = LuaRuntime::get_state();
+	if (host == nullptr || L == nullptr) {
+		return;
+	}
+	host->process_state(L, p_delta);
+}
+
+void LuaTickNode::_input(const godot::Ref<godot::InputEvent> &p_event) {
+	lua_State *L = LuaRuntime::get_state();
+	if (L == nullptr || p_event.is_null()) {
+		return;
+	}
+	input_dispatch_event(L, p_event.ptr());
+}
+
+void LuaTickNode::set_physics_enabled(bool p_enabled) {
+	physics_enabled = p_enabled;
+	if (is_inside_tree() && !_is_editor()) {
+		set_physics_process(p_enabled);
+	}
+}
+
+bool LuaTickNode::is_physics_enabled() const {
+	return physics_enabled;
+}
+
+void LuaTickNode::set_process_enabled(bool p_enabled) {
+	process_enabled = p_enabled;
+	if (is_inside_tree() && !_is_editor()) {
+		set_process(p_enabled);
+	}
+}
+
+bool LuaTickNode::is_process_enabled() const {
+	return process_enabled;
+}
+
+void LuaTickNode::set_input_enabled(bool p_enabled) {
+	input_enabled = p_enabled;
+	if (is_inside_tree() && !_is_editor()) {
+		set_process_input(p_enabled);
+	}
+}
+
+bool LuaTickNode::is_input_enabled() const {
+	return input_enabled;
+}
+
+} // namespace luagd
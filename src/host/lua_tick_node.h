@@ -0,0 +1,48 @@
+#ifndef LUAGD_LUA_TICK_NODE_H
+#define LUAGD_LUA_TICK_NODE_H
+
+#include <godot_cpp/classes/input_event.hpp>
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/classes/ref.hpp>
+
+namespace luagd {
+
+// LuaTickNode：在原生回调中直接驱动 Lua，替代 GDScript 中转的 LuaHost.tick / process / input。
+// _physics_process -> LuaHost::tick_state（PRE_PHYSICS / PHYSICS、协程、定时器、GC 步进）
+// _process -> LuaHost::process_state（固定步长插值写回，PROCESS / LATE / RENDER_PREP）
+// _input -> input_dispatch_event
+// 每个阶段可单独关闭；场景中只应放置一个实例。编辑器中不开启任何处理。
+// 约束：所有方法在主线程调用（由场景树保证）。
+class LuaTickNode : public godot::Node {
+	GDCLASS(LuaTickNode, godot::Node);
+
+public:
+	void _ready() override;
+	void _physics_process(double p_delta) override;
+	void _process(double p_delta) override;
+	void _input(const godot::Ref<godot::InputEvent> &p_event) override;
+
+	// 是否在 _physics_process 中调用 tick，默认开启。
+	void set_physics_enabled(bool p_enabled);
+	bool is_physics_enabled() const;
+
+	// 是否在 _process 中派发 PROCESS / LATE / RENDER_PREP 阶段，默认开启。
+	void set_process_enabled(bool p_enabled);
+	bool is_process_enabled() const;
+
+	// 是否把 _input 收到的事件传给 native_input，默认开启。
+	void set_input_enabled(bool p_enabled);
+	bool is_input_enabled() const;
+
+protected:
+	static void _bind_methods();
+
+private:
+	bool physics_enabled = true;
+	bool process_enabled = true;
+	bool input_enabled = true;
+};
+
+} // namespace luagd
+
+#endif // LUAGD_LUA_TICK_NODE_H
@@ -0,0 +1,238 @@
+#include "lua_alloc_profiler.h"
+
+#include <godot_cpp/templates/hash_map.hpp>
+
+extern "C" {
+#include <lua.h>
+#include <lauxlib.h>
+}
+
+namespace luagd {
+
+// 不同调用点的数量上限，超出后样本计入 OVERFLOW_SITE
+static const uint32_t MAX_SITES = 1 << 14;
+static const char *OVERFLOW_SITE = "[other]";
+
+static bool running = false;
+static uint32_t sample_interval = LUA_ALLOC_PROFILER_DEFAULT_INTERVAL;
+static uint32_t sample_countdown = LUA_ALLOC_PROFILER_DEFAULT_INTERVAL;
+static int64_t sample_count = 0;
+
+// 被包装的原分配器
+static lua_Alloc original_alloc = nullptr;
+static void *original_ud = nullptr;
+
+// 当前运行线程与挂在其上的一次性 hook
+static lua_State *main_state = nullptr;
+static lua_State *current_thread = nullptr;
+static lua_State *armed_thread = nullptr;
+static lua_Hook saved_hook = nullptr;
+static int saved_mask = 0;
+static int saved_count = 0;
+
+// 已采样、尚未归属到调用点的估算值
+static int64_t pending_bytes = 0;
+static int64_t pending_count = 0;
+
+static godot::HashMap<godot::String, LuaAllocSite> sites;
+
+static void _attribute(const godot::String &p_site) {
+	LuaAllocSite *site = sites.getptr(p_site);
+	if (site == nullptr) {
+		const godot::String key = sites.size() < MAX_SITES ? p_site : godot::String(OVERFLOW_SITE);
+		site = sites.getptr(key);
+		if (site == nullptr) {
+			site = &sites.insert(key, LuaAllocSite())->value;
+			site->site = key;
+		}
+	}
+	site->bytes += pending_bytes;
+	site->count += pending_count;
+	pending_bytes = 0;
+	pending_count = 0;
+}
+
+static void _restore_hook(lua_State *p_L) {
+	lua_sethook(p_L, saved_hook, saved_mask, saved_count);
+}
+
+static void _alloc_hook(lua_State *p_L, lua_Debug *p_ar) {
+	if (p_L != armed_thread) {
+		// 挂 hook 期间创建的协程继承了它，还原为原 hook
+		_restore_hook(p_L);
+		return;
+	}
+	armed_thread = nullptr;
+	_restore_hook(p_L);
+
+	if (!running || pending_count == 0) {
+		return;
+	}
+	// hook 内栈处于一致状态，可以安全读取调用点
+	if (lua_getinfo(p_L, "Sl", p_ar) == 0) {
+		return;
+	}
+	godot::String site = godot::String::utf8(p_ar->short_src);
+	if (p_ar->currentline > 0) {
+		site += ":" + godot::String::num_int64(p_ar->currentline);
+	}
+	_attribute(site);
+}
+
+// 在当前线程上挂一次性 count hook，下一条 Lua 指令处归属待处理样本。
+// lua_sethook 可在任意时刻安全调用（官方允许在信号处理函数中调用），分配器内也不例外。
+static void _arm_hook() {
+	if (armed_thread != nullptr || current_thread == nullptr) {
+		return;
+	}
+	armed_thread = current_thread;
+	saved_hook = lua_gethook(armed_thread);
+	saved_mask = lua_gethookmask(armed_thread);
+	saved_count = lua_gethookcount(armed_thread);
+	lua_sethook(armed_thread, _alloc_hook, LUA_MASKCOUNT, 1);
+}
+
+static void _disarm_hook() {
+	if (armed_thread != nullptr) {
+		_restore_hook(armed_thread);
+		armed_thread = nullptr;
+	}
+}
+
+static void *_tracking_alloc(void *p_ud, void *p_ptr, size_t p_osize, size_t p_nsize) {
+	void *result = original_alloc(original_ud, p_ptr, p_osize, p_nsize);
+	if (result == nullptr || !running) {
+		return result;
+	}
+
+	// p_ptr 为空时 p_osize 是类型标记而不是旧大小
+	const size_t old_size = p_ptr != nullptr ? p_osize : 0;
+	if (p_nsize <= old_size) {
+		return result;
+	}
+	sample_countdown -= 1;
+	if (sample_countdown != 0) {
+		return result;
+	}
+	sample_countdown = sample_interval;
+
+	// 每个样本代表 sample_interval 次分配
+	pending_bytes += (int64_t)(p_nsize - old_size) * sample_interval;
+	pending_count += sample_interval;
+	sample_count += 1;
+	_arm_hook();
+	return result;
+}
+
+void lua_alloc_profiler_start(lua_State *p_L, int p_interval) {
+	if (p_L == nullptr) {
+		return;
+	}
+
+	sample_interval = p_interval > 0 ? (uint32_t)p_interval : LUA_ALLOC_PROFILER_DEFAULT_INTERVAL;
+	sample_countdown = sample_interval;
+	if (running) {
+		return;
+	}
+
+	original_alloc = lua_getallocf(p_L, &original_ud);
+	lua_setallocf(p_L, _tracking_alloc, nullptr);
+	main_state = p_L;
+	if (current_thread == nullptr) {
+		current_thread = p_L;
+	}
+	running = true;
+}
+
+void lua_alloc_profiler_stop(lua_State *p_L) {
+	if (!running) {
+		return;
+	}
+
+	running = false;
+	_disarm_hook();
+	if (p_L != nullptr && original_alloc != nullptr) {
+		lua_setallocf(p_L, original_alloc, original_ud);
+	}
+	pending_bytes = 0;
+	pending_count = 0;
+}
+
+bool lua_alloc_profiler_is_running() {
+	return running;
+}
+
+lua_State *lua_alloc_profiler_set_thread(lua_State *p_thread) {
+	lua_State *previous = current_thread;
+	if (armed_thread != nullptr && armed_thread != p_thread) {
+		// 旧线程可能在 resume 返回后被回收，不能把 hook 留在上面
+		_disarm_hook();
+	}
+	current_thread = p_thread != nullptr ? p_thread : main_state;
+	return previous;
+}
+
+void lua_alloc_profiler_end_frame() {
+	for (godot::KeyValue<godot::String, LuaAllocSite> &entry : sites) {
+		LuaAllocSite &site = entry.value;
+		site.frame_bytes = site.bytes - site.frame_start_bytes;
+		site.frame_count = site.count - site.frame_start_count;
+		site.frame_start_bytes = site.bytes;
+		site.frame_start_count = site.count;
+	}
+}
+
+void lua_alloc_profiler_get_top(godot::LocalVector<const LuaAllocSite *> &r_sites, int p_top_n, bool p_frame) {
+	r_sites.clear();
+	if (p_top_n <= 0) {
+		return;
+	}
+
+	for (const godot::KeyValue<godot::String, LuaAllocSite> &entry : sites) {
+		const LuaAllocSite *site = &entry.value;
+		const int64_t bytes = p_frame ? site->frame_bytes : site->bytes;
+		if (bytes <= 0) {
+			continue;
+		}
+
+		// 插入排序维护前 N 个，N 通常很小
+		uint32_t index = r_sites.size();
+		while (index > 0 && (p_frame ? r_sites[index - 1]->frame_bytes : r_sites[index - 1]->bytes) < bytes) {
+			index--;
+		}
+		if (index >= (uint32_t)p_top_n) {
+			continue;
+		}
+		r_sites.insert(index, site);
+		if (r_sites.size() > (uint32_t)p_top_n) {
+			r_sites.resize(p_top_n);
+		}
+	}
+}
+
+int64_t lua_alloc_profiler_get_sample_count() {
+	return sample_count;
+}
+
+void lua_alloc_profiler_reset() {
+	sites.clear();
+	sample_count = 0;
+	pending_bytes = 0;
+	pending_count = 0;
+}
+
+void lua_alloc_profiler_cleanup(lua_State *p_L) {
+	lua_alloc_profiler_stop(p_L);
+	lua_alloc_profiler_reset();
+	original_alloc = nullptr;
+	original_ud = nullptr;
+	main_state = nullptr;
+	current_thread = nullptr;
+	saved_hook = nullptr;
+	saved_mask = 0;
+	saved_count = 0;
+	sample_interval = LUA_ALLOC_PROFILER_DEFAULT_INTERVAL;
+	sample_countdown = LUA_ALLOC_PROFILER_DEFAULT_INTERVAL;
+}
+
+} // namespace luagd
@@ -0,0 +1,70 @@
+#ifndef LUAGD_LUA_ALLOC_PROFILER_H
+#define LUAGD_LUA_ALLOC_PROFILER_H
+
+#include <cstdint>
+
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+struct lua_State;
+
+namespace luagd {
+
+// 默认采样间隔：每 64 次分配采样一次调用点。
+static const int LUA_ALLOC_PROFILER_DEFAULT_INTERVAL = 64;
+
+// 一个分配调用点（"source:line"）的统计，bytes / count 为按采样间隔放大后的估算值。
+struct LuaAllocSite {
+	godot::String site;
+	// 自 start 或 reset 起的累计值
+	int64_t bytes;
+	int64_t count;
+	// 上一帧（两次 lua_alloc_profiler_end_frame 之间）的值
+	int64_t frame_bytes;
+	int64_t frame_count;
+	// 本帧开始时的累计值，用于计算 frame_*
+	int64_t frame_start_bytes;
+	int64_t frame_start_count;
+};
+
+// 开始记录分配调用点。用包装分配器替换 p_L 的 lua_Alloc（池分配器或默认分配器照常工作），
+// 每 p_interval 次分配（新块或扩容）取一次样：分配器内只累计待归属字节并通过 lua_sethook 挂一次性 count hook，
+// 由 hook 在下一条 Lua 指令处用 lua_getinfo 取得调用点，避免在分配器内（栈可能正在重分配）遍历调用栈。
+// 样本归属到当前运行线程：调度器恢复的协程单独归属，coroutine.resume 直接恢复的协程归属到恢复点。
+// 重复调用只更新采样间隔，已有统计保留。
+// p_interval: 采样间隔（分配次数），<= 0 时使用默认值。
+// 约束：只允许在主线程调用；与 lua_profiler 同时运行时，采样期间会暂时接管 hook。
+void lua_alloc_profiler_start(lua_State *p_L, int p_interval);
+
+// 停止记录并恢复原分配器，已有统计保留。
+// 约束：只允许在主线程调用。
+void lua_alloc_profiler_stop(lua_State *p_L);
+
+// 返回：是否正在记录。
+bool lua_alloc_profiler_is_running();
+
+// 设置当前运行的 Lua 线程，样本的 hook 挂在该线程上。由协程调度器在 lua_resume 前后调用。
+// 返回：之前的线程，resume 返回后传回以恢复。
+// 切换时若旧线程上仍挂着未触发的 hook，立即还原其原 hook，待归属字节留到下一次触发。
+lua_State *lua_alloc_profiler_set_thread(lua_State *p_thread);
+
+// 结束当前帧：把本帧增量写入各调用点的 frame_*。由 LuaHost::tick 在每帧开始时调用。
+void lua_alloc_profiler_end_frame();
+
+// 按字节数取前 p_top_n 个调用点（降序）。
+// p_frame: 为 true 时按上一帧的 frame_bytes 排序并跳过上一帧无分配的调用点，否则按累计值排序。
+void lua_alloc_profiler_get_top(godot::LocalVector<const LuaAllocSite *> &r_sites, int p_top_n, bool p_frame);
+
+// 返回：累计样本数。
+int64_t lua_alloc_profiler_get_sample_count();
+
+// 清空所有调用点统计。
+void lua_alloc_profiler_reset();
+
+// 恢复原分配器并重置全部状态。在 LuaRuntime::shutdown 关闭 state 之前调用，
+// 关闭过程中的释放需直接走原分配器。
+void lua_alloc_profiler_cleanup(lua_State *p_L);
+
+} // namespace luagd
+
+#endif // LUAGD_LUA_ALLOC_PROFILER_H
@@ -0,0 +1,206 @@
+#include "lua_allocator.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace luagd {
+
+// 每次向系统申请的池页大小，按级别切分为等长块。
+static const size_t POOL_PAGE_SIZE = 16 * 1024;
+
+LuaPoolAllocator::LuaPoolAllocator() {
+	for (int i = 0; i < LUA_ALLOCATOR_CLASS_COUNT; i++) {
+		free_lists[i] = nullptr;
+		stats.classes[i].block_size = (int64_t)((i + 1) * LUA_ALLOCATOR_GRANULARITY);
+	}
+}
+
+LuaPoolAllocator::~LuaPoolAllocator() {
+	release();
+}
+
+int LuaPoolAllocator::_size_class(size_t p_size) {
+	if (p_size == 0 || p_size > LUA_ALLOCATOR_SMALL_MAX) {
+		return -1;
+	}
+	return (int)((p_size + LUA_ALLOCATOR_GRANULARITY - 1) / LUA_ALLOCATOR_GRANULARITY) - 1;
+}
+
+bool LuaPoolAllocator::_grow_class(int p_class) {
+	char *page = static_cast<char *>(malloc(POOL_PAGE_SIZE));
+	if (page == nullptr) {
+		return false;
+	}
+
+	pages.push_back(page);
+	stats.reserved_bytes += (int64_t)POOL_PAGE_SIZE;
+
+	// 将整页切分为等长块并串入空闲链表
+	const size_t block_size = (size_t)stats.classes[p_class].block_size;
+	const size_t block_count = POOL_PAGE_SIZE / block_size;
+	for (size_t i = 0; i < block_count; i++) {
+		FreeBlock *block = reinterpret_cast<FreeBlock *>(page + i * block_size);
+		block->next = free_lists[p_class];
+		free_lists[p_class] = block;
+	}
+	return true;
+}
+
+void *LuaPoolAllocator::_alloc_small(int p_class) {
+	if (free_lists[p_class] == nullptr && !_grow_class(p_class)) {
+		return nullptr;
+	}
+
+	FreeBlock *block = free_lists[p_class];
+	free_lists[p_class] = block->next;
+
+	LuaAllocatorClassStats &class_stats = stats.classes[p_class];
+	class_stats.live_blocks += 1;
+	class_stats.live_bytes += class_stats.block_size;
+	if (class_stats.live_bytes > class_stats.peak_bytes) {
+		class_stats.peak_bytes = class_stats.live_bytes;
+	}
+	return block;
+}
+
+void LuaPoolAllocator::_free_small(void *p_ptr, int p_class) {
+	FreeBlock *block = static_cast<FreeBlock *>(p_ptr);
+	block->next = free_lists[p_class];
+	free_lists[p_class] = block;
+
+	LuaAllocatorClassStats &class_stats = stats.classes[p_class];
+	class_stats.live_blocks -= 1;
+	class_stats.live_bytes -= class_stats.block_size;
+}
+
+void *LuaPoolAllocator::_alloc_large(size_t p_size) {
+	void *ptr = malloc(p_size);
+	if (ptr == nullptr) {
+		return nullptr;
+	}
+
+	stats.large_live_bytes += (int64_t)p_size;
+	if (stats.large_live_bytes > stats.large_peak_bytes) {
+		stats.large_peak_bytes = stats.large_live_bytes;
+	}
+	return ptr;
+}
+
+void *LuaPoolAllocator::_realloc_large(void *p_ptr, size_t p_osize, size_t p_nsize) {
+	void *ptr = realloc(p_ptr, p_nsize);
+	if (ptr == nullptr) {
+		// Lua 假定收缩不会失败：原块仍然有效且足够大，直接沿用
+		if (p_nsize > p_osize) {
+			return nullptr;
+		}
+		ptr = p_ptr;
+	}
+
+	stats.large_live_bytes += (int64_t)p_nsize - (int64_t)p_osize;
+	if (stats.large_live_bytes > stats.large_peak_bytes) {
+		stats.large_peak_bytes = stats.large_live_bytes;
+	}
+	return ptr;
+}
+
+void LuaPoolAllocator::_free_large(void *p_ptr, size_t p_size) {
+	free(p_ptr);
+	stats.large_live_bytes -= (int64_t)p_size;
+}
+
+void *LuaPoolAllocator::_realloc(void *p_ptr, size_t p_osize, size_t p_nsize) {
+	const int old_class = _size_class(p_osize);
+	const int new_class = _size_class(p_nsize);
+
+	// 同级别内伸缩无需搬移
+	if (old_class >= 0 && old_class == new_class) {
+		return p_ptr;
+	}
+
+	if (old_class < 0 && new_class < 0) {
+		return _realloc_large(p_ptr, p_osize, p_nsize);
+	}
+
+	void *new_ptr = new_class >= 0 ? _alloc_small(new_class) : _alloc_large(p_nsize);
+	if (new_ptr == nullptr) {
+		if (p_nsize > p_osize) {
+			return nullptr;
+		}
+
+		// 收缩到小块级别但池页申请失败：之后会以新尺寸归还，进入新级别的空闲链表。
+		if (old_class >= 0) {
+			// 原块是池内更大的块，沿用并按新级别记账，只浪费空间，不会越界
+			stats.classes[old_class].live_blocks -= 1;
+			stats.classes[old_class].live_bytes -= stats.classes[old_class].block_size;
+		} else {
+			// 原块是 malloc 的大块：先尽量缩小，再作为单块池页登记，release() 时随池页一并 free，
+			// 否则它进入空闲链表后既不会被 free，也会被池当作自己的块分配出去
+			const size_t block_size = (size_t)stats.classes[new_class].block_size;
+			void *shrunk = realloc(p_ptr, block_size);
+			if (shrunk != nullptr) {
+				p_ptr = shrunk;
+			}
+			stats.large_live_bytes -= (int64_t)p_osize;
+			pages.push_back(p_ptr);
+			stats.reserved_bytes += (int64_t)block_size;
+		}
+		stats.classes[new_class].live_blocks += 1;
+		stats.classes[new_class].live_bytes += stats.classes[new_class].block_size;
+		return p_ptr;
+	}
+
+	memcpy(new_ptr, p_ptr, p_osize < p_nsize ? p_osize : p_nsize);
+	if (old_class >= 0) {
+		_free_small(p_ptr, old_class);
+	} else {
+		_free_large(p_ptr, p_osize);
+	}
+	return new_ptr;
+}
+
+void *LuaPoolAllocator::lua_alloc(void *p_ud, void *p_ptr, size_t p_osize, size_t p_nsize) {
+	LuaPoolAllocator *self = static_cast<LuaPoolAllocator *>(p_ud);
+
+	if (p_nsize == 0) {
+		if (p_ptr != nullptr) {
+			const int old_class = _size_class(p_osize);
+			if (old_class >= 0) {
+				self->_free_small(p_ptr, old_class);
+			} else {
+				self->_free_large(p_ptr, p_osize);
+			}
+		}
+		return nullptr;
+	}
+
+	// p_ptr 为空时 p_osize 是对象类型标记而非尺寸
+	if (p_ptr == nullptr) {
+		const int new_class = _size_class(p_nsize);
+		return new_class >= 0 ? self->_alloc_small(new_class) : self->_alloc_large(p_nsize);
+	}
+
+	return self->_realloc(p_ptr, p_osize, p_nsize);
+}
+
+void LuaPoolAllocator::release() {
+	for (int i = 0; i < pages.size(); i++) {
+		free(pages[i]);
+	}
+	pages.clear();
+
+	for (int i = 0; i < LUA_ALLOCATOR_CLASS_COUNT; i++) {
+		free_lists[i] = nullptr;
+		const int64_t block_size = stats.classes[i].block_size;
+		stats.classes[i] = LuaAllocatorClassStats();
+		stats.classes[i].block_size = block_size;
+	}
+	stats.large_live_bytes = 0;
+	stats.large_peak_bytes = 0;
+	stats.reserved_bytes = 0;
+}
+
+const LuaAllocatorStats &LuaPoolAllocator::get_stats() const {
+	return stats;
+}
+
+} // namespace luagd
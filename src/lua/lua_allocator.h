@@ -0,0 +1,84 @@
+#ifndef LUAGD_LUA_ALLOCATOR_H
+#define LUAGD_LUA_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <godot_cpp/templates/vector.hpp>
+
+namespace luagd {
+
+// 小块分级：16 字节粒度，覆盖 16..256 字节（Lua 对象绝大多数落在此范围）。
+static const size_t LUA_ALLOCATOR_GRANULARITY = 16;
+static const size_t LUA_ALLOCATOR_SMALL_MAX = 256;
+static const int LUA_ALLOCATOR_CLASS_COUNT = (int)(LUA_ALLOCATOR_SMALL_MAX / LUA_ALLOCATOR_GRANULARITY);
+
+// 单个尺寸级别的统计。
+struct LuaAllocatorClassStats {
+	int64_t block_size;
+	int64_t live_blocks;
+	int64_t live_bytes;
+	int64_t peak_bytes;
+
+	LuaAllocatorClassStats() :
+			block_size(0),
+			live_blocks(0),
+			live_bytes(0),
+			peak_bytes(0) {}
+};
+
+// 分配器整体统计。
+struct LuaAllocatorStats {
+	LuaAllocatorClassStats classes[LUA_ALLOCATOR_CLASS_COUNT];
+	int64_t large_live_bytes;
+	int64_t large_peak_bytes;
+	int64_t reserved_bytes;
+
+	LuaAllocatorStats() :
+			large_live_bytes(0),
+			large_peak_bytes(0),
+			reserved_bytes(0) {}
+};
+
+// LuaPoolAllocator：lua_State 使用的分级池分配器。
+// 小块（<= 256 字节）从按级别划分的空闲链表分配，大块直接交给 libc。
+// 池页在 release() 前不归还系统，避免实体频繁创建销毁带来的碎片。
+// 约束：非线程安全，每个 lua_State 独占一个实例。
+class LuaPoolAllocator {
+public:
+	LuaPoolAllocator();
+	~LuaPoolAllocator();
+
+	// lua_Alloc 回调，p_ud 为 LuaPoolAllocator 实例。
+	static void *lua_alloc(void *p_ud, void *p_ptr, size_t p_osize, size_t p_nsize);
+
+	// 释放所有池页并重置统计。
+	// 约束：必须在对应的 lua_State 关闭之后调用。
+	void release();
+
+	// 返回：当前统计快照。
+	const LuaAllocatorStats &get_stats() const;
+
+private:
+	struct FreeBlock {
+		FreeBlock *next;
+	};
+
+	static int _size_class(size_t p_size);
+
+	void *_alloc_small(int p_class);
+	void _free_small(void *p_ptr, int p_class);
+	bool _grow_class(int p_class);
+	void *_alloc_large(size_t p_size);
+	void *_realloc_large(void *p_ptr, size_t p_osize, size_t p_nsize);
+	void _free_large(void *p_ptr, size_t p_size);
+	void *_realloc(void *p_ptr, size_t p_osize, size_t p_nsize);
+
+	FreeBlock *free_lists[LUA_ALLOCATOR_CLASS_COUNT];
+	godot::Vector<void *> pages;
+	LuaAllocatorStats stats;
+};
+
+} // namespace luagd
+
+#endif // LUAGD_LUA_ALLOCATOR_H
@@ -0,0 +1,117 @@
+#include "lua_binding_stats.h"
+
+#include "../host/host_clock.h"
+
+#include <godot_cpp/core/memory.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+
+namespace luagd {
+
+static godot::LocalVector<LuaBindingRecord *> records;
+
+#if LUAGD_BINDING_STATS
+// luaL_Reg 条目地址 -> 记录。模块被重复 require（如清空 package.loaded 后）时沿用同一条记录。
+static godot::HashMap<const luaL_Reg *, LuaBindingRecord *> records_by_reg;
+
+static LuaBindingRecord *_get_record(const char *p_module_name, const luaL_Reg *p_reg) {
+	LuaBindingRecord **existing = records_by_reg.getptr(p_reg);
+	if (existing != nullptr) {
+		return *existing;
+	}
+
+	LuaBindingRecord *record = godot::memnew(LuaBindingRecord);
+	record->module_name = p_module_name;
+	record->func_name = p_reg->name;
+	record->func = p_reg->func;
+	record->calls = 0;
+	record->nsec = 0;
+	record->frame_calls = 0;
+	record->frame_nsec = 0;
+	record->frame_start_calls = 0;
+	record->frame_start_nsec = 0;
+	records.push_back(record);
+	records_by_reg[p_reg] = record;
+	return record;
+}
+
+// 包装闭包：upvalue 1 为 LuaBindingRecord。
+// 被包装函数抛出 Lua 错误时 longjmp 越过计时，只记调用次数。
+static int _instrumented_call(lua_State *p_L) {
+	LuaBindingRecord *record = static_cast<LuaBindingRecord *>(lua_touserdata(p_L, lua_upvalueindex(1)));
+	record->calls += 1;
+
+	const uint64_t start = host_clock_nsec();
+	const int result = record->func(p_L);
+	record->nsec += (int64_t)(host_clock_nsec() - start);
+	return result;
+}
+#endif
+
+void lua_binding_new_lib(lua_State *p_L, const char *p_module_name, const luaL_Reg *p_funcs) {
+	int count = 0;
+	while (p_funcs[count].name != nullptr) {
+		count++;
+	}
+	lua_createtable(p_L, 0, count);
+
+#if LUAGD_BINDING_STATS
+	for (const luaL_Reg *reg = p_funcs; reg->name != nullptr; reg++) {
+		if (reg->func == nullptr) {
+			lua_pushboolean(p_L, 0);
+		} else {
+			lua_pushlightuserdata(p_L, _get_record(p_module_name, reg));
+			lua_pushcclosure(p_L, _instrumented_call, 1);
+		}
+		lua_setfield(p_L, -2, reg->name);
+	}
+#else
+	(void)p_module_name;
+	luaL_setfuncs(p_L, p_funcs, 0);
+#endif
+}
+
+bool lua_binding_stats_is_enabled() {
+#if LUAGD_BINDING_STATS
+	return true;
+#else
+	return false;
+#endif
+}
+
+const godot::LocalVector<LuaBindingRecord *> &lua_binding_stats_get_records() {
+	return records;
+}
+
+void lua_binding_stats_end_frame() {
+	for (uint32_t i = 0; i < records.size(); i++) {
+		LuaBindingRecord *record = records[i];
+		record->frame_calls = record->calls - record->frame_start_calls;
+		record->frame_nsec = record->nsec - record->frame_start_nsec;
+		record->frame_start_calls = record->calls;
+		record->frame_start_nsec = record->nsec;
+	}
+}
+
+void lua_binding_stats_reset() {
+	for (uint32_t i = 0; i < records.size(); i++) {
+		LuaBindingRecord *record = records[i];
+		record->calls = 0;
+		record->nsec = 0;
+		record->frame_calls = 0;
+		record->frame_nsec = 0;
+		record->frame_start_calls = 0;
+		record->frame_start_nsec = 0;
+	}
+}
+
+void lua_binding_stats_cleanup() {
+	for (uint32_t i = 0; i < records.size(); i++) {
+		godot::memdelete(records[i]);
+	}
+	records.clear();
+#if LUAGD_BINDING_STATS
+	records_by_reg.clear();
+#endif
+}
+
+} // namespace luagd
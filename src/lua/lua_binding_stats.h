@@ -0,0 +1,56 @@
+#ifndef LUAGD_LUA_BINDING_STATS_H
+#define LUAGD_LUA_BINDING_STATS_H
+
+#include <cstdint>
+
+#include <godot_cpp/templates/local_vector.hpp>
+
+extern "C" {
+#include <lua.h>
+#include <lauxlib.h>
+}
+
+namespace luagd {
+
+// 单个绑定函数的调用统计。
+struct LuaBindingRecord {
+	const char *module_name;
+	const char *func_name;
+	lua_CFunction func;
+	// 自上次 reset 起的累计值
+	int64_t calls;
+	int64_t nsec;
+	// 上一帧（两次 lua_binding_stats_end_frame 之间）的值
+	int64_t frame_calls;
+	int64_t frame_nsec;
+	// 本帧开始时的累计值，用于计算 frame_*
+	int64_t frame_start_calls;
+	int64_t frame_start_nsec;
+};
+
+// 创建模块表并注册 p_funcs 中的函数，替代 luaL_newlib。
+// 构建时启用 LUAGD_BINDING_STATS 时，每个函数被包装为带计数与计时的闭包；
+// 否则与 luaL_newlib 完全等价，没有额外开销。
+// p_module_name: 模块名（如 "native_node"），需为静态字符串。
+// p_funcs: 以 {nullptr, nullptr} 结尾的静态 luaL_Reg 数组。
+// 返回后模块表位于栈顶。
+void lua_binding_new_lib(lua_State *p_L, const char *p_module_name, const luaL_Reg *p_funcs);
+
+// 返回：构建时是否启用了绑定统计。
+bool lua_binding_stats_is_enabled();
+
+// 返回：所有已注册绑定的统计记录（按注册顺序）。未启用时为空。
+const godot::LocalVector<LuaBindingRecord *> &lua_binding_stats_get_records();
+
+// 结束当前帧：把本帧增量写入 frame_calls / frame_nsec。由 LuaHost::tick 在每帧开始时调用。
+void lua_binding_stats_end_frame();
+
+// 清零所有计数。
+void lua_binding_stats_reset();
+
+// 释放所有记录。在 LuaRuntime::shutdown 关闭 state 后调用。
+void lua_binding_stats_cleanup();
+
+} // namespace luagd
+
+#endif // LUAGD_LUA_BINDING_STATS_H
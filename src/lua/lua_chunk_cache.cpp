@@ -0,0 +1,174 @@
+#include "lua_chunk_cache.h"
+
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+
+#include <cstring>
+
+extern "C" {
+#include <lua.h>
+#include <lauxlib.h>
+}
+
+namespace luagd {
+
+// 缓存文件头：magic + 格式版本 + 构建标识 + 源码哈希 + 字节码长度 + 字节码校验和。
+// 格式版本包含 LUA_VERSION_NUM，构建标识由 LUA_RELEASE 与数值类型宽度计算，Lua 升级或配置变化后旧缓存自动失效。
+// Lua 不校验字节码，损坏的 chunk 可能直接导致崩溃，因此加载前必须校验整个负载。
+static const uint32_t CACHE_MAGIC = 0x4344474C; // "LGDC"
+static const uint32_t CACHE_FORMAT_VERSION = (2u << 16) | (uint32_t)LUA_VERSION_NUM;
+static const uint64_t CACHE_HEADER_SIZE = 4 + 4 + 8 + 8 + 8 + 8;
+static const char *DEFAULT_CACHE_DIR = "user://luagd_bytecode";
+
+static bool cache_enabled = false;
+static bool cache_dir_ready = false;
+static godot::String cache_dir = DEFAULT_CACHE_DIR;
+static LuaChunkCacheStats cache_stats;
+
+static godot::String _cache_file_path(const godot::String &p_path) {
+	return cache_dir.path_join(p_path.md5_text() + ".luac");
+}
+
+static uint64_t _build_id() {
+	static uint64_t build_id = 0;
+	if (build_id == 0) {
+		const unsigned char sizes[] = { (unsigned char)sizeof(lua_Integer), (unsigned char)sizeof(lua_Number), (unsigned char)sizeof(void *) };
+		build_id = lua_chunk_cache_hash(LUA_RELEASE, sizeof(LUA_RELEASE) - 1) ^ lua_chunk_cache_hash(reinterpret_cast<const char *>(sizes), sizeof(sizes));
+	}
+	return build_id;
+}
+
+// 缓存文件不可用：删除后由调用方从源码重新编译并覆盖写入。
+static void _discard(godot::Ref<godot::FileAccess> &r_file, const godot::String &p_cache_path) {
+	r_file->close();
+	r_file.unref();
+	godot::DirAccess::remove_absolute(p_cache_path);
+	cache_stats.stale += 1;
+}
+
+// lua_dump 写入回调：追加到 PackedByteArray。
+static int _dump_writer(lua_State *p_L, const void *p_data, size_t p_size, void *p_ud) {
+	if (p_data == nullptr || p_size == 0) {
+		return 0;
+	}
+
+	godot::PackedByteArray *out = static_cast<godot::PackedByteArray *>(p_ud);
+	const int64_t offset = out->size();
+	out->resize(offset + (int64_t)p_size);
+	memcpy(out->ptrw() + offset, p_data, p_size);
+	return 0;
+}
+
+void lua_chunk_cache_configure(bool p_enabled, const godot::String &p_cache_dir) {
+	cache_enabled = p_enabled;
+	cache_dir = p_cache_dir.is_empty() ? godot::String(DEFAULT_CACHE_DIR) : p_cache_dir;
+	cache_dir_ready = false;
+}
+
+bool lua_chunk_cache_is_enabled() {
+	return cache_enabled;
+}
+
+uint64_t lua_chunk_cache_hash(const char *p_data, size_t p_size) {
+	uint64_t hash = 14695981039346656037ull;
+	const unsigned char *bytes = reinterpret_cast<const unsigned char *>(p_data);
+	for (size_t i = 0; i < p_size; i++) {
+		hash ^= (uint64_t)bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+bool lua_chunk_cache_try_load(lua_State *p_L, const godot::String &p_path, uint64_t p_source_hash, const char *p_chunk_name) {
+	if (!cache_enabled) {
+		return false;
+	}
+
+	const godot::String cache_path = _cache_file_path(p_path);
+	godot::Ref<godot::FileAccess> file = godot::FileAccess::open(cache_path, godot::FileAccess::READ);
+	if (!file.is_valid()) {
+		cache_stats.misses += 1;
+		return false;
+	}
+
+	if (file->get_length() < CACHE_HEADER_SIZE) {
+		_discard(file, cache_path);
+		return false;
+	}
+
+	const uint32_t magic = file->get_32();
+	const uint32_t version = file->get_32();
+	const uint64_t build_id = file->get_64();
+	const uint64_t source_hash = file->get_64();
+	const uint64_t payload_size = file->get_64();
+	const uint64_t payload_checksum = file->get_64();
+	if (magic != CACHE_MAGIC || version != CACHE_FORMAT_VERSION || build_id != _build_id() || source_hash != p_source_hash ||
+			payload_size == 0 || payload_size != file->get_length() - CACHE_HEADER_SIZE) {
+		_discard(file, cache_path);
+		return false;
+	}
+
+	const godot::PackedByteArray payload = file->get_buffer((int64_t)payload_size);
+	const char *payload_data = reinterpret_cast<const char *>(payload.ptr());
+	if ((uint64_t)payload.size() != payload_size || lua_chunk_cache_hash(payload_data, (size_t)payload_size) != payload_checksum) {
+		_discard(file, cache_path);
+		return false;
+	}
+	file->close();
+
+	// 只接受二进制 chunk，避免缓存文件被当作源码执行
+	const int load_result = luaL_loadbufferx(p_L, payload_data, (size_t)payload_size, p_chunk_name, "b");
+	if (load_result != LUA_OK) {
+		lua_pop(p_L, 1);
+		godot::DirAccess::remove_absolute(cache_path);
+		cache_stats.stale += 1;
+		return false;
+	}
+
+	cache_stats.hits += 1;
+	return true;
+}
+
+void lua_chunk_cache_store(lua_State *p_L, const godot::String &p_path, uint64_t p_source_hash) {
+	if (!cache_enabled || !lua_isfunction(p_L, -1)) {
+		return;
+	}
+
+	// 保留调试信息（strip = 0），运行时错误仍能报告源码行号
+	godot::PackedByteArray payload;
+	if (lua_dump(p_L, _dump_writer, &payload, 0) != 0 || payload.is_empty()) {
+		return;
+	}
+
+	if (!cache_dir_ready) {
+		godot::DirAccess::make_dir_recursive_absolute(cache_dir);
+		cache_dir_ready = true;
+	}
+
+	godot::Ref<godot::FileAccess> file = godot::FileAccess::open(_cache_file_path(p_path), godot::FileAccess::WRITE);
+	if (!file.is_valid()) {
+		return;
+	}
+
+	file->store_32(CACHE_MAGIC);
+	file->store_32(CACHE_FORMAT_VERSION);
+	file->store_64(_build_id());
+	file->store_64(p_source_hash);
+	file->store_64((uint64_t)payload.size());
+	file->store_64(lua_chunk_cache_hash(reinterpret_cast<const char *>(payload.ptr()), (size_t)payload.size()));
+	file->store_buffer(payload);
+	file->close();
+
+	cache_stats.writes += 1;
+}
+
+LuaChunkCacheStats lua_chunk_cache_get_stats() {
+	return cache_stats;
+}
+
+void lua_chunk_cache_reset_stats() {
+	cache_stats = LuaChunkCacheStats();
+}
+
+} // namespace luagd
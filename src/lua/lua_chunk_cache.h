@@ -0,0 +1,59 @@
+#ifndef LUAGD_LUA_CHUNK_CACHE_H
+#define LUAGD_LUA_CHUNK_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <godot_cpp/variant/string.hpp>
+
+struct lua_State;
+
+namespace luagd {
+
+// 字节码缓存统计。
+struct LuaChunkCacheStats {
+	int64_t hits;
+	int64_t misses;
+	int64_t stale;
+	int64_t writes;
+
+	LuaChunkCacheStats() :
+			hits(0),
+			misses(0),
+			stale(0),
+			writes(0) {}
+};
+
+// 配置字节码缓存。
+// p_enabled: 是否启用缓存。
+// p_cache_dir: 缓存目录，支持 user:// 与 res://（res:// 在导出包内只读，仅用于读取随包发布的缓存）。
+// 约束：只允许在主线程调用。
+void lua_chunk_cache_configure(bool p_enabled, const godot::String &p_cache_dir);
+
+// 返回：缓存是否启用。
+bool lua_chunk_cache_is_enabled();
+
+// 计算源码内容哈希（FNV-1a 64 位），用作缓存失效键。
+uint64_t lua_chunk_cache_hash(const char *p_data, size_t p_size);
+
+// 尝试从缓存加载已编译的 chunk。
+// 命中时将函数压入栈顶并返回 true；未命中或缓存过期时栈不变并返回 false。
+// 头部、构建标识或负载校验和不匹配的缓存文件会被删除，由调用方从源码重新编译。
+// p_path: 源文件路径（缓存键）。
+// p_source_hash: 当前源码哈希，不一致时视为过期。
+// p_chunk_name: Lua 错误消息中使用的 chunk 名。
+bool lua_chunk_cache_try_load(lua_State *p_L, const godot::String &p_path, uint64_t p_source_hash, const char *p_chunk_name);
+
+// 将栈顶函数 dump 后写入缓存。栈保持不变。
+// 写入失败（如目录只读）时静默跳过。
+void lua_chunk_cache_store(lua_State *p_L, const godot::String &p_path, uint64_t p_source_hash);
+
+// 返回：当前命中/未命中统计。
+LuaChunkCacheStats lua_chunk_cache_get_stats();
+
+// 重置统计。
+void lua_chunk_cache_reset_stats();
+
+} // namespace luagd
+
+#endif // LUAGD_LUA_CHUNK_CACHE_H
@@ -0,0 +1,132 @@
+#include "lua_float_buffer.h"
+
+#include <cstring>
+
+extern "C" {
+#include <lua.h>
+#include <lauxlib.h>
+}
+
+namespace luagd {
+
+static const char *FLOAT_BUFFER_METATABLE = "luagd.FloatBuffer";
+
+// userdata 布局：头部之后紧跟 size 个 float
+struct LuaFloatBuffer {
+	float *data;
+	uint32_t size;
+};
+
+static LuaFloatBuffer *_check_buffer(lua_State *p_L, int p_index) {
+	return (LuaFloatBuffer *)luaL_checkudata(p_L, p_index, FLOAT_BUFFER_METATABLE);
+}
+
+// buf:size() -> integer
+static int m_size(lua_State *p_L) {
+	lua_pushinteger(p_L, (lua_Integer)_check_buffer(p_L, 1)->size);
+	return 1;
+}
+
+// buf:fill(value) -> buf
+static int m_fill(lua_State *p_L) {
+	LuaFloatBuffer *buffer = _check_buffer(p_L, 1);
+	const float value = (float)luaL_checknumber(p_L, 2);
+	for (uint32_t i = 0; i < buffer->size; i++) {
+		buffer->data[i] = value;
+	}
+	lua_settop(p_L, 1);
+	return 1;
+}
+
+// buf:to_table() -> table
+static int m_to_table(lua_State *p_L) {
+	const LuaFloatBuffer *buffer = _check_buffer(p_L, 1);
+	lua_createtable(p_L, (int)buffer->size, 0);
+	for (uint32_t i = 0; i < buffer->size; i++) {
+		lua_pushnumber(p_L, buffer->data[i]);
+		lua_rawseti(p_L, -2, (lua_Integer)i + 1);
+	}
+	return 1;
+}
+
+// __index：整数键读元素，其余键查方法表（upvalue 1）
+static int m_index(lua_State *p_L) {
+	const LuaFloatBuffer *buffer = (const LuaFloatBuffer *)lua_touserdata(p_L, 1);
+	int is_integer = 0;
+	const lua_Integer index = lua_tointegerx(p_L, 2, &is_integer);
+	if (is_integer) {
+		if (index >= 1 && (lua_Unsigned)index <= buffer->size) {
+			lua_pushnumber(p_L, buffer->data[index - 1]);
+		} else {
+			lua_pushnil(p_L);
+		}
+		return 1;
+	}
+	lua_pushvalue(p_L, 2);
+	lua_rawget(p_L, lua_upvalueindex(1));
+	return 1;
+}
+
+static int m_newindex(lua_State *p_L) {
+	LuaFloatBuffer *buffer = (LuaFloatBuffer *)lua_touserdata(p_L, 1);
+	const lua_Integer index = luaL_checkinteger(p_L, 2);
+	luaL_argcheck(p_L, index >= 1 && (lua_Unsigned)index <= buffer->size, 2, "index out of range");
+	buffer->data[index - 1] = (float)luaL_checknumber(p_L, 3);
+	return 0;
+}
+
+static int m_len(lua_State *p_L) {
+	lua_pushinteger(p_L, (lua_Integer)((const LuaFloatBuffer *)lua_touserdata(p_L, 1))->size);
+	return 1;
+}
+
+static const luaL_Reg float_buffer_methods[] = {
+	{"size", m_size},
+	{"fill", m_fill},
+	{"to_table", m_to_table},
+	{nullptr, nullptr}
+};
+
+// 首次调用时创建元表，返回后元表位于栈顶
+static void _push_metatable(lua_State *p_L) {
+	if (luaL_newmetatable(p_L, FLOAT_BUFFER_METATABLE) == 0) {
+		return;
+	}
+
+	luaL_newlib(p_L, float_buffer_methods);
+	lua_pushcclosure(p_L, m_index, 1);
+	lua_setfield(p_L, -2, "__index");
+	lua_pushcfunction(p_L, m_newindex);
+	lua_setfield(p_L, -2, "__newindex");
+	lua_pushcfunction(p_L, m_len);
+	lua_setfield(p_L, -2, "__len");
+}
+
+float *lua_float_buffer_new(lua_State *p_L, uint32_t p_size) {
+	if (p_size > LUA_FLOAT_BUFFER_MAX_SIZE) {
+		luaL_error(p_L, "float buffer too large (%d elements)", (int)p_size);
+		return nullptr;
+	}
+
+	LuaFloatBuffer *buffer = (LuaFloatBuffer *)lua_newuserdatauv(p_L, sizeof(LuaFloatBuffer) + (size_t)p_size * sizeof(float), 0);
+	buffer->data = (float *)(buffer + 1);
+	buffer->size = p_size;
+	memset(buffer->data, 0, (size_t)p_size * sizeof(float));
+	_push_metatable(p_L);
+	lua_setmetatable(p_L, -2);
+	return buffer->data;
+}
+
+float *lua_float_buffer_test(lua_State *p_L, int p_index, uint32_t *r_size) {
+	if (lua_type(p_L, p_index) != LUA_TUSERDATA) {
+		return nullptr;
+	}
+	LuaFloatBuffer *buffer = (LuaFloatBuffer *)luaL_testudata(p_L, p_index, FLOAT_BUFFER_METATABLE);
+	if (buffer == nullptr) {
+		return nullptr;
+	}
+	*r_size = buffer->size;
+	return buffer->data;
+}
+
+} // namespace luagd
@@ -0,0 +1,28 @@
+#ifndef LUAGD_LUA_FLOAT_BUFFER_H
+#define LUAGD_LUA_FLOAT_BUFFER_H
+
+#include <cstdint>
+
+struct lua_State;
+
+namespace luagd {
+
+// 单个缓冲区允许的最大元素数（256 MB）。
+static const uint32_t LUA_FLOAT_BUFFER_MAX_SIZE = 1u << 26;
+
+// 连续 float 数组 userdata（元表 "luagd.FloatBuffer"），供批量接口在 Lua 与 native 之间传递数据，
+// native 侧直接读写内存，不逐项经过 Lua 表。
+// Lua 侧：buf[i] 读写第 i 个元素（1 起始，越界读返回 nil、越界写报错），#buf 为长度，
+// buf:size()、buf:fill(v)、buf:to_table() 为方法。
+
+// 创建长度为 p_size 的缓冲区（元素初始化为 0）并压入栈顶。
+// 返回：数据指针，与 userdata 同生命周期。
+float *lua_float_buffer_new(lua_State *p_L, uint32_t p_size);
+
+// 检查 p_index 处是否为 float 缓冲区。
+// 返回：是则返回数据指针并写入 r_size，否则返回 nullptr（不报错）。
+float *lua_float_buffer_test(lua_State *p_L, int p_index, uint32_t *r_size);
+
+} // namespace luagd
+
+#endif // LUAGD_LUA_FLOAT_BUFFER_H
@@ -0,0 +1,233 @@
+#include "lua_gc_pacer.h"
+
+#include "../host/host_clock.h"
+#include "../host/host_trace.h"
+
+extern "C" {
+#include <lua.h>
+}
+
+namespace luagd {
+
+// 增量模式：堆增长到上一周期结束时的 2 倍才开始新周期（对应 Lua 默认 pause 200%）。
+static const double INCREMENTAL_PAUSE_RATIO = 2.0;
+// 堆超过上一周期结束时的 4 倍视为回收落后，本帧预算放大以追赶，避免无限增长。
+static const double CATCHUP_RATIO = 4.0;
+static const int64_t CATCHUP_BUDGET_SCALE = 4;
+// 硬上限：堆超过上一周期结束时的 8 倍时不再受预算限制，本帧把当前周期做完。
+// 放大后的预算仍追不上分配速度时（固定增量模式不会自动切换），靠它限制堆增长。
+static const double HARD_CAP_RATIO = 8.0;
+// 分代模式：堆比上次回收后增长 20% 才执行一次 minor 回收（对应 Lua 默认 minor multiplier）。
+static const double GENERATIONAL_MINOR_RATIO = 1.2;
+// AUTO：增量模式连续追赶且未完成周期的帧数达到阈值时切换到分代。
+static const int32_t AUTO_TO_GENERATIONAL_FRAMES = 30;
+// AUTO：分代模式单步耗时超过 2 倍预算（major 回收）的次数达到阈值时切回增量。
+static const int32_t AUTO_TO_INCREMENTAL_PAUSES = 3;
+
+static int64_t budget_usec = 0;
+static LuaGcMode requested_mode = LUA_GC_MODE_AUTO;
+static LuaGcMode active_mode = LUA_GC_MODE_INCREMENTAL;
+static bool cycle_in_progress = false;
+static int64_t cycle_base_bytes = 0;
+static int32_t saturated_frames = 0;
+static int32_t long_pause_count = 0;
+static LuaGcFrameStats frame_stats;
+
+static int64_t _heap_bytes(lua_State *p_L) {
+	return (int64_t)lua_gc(p_L, LUA_GCCOUNT) * 1024 + (int64_t)lua_gc(p_L, LUA_GCCOUNTB);
+}
+
+// 执行一次基本 GC 步进。
+// 返回：增量模式下本步完成了一个完整周期时返回 true。
+static bool _gc_step(lua_State *p_L) {
+#if LUA_VERSION_NUM >= 505
+	return lua_gc(p_L, LUA_GCSTEP, (size_t)0) != 0;
+#else
+	return lua_gc(p_L, LUA_GCSTEP, 0) != 0;
+#endif
+}
+
+// 切换 Lua GC 模式，参数保持 Lua 默认值。
+static void _apply_mode(lua_State *p_L, LuaGcMode p_mode) {
+	if (p_mode == LUA_GC_MODE_GENERATIONAL) {
+#if LUA_VERSION_NUM >= 505
+		lua_gc(p_L, LUA_GCGEN);
+#else
+		lua_gc(p_L, LUA_GCGEN, 0, 0);
+#endif
+	} else {
+#if LUA_VERSION_NUM >= 505
+		lua_gc(p_L, LUA_GCINC);
+#else
+		lua_gc(p_L, LUA_GCINC, 0, 0, 0);
+#endif
+	}
+	active_mode = p_mode;
+	cycle_in_progress = false;
+	cycle_base_bytes = _heap_bytes(p_L);
+	saturated_frames = 0;
+	long_pause_count = 0;
+}
+
+void lua_gc_pacer_set_budget(lua_State *p_L, int64_t p_budget_usec) {
+	if (p_L == nullptr) {
+		return;
+	}
+
+	const bool was_enabled = budget_usec > 0;
+	budget_usec = p_budget_usec > 0 ? p_budget_usec : 0;
+	const bool is_enabled = budget_usec > 0;
+
+	if (is_enabled && !was_enabled) {
+		lua_gc(p_L, LUA_GCSTOP);
+		cycle_in_progress = false;
+		cycle_base_bytes = _heap_bytes(p_L);
+		saturated_frames = 0;
+		long_pause_count = 0;
+	} else if (!is_enabled && was_enabled) {
+		lua_gc(p_L, LUA_GCRESTART);
+	}
+}
+
+int64_t lua_gc_pacer_get_budget() {
+	return budget_usec;
+}
+
+void lua_gc_pacer_set_mode(lua_State *p_L, LuaGcMode p_mode) {
+	if (p_L == nullptr) {
+		return;
+	}
+
+	requested_mode = p_mode;
+	// AUTO 从增量模式开始，由步进耗时决定是否切换
+	const LuaGcMode target_mode = p_mode == LUA_GC_MODE_AUTO ? LUA_GC_MODE_INCREMENTAL : p_mode;
+	if (target_mode != active_mode) {
+		_apply_mode(p_L, target_mode);
+	}
+}
+
+LuaGcMode lua_gc_pacer_get_mode() {
+	return requested_mode;
+}
+
+LuaGcMode lua_gc_pacer_get_active_mode() {
+	return active_mode;
+}
+
+// 增量模式：在预算内连续步进，周期完成即停止。
+static void _step_incremental(lua_State *p_L, int64_t p_heap_before) {
+	if (!cycle_in_progress && (double)p_heap_before < (double)cycle_base_bytes * INCREMENTAL_PAUSE_RATIO) {
+		saturated_frames = 0;
+		return;
+	}
+
+	const bool catching_up = (double)p_heap_before >= (double)cycle_base_bytes * CATCHUP_RATIO;
+	const bool over_cap = (double)p_heap_before >= (double)cycle_base_bytes * HARD_CAP_RATIO;
+	const int64_t frame_budget = catching_up ? budget_usec * CATCHUP_BUDGET_SCALE : budget_usec;
+
+	const uint64_t frame_start = host_clock_usec();
+	while (true) {
+		const uint64_t step_start = host_clock_usec();
+		const bool done = _gc_step(p_L);
+		const uint64_t step_end = host_clock_usec();
+
+		frame_stats.steps += 1;
+		const int64_t step_usec = (int64_t)(step_end - step_start);
+		if (step_usec > frame_stats.max_step_usec) {
+			frame_stats.max_step_usec = step_usec;
+		}
+
+		if (done) {
+			frame_stats.cycle_completed = true;
+			cycle_in_progress = false;
+			break;
+		}
+		cycle_in_progress = true;
+
+		if (!over_cap && (int64_t)(step_end - frame_start) >= frame_budget) {
+			break;
+		}
+	}
+
+	if (frame_stats.cycle_completed) {
+		cycle_base_bytes = _heap_bytes(p_L);
+	}
+
+	// 持续追赶却完不成周期：垃圾产生速度超过增量回收能力，短命临时对象居多，分代模式更合适
+	if (requested_mode == LUA_GC_MODE_AUTO) {
+		saturated_frames = (catching_up && !frame_stats.cycle_completed) ? saturated_frames + 1 : 0;
+		if (saturated_frames >= AUTO_TO_GENERATIONAL_FRAMES) {
+			_apply_mode(p_L, LUA_GC_MODE_GENERATIONAL);
+		}
+	}
+}
+
+// 分代模式：一次步进即一次完整的 minor（必要时 major）回收，无法切片。
+static void _step_generational(lua_State *p_L, int64_t p_heap_before) {
+	if ((double)p_heap_before < (double)cycle_base_bytes * GENERATIONAL_MINOR_RATIO) {
+		return;
+	}
+
+	const uint64_t step_start = host_clock_usec();
+	_gc_step(p_L);
+	const int64_t step_usec = (int64_t)(host_clock_usec() - step_start);
+
+	frame_stats.steps = 1;
+	frame_stats.max_step_usec = step_usec;
+	cycle_base_bytes = _heap_bytes(p_L);
+
+	// major 回收的停顿超出预算过多时，切回可切片的增量模式
+	if (requested_mode == LUA_GC_MODE_AUTO) {
+		if (step_usec > budget_usec * 2) {
+			long_pause_count += 1;
+		} else if (step_usec <= budget_usec && long_pause_count > 0) {
+			long_pause_count -= 1;
+		}
+		if (long_pause_count >= AUTO_TO_INCREMENTAL_PAUSES) {
+			_apply_mode(p_L, LUA_GC_MODE_INCREMENTAL);
+		}
+	}
+}
+
+void lua_gc_pacer_step(lua_State *p_L) {
+	frame_stats.reset();
+	if (p_L == nullptr) {
+		return;
+	}
+
+	const int64_t heap_before = _heap_bytes(p_L);
+	if (budget_usec <= 0) {
+		frame_stats.heap_bytes = heap_before;
+		return;
+	}
+
+	LUAGD_TRACE_ZONE("lua_gc_step");
+	const uint64_t frame_start = host_clock_usec();
+	if (active_mode == LUA_GC_MODE_GENERATIONAL) {
+		_step_generational(p_L, heap_before);
+	} else {
+		_step_incremental(p_L, heap_before);
+	}
+	frame_stats.step_usec = frame_stats.steps > 0 ? (int64_t)(host_clock_usec() - frame_start) : 0;
+
+	const int64_t heap_after = _heap_bytes(p_L);
+	frame_stats.heap_bytes = heap_after;
+	frame_stats.bytes_freed = heap_before > heap_after ? heap_before - heap_after : 0;
+}
+
+const LuaGcFrameStats &lua_gc_pacer_get_frame_stats() {
+	return frame_stats;
+}
+
+void lua_gc_pacer_cleanup() {
+	budget_usec = 0;
+	requested_mode = LUA_GC_MODE_AUTO;
+	active_mode = LUA_GC_MODE_INCREMENTAL;
+	cycle_in_progress = false;
+	cycle_base_bytes = 0;
+	saturated_frames = 0;
+	long_pause_count = 0;
+	frame_stats.reset();
+}
+
+} // namespace luagd
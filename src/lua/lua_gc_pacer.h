@@ -0,0 +1,73 @@
+#ifndef LUAGD_LUA_GC_PACER_H
+#define LUAGD_LUA_GC_PACER_H
+
+#include <cstdint>
+
+struct lua_State;
+
+namespace luagd {
+
+// GC 模式选择。
+enum LuaGcMode {
+	LUA_GC_MODE_AUTO = 0,
+	LUA_GC_MODE_INCREMENTAL = 1,
+	LUA_GC_MODE_GENERATIONAL = 2,
+};
+
+// 最近一帧的 GC 统计。
+struct LuaGcFrameStats {
+	int64_t step_usec;
+	int64_t max_step_usec;
+	int64_t bytes_freed;
+	int64_t heap_bytes;
+	int32_t steps;
+	bool cycle_completed;
+
+	LuaGcFrameStats() {
+		reset();
+	}
+
+	void reset() {
+		step_usec = 0;
+		max_step_usec = 0;
+		bytes_freed = 0;
+		heap_bytes = 0;
+		steps = 0;
+		cycle_completed = false;
+	}
+};
+
+// 设置每帧 GC 时间预算（微秒）。
+// p_budget_usec > 0 时由宿主接管 GC：停止 Lua 自动回收，改为每帧在预算内执行 GC 步进；
+// p_budget_usec <= 0 时恢复 Lua 自动回收。
+// 增量模式下堆超过上一周期结束时的 8 倍时，该帧忽略预算直接完成当前周期，保证堆增长有上限。
+// 约束：只允许在主线程调用。
+void lua_gc_pacer_set_budget(lua_State *p_L, int64_t p_budget_usec);
+
+// 返回：当前每帧预算（微秒），0 表示未接管。
+int64_t lua_gc_pacer_get_budget();
+
+// 设置 GC 模式。AUTO 时根据步进耗时在增量与分代之间切换。
+// 约束：只允许在主线程调用。
+void lua_gc_pacer_set_mode(lua_State *p_L, LuaGcMode p_mode);
+
+// 返回：用户设置的模式。
+LuaGcMode lua_gc_pacer_get_mode();
+
+// 返回：当前实际使用的模式（INCREMENTAL 或 GENERATIONAL）。
+LuaGcMode lua_gc_pacer_get_active_mode();
+
+// 在帧预算内执行 GC 步进。由 LuaHost::tick 在 update 回调之后调用。
+// 未接管时只刷新堆大小统计。
+// 约束：只允许在主线程调用。
+void lua_gc_pacer_step(lua_State *p_L);
+
+// 返回：最近一帧的 GC 统计。
+const LuaGcFrameStats &lua_gc_pacer_get_frame_stats();
+
+// 重置配置与统计。在 LuaRuntime::shutdown 时调用。
+void lua_gc_pacer_cleanup();
+
+} // namespace luagd
+
+#endif // LUAGD_LUA_GC_PACER_H
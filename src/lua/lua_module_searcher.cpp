@@ -0,0 +1,179 @@
+#include "lua_module_searcher.h"
+#include "lua_runtime.h"
+
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+extern "C" {
+#include <lua.h>
+#include <lauxlib.h>
+}
+
+namespace luagd {
+
+static const char *DEFAULT_MODULE_ROOT = "res://";
+static const char *MODULE_EXTENSION = "lua";
+static const char *PACKAGE_INIT_NAME = "init";
+
+// 模块名（如 "game.player"）-> 文件路径（如 "res://game/player.lua"）。
+// 在 install（LuaRuntime::initialize）与 set_roots 时同步扫描建立，之后命中与未命中都只是一次哈希查找。
+static godot::HashMap<godot::String, godot::String> module_index;
+static godot::PackedStringArray module_roots;
+static bool index_built = false;
+static bool roots_configured = false;
+
+static void _index_module(const godot::String &p_name, const godot::String &p_path) {
+	// 先扫描到的优先：靠前的根目录、同目录下 "a/b.lua" 优先于 "a/b/init.lua"
+	if (!module_index.has(p_name)) {
+		module_index[p_name] = p_path;
+	}
+}
+
+static void _scan_dir(const godot::String &p_dir, const godot::String &p_prefix) {
+	// 先登记当前目录的文件，再递归子目录，保证 "a/b.lua" 先于 "a/b/init.lua" 登记
+	const godot::PackedStringArray files = godot::DirAccess::get_files_at(p_dir);
+	for (int64_t i = 0; i < files.size(); i++) {
+		const godot::String &file_name = files[i];
+		if (file_name.get_extension() != MODULE_EXTENSION) {
+			continue;
+		}
+
+		const godot::String base_name = file_name.get_basename();
+		const godot::String file_path = p_dir.path_join(file_name);
+		if (base_name == PACKAGE_INIT_NAME && !p_prefix.is_empty()) {
+			_index_module(p_prefix, file_path);
+			continue;
+		}
+		_index_module(p_prefix.is_empty() ? base_name : p_prefix + "." + base_name, file_path);
+	}
+
+	const godot::PackedStringArray dirs = godot::DirAccess::get_directories_at(p_dir);
+	for (int64_t i = 0; i < dirs.size(); i++) {
+		const godot::String &dir_name = dirs[i];
+		// 跳过隐藏目录（如 .godot 导入缓存）
+		if (dir_name.begins_with(".")) {
+			continue;
+		}
+		_scan_dir(p_dir.path_join(dir_name), p_prefix.is_empty() ? dir_name : p_prefix + "." + dir_name);
+	}
+}
+
+static void _build_index() {
+	module_index.clear();
+	for (int64_t i = 0; i < module_roots.size(); i++) {
+		_scan_dir(module_roots[i], "");
+	}
+	index_built = true;
+}
+
+// 未调用 set_roots 时使用固定的默认根目录 res://
+static void _ensure_roots() {
+	if (!roots_configured) {
+		module_roots.clear();
+		module_roots.push_back(DEFAULT_MODULE_ROOT);
+		roots_configured = true;
+	}
+}
+
+static void _ensure_index() {
+	if (index_built) {
+		return;
+	}
+	_ensure_roots();
+	_build_index();
+}
+
+// 查找并编译模块。成功时压入 loader 与文件路径并返回 true；
+// 未找到时压入说明并返回 true；编译失败时压入错误消息并返回 false。
+// C++ 局部对象都在本函数内析构，调用方可以安全地 lua_error（longjmp 不会跳过析构）。
+static bool _find_module(lua_State *p_L, const char *p_name, int *r_results) {
+	_ensure_index();
+
+	const godot::String *path = module_index.getptr(godot::String::utf8(p_name));
+	if (path == nullptr) {
+		lua_pushfstring(p_L, "no module '%s' in native roots", p_name);
+		*r_results = 1;
+		return true;
+	}
+
+	const godot::CharString utf8_path = path->utf8();
+	const int load_result = LuaRuntime::load_file(p_L, *path);
+	if (load_result != LUA_OK) {
+		lua_pushfstring(p_L, "error loading module '%s' from file '%s':\n\t%s",
+				p_name, utf8_path.get_data(), lua_tostring(p_L, -1));
+		return false;
+	}
+
+	lua_pushstring(p_L, utf8_path.get_data());
+	*r_results = 2;
+	return true;
+}
+
+// package.searchers 条目：searcher(name) -> loader, path | message
+// loader 即编译好的 chunk，require 会以 (name, path) 调用它。
+static int _search_module(lua_State *p_L) {
+	const char *name = luaL_checkstring(p_L, 1);
+	int results = 0;
+	if (!_find_module(p_L, name, &results)) {
+		return lua_error(p_L);
+	}
+	return results;
+}
+
+void lua_module_searcher_install(lua_State *p_L) {
+	lua_getglobal(p_L, "package");
+	if (!lua_istable(p_L, -1)) {
+		lua_pop(p_L, 1);
+		return;
+	}
+
+	lua_getfield(p_L, -1, "searchers");
+	if (!lua_istable(p_L, -1)) {
+		lua_pop(p_L, 2);
+		return;
+	}
+
+	// 在 preload searcher（索引 1）之后插入，原有 searcher 依次后移
+	const lua_Integer count = (lua_Integer)lua_rawlen(p_L, -1);
+	for (lua_Integer i = count; i >= 2; i--) {
+		lua_rawgeti(p_L, -1, i);
+		lua_rawseti(p_L, -2, i + 1);
+	}
+	lua_pushcfunction(p_L, _search_module);
+	lua_rawseti(p_L, -2, 2);
+
+	lua_pop(p_L, 2);
+
+	// 在初始化阶段建立索引，扫描耗时不落在游戏中第一次 require 上
+	_ensure_index();
+}
+
+void lua_module_searcher_set_roots(const godot::PackedStringArray &p_roots) {
+	module_roots = p_roots;
+	roots_configured = true;
+	_build_index();
+}
+
+godot::PackedStringArray lua_module_searcher_get_roots() {
+	if (!roots_configured) {
+		godot::PackedStringArray roots;
+		roots.push_back(DEFAULT_MODULE_ROOT);
+		return roots;
+	}
+	return module_roots;
+}
+
+void lua_module_searcher_rebuild_index() {
+	_ensure_roots();
+	_build_index();
+}
+
+void lua_module_searcher_cleanup() {
+	module_index.clear();
+	module_roots.clear();
+	index_built = false;
+	roots_configured = false;
+}
+
+} // namespace luagd
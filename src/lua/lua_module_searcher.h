@@ -0,0 +1,33 @@
+#ifndef LUAGD_LUA_MODULE_SEARCHER_H
+#define LUAGD_LUA_MODULE_SEARCHER_H
+
+#include <godot_cpp/variant/packed_string_array.hpp>
+
+struct lua_State;
+
+namespace luagd {
+
+// 将原生 searcher 插入 package.searchers（位于 preload searcher 之后），并按当前根目录建立模块索引。
+// 模块名通过 Godot FileAccess 在配置的根目录下解析，可访问导出 .pck 内的 res:// 文件。
+// 未调用 set_roots 时根目录固定为 "res://"：索引在此处递归扫描整个项目，耗时与文件数成正比。
+// 约束：必须在 luaL_openlibs 之后调用。
+void lua_module_searcher_install(lua_State *p_L);
+
+// 设置模块根目录（如 "res://scripts"），并立即同步扫描重建索引。
+// 已加载的模块（package.loaded）不受影响，应在加载任何模块之前设置。
+// 约束：只允许在主线程调用。
+void lua_module_searcher_set_roots(const godot::PackedStringArray &p_roots);
+
+// 返回：当前模块根目录。
+godot::PackedStringArray lua_module_searcher_get_roots();
+
+// 重新扫描根目录建立模块索引。
+// 用于运行期间新增脚本文件后刷新。
+void lua_module_searcher_rebuild_index();
+
+// 清理索引与根目录配置。在 LuaRuntime::shutdown 时调用。
+void lua_module_searcher_cleanup();
+
+} // namespace luagd
+
+#endif // LUAGD_LUA_MODULE_SEARCHER_H
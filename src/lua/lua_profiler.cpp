@@ -0,0 +1,255 @@
+#include "lua_profiler.h"
+
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+
+#include <cstring>
+
+extern "C" {
+#include <lua.h>
+#include <lauxlib.h>
+}
+
+namespace luagd {
+
+// 单次采样记录的最大栈深度，超出部分（靠近根的帧）被截断
+static const int MAX_STACK_DEPTH = 64;
+// 不同调用栈的数量上限，超出后样本计入 dropped_samples
+static const int64_t MAX_UNIQUE_STACKS = 1 << 16;
+
+// 一个不同的调用栈：frames 在 stack_frames 中的区间（叶子在前），哈希冲突时沿 next 链查找
+struct StackSample {
+	uint32_t offset;
+	uint32_t depth;
+	int64_t hits;
+	int32_t next;
+};
+
+static bool running = false;
+static int sample_interval = LUA_PROFILER_DEFAULT_INTERVAL;
+static int64_t sample_count = 0;
+static int64_t dropped_samples = 0;
+
+// 帧按函数原型区分：Lua 函数以 (short_src, linedefined) 为键，C 函数以函数指针为键。
+// 同一原型每次调用生成的闭包共用一个帧，不需要保活闭包，采样不改变 GC 行为。
+struct ProfilerFrame {
+	char source[LUA_IDSIZE];
+	lua_CFunction cfunction;
+	int line_defined;
+	int32_t next;
+};
+
+// 帧键哈希 -> frames 中的链表头；frames 与 frame_names 下标即帧 ID
+static godot::HashMap<uint64_t, int32_t> frame_heads;
+static godot::LocalVector<ProfilerFrame> frames;
+static godot::LocalVector<godot::String> frame_names;
+
+// 栈哈希 -> stacks 中的链表头
+static godot::HashMap<uint64_t, int32_t> stack_heads;
+static godot::LocalVector<StackSample> stacks;
+static godot::LocalVector<uint32_t> stack_frames;
+
+static godot::String _describe_frame(lua_Debug *p_ar) {
+	godot::String name;
+	if (p_ar->name != nullptr) {
+		name = godot::String::utf8(p_ar->name);
+	} else if (p_ar->what != nullptr && p_ar->what[0] == 'm') {
+		name = "main chunk";
+	} else {
+		name = "?";
+	}
+
+	godot::String frame;
+	if (p_ar->what != nullptr && p_ar->what[0] == 'C') {
+		frame = name + " [C]";
+	} else {
+		frame = name + " (" + godot::String::utf8(p_ar->short_src) + ":" + godot::String::num_int64(p_ar->linedefined) + ")";
+	}
+	// ';' 是 collapsed stack 的帧分隔符
+	return frame.replace(";", ",");
+}
+
+static uint64_t _hash_frame_key(const char *p_source, int p_line_defined, lua_CFunction p_cfunction) {
+	uint64_t hash = 14695981039346656037ULL;
+	for (const char *c = p_source; *c != '\0'; c++) {
+		hash ^= (unsigned char)*c;
+		hash *= 1099511628211ULL;
+	}
+	hash ^= (uint64_t)(uint32_t)p_line_defined;
+	hash *= 1099511628211ULL;
+	hash ^= (uint64_t)reinterpret_cast<uintptr_t>(p_cfunction);
+	hash *= 1099511628211ULL;
+	return hash;
+}
+
+static uint32_t _frame_id(lua_State *p_L, lua_Debug *p_ar) {
+	lua_getinfo(p_L, "S", p_ar);
+
+	// C 函数没有源码位置，取函数指针区分（代码地址不会被回收复用）
+	lua_CFunction cfunction = nullptr;
+	const char *source = p_ar->short_src;
+	if (p_ar->what != nullptr && p_ar->what[0] == 'C') {
+		lua_getinfo(p_L, "f", p_ar);
+		cfunction = lua_tocfunction(p_L, -1);
+		lua_pop(p_L, 1);
+		source = "";
+	}
+
+	const uint64_t hash = _hash_frame_key(source, p_ar->linedefined, cfunction);
+	int32_t *head = frame_heads.getptr(hash);
+	for (int32_t index = head != nullptr ? *head : -1; index >= 0; index = frames[index].next) {
+		const ProfilerFrame &frame = frames[index];
+		if (frame.cfunction == cfunction && frame.line_defined == p_ar->linedefined && strcmp(frame.source, source) == 0) {
+			return (uint32_t)index;
+		}
+	}
+
+	// 首次出现的原型：解析名称
+	lua_getinfo(p_L, "n", p_ar);
+	ProfilerFrame frame;
+	strncpy(frame.source, source, LUA_IDSIZE - 1);
+	frame.source[LUA_IDSIZE - 1] = '\0';
+	frame.cfunction = cfunction;
+	frame.line_defined = p_ar->linedefined;
+	frame.next = head != nullptr ? *head : -1;
+
+	const uint32_t id = frames.size();
+	frame_heads[hash] = (int32_t)id;
+	frames.push_back(frame);
+	frame_names.push_back(_describe_frame(p_ar));
+	return id;
+}
+
+static uint64_t _hash_stack(const uint32_t *p_frames, int p_depth) {
+	uint64_t hash = 14695981039346656037ULL;
+	for (int i = 0; i < p_depth; i++) {
+		hash ^= p_frames[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+static bool _stack_equals(const StackSample &p_stack, const uint32_t *p_frames, int p_depth) {
+	if (p_stack.depth != (uint32_t)p_depth) {
+		return false;
+	}
+	for (int i = 0; i < p_depth; i++) {
+		if (stack_frames[p_stack.offset + i] != p_frames[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void _record_stack(const uint32_t *p_frames, int p_depth) {
+	const uint64_t hash = _hash_stack(p_frames, p_depth);
+
+	int32_t *head = stack_heads.getptr(hash);
+	for (int32_t index = head != nullptr ? *head : -1; index >= 0; index = stacks[index].next) {
+		if (_stack_equals(stacks[index], p_frames, p_depth)) {
+			stacks[index].hits += 1;
+			return;
+		}
+	}
+
+	if ((int64_t)stacks.size() >= MAX_UNIQUE_STACKS) {
+		dropped_samples += 1;
+		return;
+	}
+
+	StackSample stack;
+	stack.offset = stack_frames.size();
+	stack.depth = (uint32_t)p_depth;
+	stack.hits = 1;
+	stack.next = head != nullptr ? *head : -1;
+	for (int i = 0; i < p_depth; i++) {
+		stack_frames.push_back(p_frames[i]);
+	}
+	stack_heads[hash] = (int32_t)stacks.size();
+	stacks.push_back(stack);
+}
+
+static void _sample_hook(lua_State *p_L, lua_Debug *p_ar) {
+	if (!running || p_ar->event != LUA_HOOKCOUNT) {
+		return;
+	}
+
+	uint32_t frame_ids[MAX_STACK_DEPTH];
+	int depth = 0;
+	lua_Debug frame;
+	for (int level = 0; depth < MAX_STACK_DEPTH && lua_getstack(p_L, level, &frame); level++) {
+		frame_ids[depth++] = _frame_id(p_L, &frame);
+	}
+	if (depth == 0) {
+		return;
+	}
+
+	sample_count += 1;
+	_record_stack(frame_ids, depth);
+}
+
+void lua_profiler_start(lua_State *p_L, int p_interval) {
+	if (p_L == nullptr) {
+		return;
+	}
+
+	sample_interval = p_interval > 0 ? p_interval : LUA_PROFILER_DEFAULT_INTERVAL;
+	lua_sethook(p_L, _sample_hook, LUA_MASKCOUNT, sample_interval);
+	running = true;
+}
+
+void lua_profiler_stop(lua_State *p_L) {
+	if (p_L != nullptr && running) {
+		lua_sethook(p_L, nullptr, 0, 0);
+	}
+	running = false;
+}
+
+bool lua_profiler_is_running() {
+	return running;
+}
+
+godot::String lua_profiler_dump() {
+	godot::String result;
+	for (uint32_t i = 0; i < stacks.size(); i++) {
+		const StackSample &stack = stacks[i];
+
+		// 采样时叶子在前，collapsed 格式要求根在前
+		godot::String line;
+		for (uint32_t depth = stack.depth; depth > 0; depth--) {
+			if (depth != stack.depth) {
+				line += ";";
+			}
+			line += frame_names[stack_frames[stack.offset + depth - 1]];
+		}
+		result += line + " " + godot::String::num_int64(stack.hits) + "\n";
+	}
+
+	if (dropped_samples > 0) {
+		result += godot::String("(dropped) ") + godot::String::num_int64(dropped_samples) + "\n";
+	}
+	return result;
+}
+
+int64_t lua_profiler_get_sample_count() {
+	return sample_count;
+}
+
+void lua_profiler_reset() {
+	frame_heads.clear();
+	frames.clear();
+	frame_names.clear();
+	stack_heads.clear();
+	stacks.clear();
+	stack_frames.clear();
+	sample_count = 0;
+	dropped_samples = 0;
+}
+
+void lua_profiler_cleanup() {
+	running = false;
+	sample_interval = LUA_PROFILER_DEFAULT_INTERVAL;
+	lua_profiler_reset();
+}
+
+} // namespace luagd
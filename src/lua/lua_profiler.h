@@ -0,0 +1,46 @@
+#ifndef LUAGD_LUA_PROFILER_H
+#define LUAGD_LUA_PROFILER_H
+
+#include <cstdint>
+
+#include <godot_cpp/variant/string.hpp>
+
+struct lua_State;
+
+namespace luagd {
+
+// 默认采样间隔：每执行 1000 条 Lua 指令采样一次调用栈。
+static const int LUA_PROFILER_DEFAULT_INTERVAL = 1000;
+
+// 开始采样。基于 lua_sethook 的 count hook，每 p_interval 条指令记录一次当前 Lua 调用栈。
+// 之后由 p_L 创建的协程继承 hook；已存在的协程不会被采样。
+// 重复调用只更新采样间隔，已有样本保留。
+// p_interval: 采样间隔（指令数），<= 0 时使用默认值。
+// 约束：只允许在主线程调用。
+void lua_profiler_start(lua_State *p_L, int p_interval);
+
+// 停止采样并移除 hook，已有样本保留到 reset 或下一次 dump 之后。
+// 约束：只允许在主线程调用。
+void lua_profiler_stop(lua_State *p_L);
+
+// 返回：是否正在采样。
+bool lua_profiler_is_running();
+
+// 导出 collapsed stack 文本（flamegraph.pl / speedscope 可直接读取）。
+// 每行格式："root;caller;callee <hits>"，帧名为 "name (source:line)"。
+// 帧按函数原型（源码位置）合并，同一函数的不同闭包计入同一帧；名称取该原型首次被采到时的调用名。
+godot::String lua_profiler_dump();
+
+// 返回：累计样本数。
+int64_t lua_profiler_get_sample_count();
+
+// 清空样本与帧表。
+// 约束：只允许在主线程调用。
+void lua_profiler_reset();
+
+// 重置全部状态。在 LuaRuntime::shutdown 关闭 state 后调用。
+void lua_profiler_cleanup();
+
+} // namespace luagd
+
+#endif // LUAGD_LUA_PROFILER_H
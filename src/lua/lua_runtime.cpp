@@ -1,27 +1,82 @@
 #include "lua_runtime.h"
+#include "lua_alloc_profiler.h"
+#include "lua_allocator.h"
+#include "lua_binding_stats.h"
+#include "lua_chunk_cache.h"
+#include "lua_gc_pacer.h"
+#include "lua_module_searcher.h"
+#include "lua_profiler.h"
 #include "lua_signal_binding.h"
+#include "lua_worker_pool.h"
 
 #include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 
-#include "../modules/display_module.h"
+#include <cstring>
+
+#include "../host/host_error_sink.h"
+#include "../host/host_interpolation.h"
+#include "../host/host_memory_stats.h"
+#include "../host/host_trace.h"
 #include "../modules/core_module.h"
 #include "../modules/input_module.h"
+#include "../modules/math_module.h"
+#include "../modules/node_module.h"
+#if LUAGD_MODULE_DISPLAY
+#include "../modules/display_module.h"
+#endif
+#if LUAGD_MODULE_SYSTEM
 #include "../modules/system_module.h"
+#endif
+#if LUAGD_MODULE_AUDIO
 #include "../modules/audio_module.h"
+#endif
+#if LUAGD_MODULE_ANIM
 #include "../modules/anim_module.h"
+#endif
+#if LUAGD_MODULE_PARTICLES
 #include "../modules/particles_module.h"
-#include "../modules/node_module.h"
+#endif
+#if LUAGD_MODULE_TRANSFORM
 #include "../modules/transform_module.h"
+#endif
+#if LUAGD_MODULE_PHYSICS
 #include "../modules/physics_module.h"
+#endif
+#if LUAGD_MODULE_COLLISION
 #include "../modules/collision_module.h"
+#endif
+#if LUAGD_MODULE_CAMERA
 #include "../modules/camera_module.h"
+#endif
+#if LUAGD_MODULE_MATERIAL
 #include "../modules/material_module.h"
+#endif
+#if LUAGD_MODULE_RES
 #include "../modules/res_module.h"
+#endif
+#if LUAGD_MODULE_DEBUG_DRAW
 #include "../modules/debug_draw_module.h"
+#endif
+#if LUAGD_MODULE_SKELETON
 #include "../modules/skeleton_module.h"
+#endif
+#if LUAGD_MODULE_AI
 #include "../modules/ai_module.h"
+#endif
+#if LUAGD_MODULE_UI
 #include "../modules/ui_module.h"
+#endif
+#if LUAGD_MODULE_DEBUG
+#include "../modules/debug_module.h"
+#endif
+#if LUAGD_MODULE_WORKER
+#include "../modules/worker_module.h"
+#endif
+#if LUAGD_MODULE_TIMER
+#include "../modules/timer_module.h"
+#endif
 
 extern "C" {
 #include <lua.h>
@@ -33,12 +88,151 @@ namespace luagd {
 
 lua_State *LuaRuntime::state = nullptr;
 
+#if LUAGD_POOLED_ALLOCATOR
+static LuaPoolAllocator pool_allocator;
+
+// 未受保护调用中的错误：打印后交由 Lua 终止进程（与 luaL_newstate 的默认行为一致）
+static int _panic(lua_State *p_L) {
+	const char *err = lua_tostring(p_L, -1);
+	godot::String err_msg = "LuaRuntime: unprotected error in call to Lua API: ";
+	err_msg += err ? err : "(error object is not a string)";
+	godot::UtilityFunctions::printerr(err_msg);
+	return 0;
+}
+
+// warn() 输出：与 luaL_newstate 安装的默认 warn 函数一致，初始关闭，"@on" / "@off" 切换，
+// 分段消息（tocont）拼接成整条后输出
+static bool warn_enabled = false;
+static bool warn_continuing = false;
+static godot::String warn_pending;
+
+static void _warn(void *p_ud, const char *p_message, int p_tocont) {
+	(void)p_ud;
+	if (!warn_continuing && !p_tocont && p_message[0] == '@') {
+		if (strcmp(p_message, "@on") == 0) {
+			warn_enabled = true;
+		} else if (strcmp(p_message, "@off") == 0) {
+			warn_enabled = false;
+		}
+		return;
+	}
+
+	if (warn_enabled) {
+		warn_pending += godot::String::utf8(p_message);
+	}
+	warn_continuing = p_tocont != 0;
+	if (!warn_continuing) {
+		if (warn_enabled) {
+			godot::UtilityFunctions::printerr("Lua warning: " + warn_pending);
+		}
+		warn_pending = godot::String();
+	}
+}
+
+static lua_State *_new_state() {
+#if LUA_VERSION_NUM >= 505
+	lua_State *L = lua_newstate(LuaPoolAllocator::lua_alloc, &pool_allocator, luaL_makeseed(nullptr));
+#else
+	lua_State *L = lua_newstate(LuaPoolAllocator::lua_alloc, &pool_allocator);
+#endif
+	if (L != nullptr) {
+		lua_atpanic(L, _panic);
+		warn_enabled = false;
+		warn_continuing = false;
+		warn_pending = godot::String();
+		lua_setwarnf(L, _warn, nullptr);
+	}
+	return L;
+}
+#else
+static lua_State *_new_state() {
+	return luaL_newstate();
+}
+#endif
+
+// native_* 模块入口。未编译进来的模块（LUAGD_MODULE_* 关闭）不登记，require 时报告找不到模块。
+struct NativeModule {
+	const char *name;
+	lua_CFunction opener;
+};
+
+static const NativeModule native_modules[] = {
+	{"native_core", luaopen_native_core},
+#if LUAGD_MODULE_DISPLAY
+	{"native_display", luaopen_native_display},
+#endif
+	{"native_input", luaopen_native_input},
+#if LUAGD_MODULE_SYSTEM
+	{"native_system", luaopen_native_system},
+#endif
+#if LUAGD_MODULE_AUDIO
+	{"native_audio", luaopen_native_audio},
+#endif
+#if LUAGD_MODULE_ANIM
+	{"native_anim", luaopen_native_anim},
+#endif
+#if LUAGD_MODULE_PARTICLES
+	{"native_particles", luaopen_native_particles},
+#endif
+	{"native_node", luaopen_native_node},
+	{"native_math", luaopen_native_math},
+#if LUAGD_MODULE_TRANSFORM
+	{"native_transform", luaopen_native_transform},
+#endif
+#if LUAGD_MODULE_PHYSICS
+	{"native_physics", luaopen_native_physics},
+#endif
+#if LUAGD_MODULE_COLLISION
+	{"native_collision", luaopen_native_collision},
+#endif
+#if LUAGD_MODULE_CAMERA
+	{"native_camera", luaopen_native_camera},
+#endif
+#if LUAGD_MODULE_MATERIAL
+	{"native_material", luaopen_native_material},
+#endif
+#if LUAGD_MODULE_RES
+	{"native_res", luaopen_native_res},
+#endif
+#if LUAGD_MODULE_DEBUG_DRAW
+	{"native_debug_draw", luaopen_native_debug_draw},
+#endif
+#if LUAGD_MODULE_SKELETON
+	{"native_skeleton", luaopen_native_skeleton},
+#endif
+#if LUAGD_MODULE_AI
+	{"native_ai", luaopen_native_ai},
+#endif
+#if LUAGD_MODULE_UI
+	{"native_ui", luaopen_native_ui},
+#endif
+#if LUAGD_MODULE_DEBUG
+	{"native_debug", luaopen_native_debug},
+#endif
+#if LUAGD_MODULE_WORKER
+	{"native_worker", luaopen_native_worker},
+#endif
+#if LUAGD_MODULE_TIMER
+	{"native_timer", luaopen_native_timer},
+#endif
+	{nullptr, nullptr}
+};
+
+static void _register_native_modules(lua_State *p_L) {
+	luaL_getsubtable(p_L, LUA_REGISTRYINDEX, LUA_PRELOAD_TABLE);
+	for (const NativeModule *module = native_modules; module->name != nullptr; module++) {
+		lua_pushcfunction(p_L, module->opener);
+		lua_setfield(p_L, -2, module->name);
+	}
+	lua_pop(p_L, 1);
+}
+
 bool LuaRuntime::initialize() {
 	if (state != nullptr) {
 		return true;
 	}
 
-	state = luaL_newstate();
+	state = _new_state();
 	if (state == nullptr) {
 		godot::UtilityFunctions::printerr("LuaRuntime: failed to create Lua state");
 		return false;
@@ -46,94 +240,62 @@ bool LuaRuntime::initialize() {
 
 	luaL_openlibs(state);
 
-	// 注册 native_core 模块
-	luaL_requiref(state, "native_core", luaopen_native_core, 0);
-	lua_pop(state, 1);
-
-	// 注册 native_display 模块
-	luaL_requiref(state, "native_display", luaopen_native_display, 0);
-	lua_pop(state, 1);
-
-	// 注册 native_input 模块
-	luaL_requiref(state, "native_input", luaopen_native_input, 0);
-	lua_pop(state, 1);
-
-	// 注册 native_system 模块
-	luaL_requiref(state, "native_system", luaopen_native_system, 0);
-	lua_pop(state, 1);
-
-	// 注册 native_audio 模块
-	luaL_requiref(state, "native_audio", luaopen_native_audio, 0);
-	lua_pop(state, 1);
-
-	// 注册 native_anim 模块
-	luaL_requiref(state, "native_anim", luaopen_native_anim, 0);
-	lua_pop(state, 1);
-
-	// 注册 native_particles 模块
-	luaL_requiref(state, "native_particles", luaopen_native_particles, 0);
-	lua_pop(state, 1);
-
-	// 注册 native_node 模块
-	luaL_requiref(state, "native_node", luaopen_native_node, 0);
-	lua_pop(state, 1);
-
-	// 注册 native_transform 模块
-	luaL_requiref(state, "native_transform", luaopen_native_transform, 0);
-	lua_pop(state, 1);
-
-	// 注册 native_physics 模块
-	luaL_requiref(state, "native_physics", luaopen_native_physics, 0);
-	lua_pop(state, 1);
-
-	// 注册 native_collision 模块
-	luaL_requiref(state, "native_collision", luaopen_native_collision, 0);
-	lua_pop(state, 1);
-
-	// 注册 native_camera 模块
-	luaL_requiref(state, "native_camera", luaopen_native_camera, 0);
-	lua_pop(state, 1);
-
-	// 注册 native_material 模块
-	luaL_requiref(state, "native_material", luaopen_native_material, 0);
-	lua_pop(state, 1);
+	// 安装基于 FileAccess 的 require searcher（支持导出包内的 res://）
+	lua_module_searcher_install(state);
 
-	// 注册 native_res 模块
-	luaL_requiref(state, "native_res", luaopen_native_res, 0);
-	lua_pop(state, 1);
-
-	// 注册 native_debug_draw 模块
-	luaL_requiref(state, "native_debug_draw", luaopen_native_debug_draw, 0);
-	lua_pop(state, 1);
-
-	// 注册 native_skeleton 模块
-	luaL_requiref(state, "native_skeleton", luaopen_native_skeleton, 0);
-	lua_pop(state, 1);
-
-	// 注册 native_ai 模块
-	luaL_requiref(state, "native_ai", luaopen_native_ai, 0);
-	lua_pop(state, 1);
-
-	// 注册 native_ui 模块
-	luaL_requiref(state, "native_ui", luaopen_native_ui, 0);
-	lua_pop(state, 1);
+	// 登记 native_* 模块到 package.preload，首次 require 时才构建模块表
+	_register_native_modules(state);
 
 	return true;
 }
 
 void LuaRuntime::shutdown() {
+#if LUAGD_MODULE_DEBUG_DRAW
 	debug_draw_cleanup();
+#endif
+#if LUAGD_MODULE_AUDIO
 	audio_cleanup();
+#endif
+#if LUAGD_MODULE_COLLISION
 	collision_cleanup();
+#endif
+#if LUAGD_MODULE_RES
 	res_cleanup();
+#endif
+#if LUAGD_MODULE_ANIM
 	anim_cleanup();
+#endif
+#if LUAGD_MODULE_AI
 	ai_cleanup();
+#endif
+#if LUAGD_MODULE_TIMER
+	timer_cleanup();
+#endif
+#if LUAGD_MODULE_TRANSFORM
+	transform_cleanup();
+#endif
 	node_cleanup();
 	lua_signal_binding_cleanup(state);
+	lua_worker_pool_cleanup(state);
+	core_scheduler_cleanup();
+	core_phases_cleanup();
+	host_interpolation_cleanup();
+	// 关闭 state 前换回原分配器
+	lua_alloc_profiler_cleanup(state);
 	if (state != nullptr) {
 		lua_close(state);
 		state = nullptr;
 	}
+#if LUAGD_POOLED_ALLOCATOR
+	pool_allocator.release();
+#endif
+	lua_module_searcher_cleanup();
+	lua_gc_pacer_cleanup();
+	lua_profiler_cleanup();
+	lua_binding_stats_cleanup();
+	host_trace_cleanup();
+	host_memory_reset();
+	host_error_reset();
 }
 
 bool LuaRuntime::is_initialized() {
@@ -144,31 +306,118 @@ lua_State *LuaRuntime::get_state() {
 	return state;
 }
 
-int LuaRuntime::run_file(const godot::String &p_path) {
-	if (state == nullptr) {
-		godot::UtilityFunctions::printerr("LuaRuntime.run_file: runtime not initialized");
-		return -1;
+const LuaPoolAllocator *LuaRuntime::get_allocator() {
+#if LUAGD_POOLED_ALLOCATOR
+	return &pool_allocator;
+#else
+	return nullptr;
+#endif
+}
+
+// 流式读取时每次从 FileAccess 取出的字节数
+static const int64_t LOAD_CHUNK_SIZE = 16 * 1024;
+
+// 与 get_as_text() 的行为一致：跳过开头的 UTF-8 BOM
+static int64_t _utf8_bom_length(const uint8_t *p_data, int64_t p_size) {
+	if (p_size >= 3 && p_data[0] == 0xEF && p_data[1] == 0xBB && p_data[2] == 0xBF) {
+		return 3;
+	}
+	return 0;
+}
+
+// lua_Reader 的上下文：buffer 需存活到下一次回调，由 Lua 读取期间持有
+struct FileChunkReader {
+	godot::Ref<godot::FileAccess> file;
+	godot::PackedByteArray buffer;
+	bool first_chunk;
+};
+
+static const char *_read_file_chunk(lua_State *p_L, void *p_ud, size_t *r_size) {
+	FileChunkReader *reader = static_cast<FileChunkReader *>(p_ud);
+	reader->buffer = reader->file->get_buffer(LOAD_CHUNK_SIZE);
+
+	const uint8_t *data = reader->buffer.ptr();
+	int64_t size = reader->buffer.size();
+	if (reader->first_chunk) {
+		reader->first_chunk = false;
+		const int64_t bom_length = _utf8_bom_length(data, size);
+		data += bom_length;
+		size -= bom_length;
 	}
 
+	*r_size = (size_t)size;
+	return size > 0 ? reinterpret_cast<const char *>(data) : nullptr;
+}
+
+int LuaRuntime::load_file(lua_State *p_L, const godot::String &p_path) {
+	godot::CharString utf8_path = p_path.utf8();
+
 	// 通过 Godot 的 FileAccess 读取文件内容（支持 res:// 路径）
 	godot::Ref<godot::FileAccess> file = godot::FileAccess::open(p_path, godot::FileAccess::READ);
 	if (!file.is_valid()) {
-		godot::String err_msg = "LuaRuntime.run_file: cannot open file '";
-		err_msg += p_path;
-		err_msg += "'";
-		godot::UtilityFunctions::printerr(err_msg);
-		return -1;
+		lua_pushfstring(p_L, "cannot open file '%s'", utf8_path.get_data());
+		return LUA_ERRFILE;
 	}
 
-	godot::String content = file->get_as_text();
+	// 直接交给 Lua 原始字节（源码本身即 UTF-8），不经过 String 的 UTF-32 解码与再编码。
+	// 只接受文本 chunk，与原先经 get_as_text() 读取时的行为一致。
+	if (!lua_chunk_cache_is_enabled()) {
+		// 未启用缓存：按固定大小分块流式读取，峰值内存与文件大小无关
+		FileChunkReader reader;
+		reader.file = file;
+		reader.first_chunk = true;
+		int load_result = lua_load(p_L, _read_file_chunk, &reader, utf8_path.get_data(), "t");
+		file->close();
+		return load_result;
+	}
+
+	// 启用缓存：需要对完整源码求哈希，一次性读入单个缓冲区
+	const godot::PackedByteArray content = file->get_buffer((int64_t)file->get_length());
 	file->close();
 
-	// 转换为 UTF-8 供 Lua 使用
-	godot::CharString utf8_content = content.utf8();
-	godot::CharString utf8_path = p_path.utf8();
+	const int64_t bom_length = _utf8_bom_length(content.ptr(), content.size());
+	const char *source = reinterpret_cast<const char *>(content.ptr()) + bom_length;
+	const size_t source_size = (size_t)(content.size() - bom_length);
+
+	// 字节码缓存以源码内容哈希为键，内容变化即视为过期
+	const uint64_t source_hash = lua_chunk_cache_hash(source, source_size);
+	if (lua_chunk_cache_try_load(p_L, p_path, source_hash, utf8_path.get_data())) {
+		return LUA_OK;
+	}
+
+	int load_result = luaL_loadbufferx(p_L, source, source_size, utf8_path.get_data(), "t");
+	if (load_result == LUA_OK) {
+		lua_chunk_cache_store(p_L, p_path, source_hash);
+	}
+	return load_result;
+}
+
+int lua_traceback_handler(lua_State *p_L) {
+	const char *message = lua_tostring(p_L, 1);
+	luaL_traceback(p_L, p_L, message != nullptr ? message : "(error object is not a string)", 1);
+	return 1;
+}
 
-	// 加载并执行
-	int load_result = luaL_loadbuffer(state, utf8_content.get_data(), utf8_content.length(), utf8_path.get_data());
+void LuaRuntime::set_bytecode_cache(bool p_enabled, const godot::String &p_cache_dir) {
+	lua_chunk_cache_configure(p_enabled, p_cache_dir);
+}
+
+int LuaRuntime::run_file(const godot::String &p_path) {
+	if (state == nullptr) {
+		godot::UtilityFunctions::printerr("LuaRuntime.run_file: runtime not initialized");
+		return -1;
+	}
+
+	// 加载（或从字节码缓存恢复）并执行
+	int load_result = load_file(state, p_path);
+	if (load_result == LUA_ERRFILE) {
+		const char *err = lua_tostring(state, -1);
+		godot::String err_msg = "LuaRuntime.run_file: ";
+		err_msg += err ? err : "(unknown)";
+		godot::UtilityFunctions::printerr(err_msg);
+		lua_pop(state, 1);
+		return -1;
+	}
 	if (load_result != LUA_OK) {
 		const char *err = lua_tostring(state, -1);
 		godot::String err_msg = "LuaRuntime.run_file: load error: ";
@@ -7,6 +7,8 @@ struct lua_State;
 
 namespace luagd {
 
+class LuaPoolAllocator;
+
 // Lua 运行时：管理全局 lua_State、模块注册与脚本执行。
 // 约束：所有公开函数必须在主线程调用。
 class LuaRuntime {
@@ -33,6 +35,17 @@ public:
 	// 注意：路径解析由 Godot 的 FileAccess 处理，导出项目可能受沙盒限制。
 	static int run_file(const godot::String &p_path);
 
+	// 加载 Lua 文件并将编译后的 chunk 压入栈顶（不执行）。
+	// 源码以原始字节直接交给 Lua：未启用缓存时按 16 KB 分块流式读取，启用时一次性读入求哈希。
+	// 启用字节码缓存时优先加载缓存，缓存过期则回退到源码编译并刷新缓存。
+	// 返回：成功返回 LUA_OK，栈顶为函数；失败返回非零值，栈顶为错误消息。
+	static int load_file(lua_State *p_L, const godot::String &p_path);
+
+	// 配置字节码缓存，详见 lua_chunk_cache_configure()。
+	// p_enabled: 是否启用缓存。
+	// p_cache_dir: 缓存目录，为空时使用 "user://luagd_bytecode"。
+	static void set_bytecode_cache(bool p_enabled, const godot::String &p_cache_dir);
+
 	// 执行 Lua 字符串。
 	// 返回：成功返回 0，失败返回非零值。
 	// p_code: Lua 源代码
@@ -43,6 +56,10 @@ public:
 	// 返回：未初始化时返回 nullptr。
 	static lua_State *get_state();
 
+	// 获取全局 lua_State 使用的池分配器。
+	// 返回：构建时未启用 LUAGD_POOLED_ALLOCATOR 时返回 nullptr。
+	static const LuaPoolAllocator *get_allocator();
+
 private:
 	LuaRuntime() = delete;
 	~LuaRuntime() = delete;
@@ -50,6 +67,10 @@ private:
 	static lua_State *state;
 };
 
+// lua_pcall 的消息处理函数：为错误消息附加调用栈（非字符串错误对象替换为说明文字）。
+// 只使用 Lua API，可用于任意 lua_State（包括 worker 线程上的 state）。
+int lua_traceback_handler(lua_State *p_L);
+
 } // namespace luagd
 
 #endif // LUAGD_LUA_RUNTIME_H
@@ -129,6 +129,19 @@ void lua_signal_binding_disconnect_by_source(lua_State *p_L, godot::ObjectID p_s
 	}
 }
 
+void lua_signal_binding_collect_memory(godot::LocalVector<HostMemoryTable> &r_tables) {
+	int64_t bytes = host_memory_hash_map_bytes(bindings);
+	for (const godot::KeyValue<int32_t, LuaSignalBinding> &entry : bindings) {
+		// String 为 UTF-32 存储
+		bytes += (int64_t)entry.value.debug_name.length() * 4;
+	}
+	r_tables.push_back({"signal_binding.bindings", (int64_t)bindings.size(), bytes});
+}
+
+int lua_signal_binding_get_count() {
+	return (int)bindings.size();
+}
+
 void lua_signal_binding_cleanup(lua_State *p_L) {
 	godot::Vector<int32_t> ids;
 
@@ -1,6 +1,8 @@
 #ifndef LUAGD_LUA_SIGNAL_BINDING_H
 #define LUAGD_LUA_SIGNAL_BINDING_H
 
+#include "../host/host_memory_stats.h"
+
 #include <godot_cpp/core/object_id.hpp>
 #include <godot_cpp/variant/callable.hpp>
 #include <godot_cpp/variant/string.hpp>
@@ -38,6 +40,12 @@ void lua_signal_binding_disconnect(lua_State *p_L, int32_t p_binding_id);
 // 断开所有 source_id 匹配的绑定。
 void lua_signal_binding_disconnect_by_source(lua_State *p_L, godot::ObjectID p_source_id);
 
+// 返回：当前绑定数。
+int lua_signal_binding_get_count();
+
+// 把模块表的条目数与估算字节数追加到 r_tables，供 host_memory_collect 使用。
+void lua_signal_binding_collect_memory(godot::LocalVector<HostMemoryTable> &r_tables);
+
 // 清理全部绑定，重置 id 分配。必须在 lua_close 前调用。
 void lua_signal_binding_cleanup(lua_State *p_L);
 
@@ -0,0 +1,665 @@
+#include "lua_worker_pool.h"
+#include "lua_allocator.h"
+#include "lua_runtime.h"
+#include "../host/host_error_sink.h"
+
+#include <cstring>
+#include <mutex>
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/memory.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/callable.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+extern "C" {
+#include <lua.h>
+#include <lualib.h>
+#include <lauxlib.h>
+}
+
+namespace luagd {
+
+// worker state 注册表中任务函数表的键
+static const char *WORKER_JOBS_KEY = "luagd.worker_jobs";
+// 序列化时 table 的最大嵌套深度（同时用于拒绝循环引用）
+static const int MAX_SERIALIZE_DEPTH = 32;
+
+// 序列化标签
+enum WorkerValueTag : uint8_t {
+	TAG_NIL = 0,
+	TAG_FALSE = 1,
+	TAG_TRUE = 2,
+	TAG_INTEGER = 3,
+	TAG_NUMBER = 4,
+	TAG_STRING = 5,
+	TAG_TABLE = 6,
+	TAG_TABLE_END = 7,
+};
+
+struct WorkerJob {
+	int64_t job_id;
+	godot::CharString job_name;
+	int callback_ref;
+	godot::LocalVector<uint8_t> args;
+	// 以下由 worker 线程写入，主线程在等待任务结束后读取
+	godot::LocalVector<uint8_t> results;
+	bool ok;
+	godot::String error;
+};
+
+// 一个 worker：独占的 lua_State，同一时刻最多执行一个任务。
+// state 在 worker 线程首次执行任务时创建；job / task_id / busy 只由主线程修改。
+struct WorkerSlot {
+	lua_State *state;
+#if LUAGD_POOLED_ALLOCATOR
+	LuaPoolAllocator allocator;
+#endif
+	WorkerJob *job;
+	int64_t task_id;
+	bool busy;
+
+	WorkerSlot() :
+			state(nullptr),
+			job(nullptr),
+			task_id(-1),
+			busy(false) {}
+};
+
+// LuaWorkerRunner：WorkerThreadPool 任务入口，run_slot 在工作线程执行。
+class LuaWorkerRunner : public godot::Object {
+	GDCLASS(LuaWorkerRunner, godot::Object);
+
+protected:
+	static void _bind_methods();
+
+public:
+	void run_slot(int p_slot);
+};
+
+static godot::LocalVector<WorkerSlot *> slots;
+static godot::LocalVector<WorkerJob *> pending_jobs;
+static uint32_t pending_head = 0;
+static godot::String script_path;
+static int64_t next_job_id = 1;
+static LuaWorkerRunner *runner = nullptr;
+
+// 已完成任务的 slot 索引，worker 线程写入、主线程取出
+static std::mutex completed_mutex;
+static godot::LocalVector<int> completed_slots;
+
+// ---------------------------------------------------------------------------
+// 序列化
+// ---------------------------------------------------------------------------
+
+static void _write_bytes(godot::LocalVector<uint8_t> &r_out, const void *p_data, size_t p_size) {
+	const uint32_t offset = r_out.size();
+	r_out.resize(offset + (uint32_t)p_size);
+	memcpy(r_out.ptr() + offset, p_data, p_size);
+}
+
+static void _write_tag(godot::LocalVector<uint8_t> &r_out, WorkerValueTag p_tag) {
+	r_out.push_back((uint8_t)p_tag);
+}
+
+static bool _serialize_value(lua_State *p_L, int p_index, godot::LocalVector<uint8_t> &r_out, int p_depth, godot::String &r_error) {
+	switch (lua_type(p_L, p_index)) {
+		case LUA_TNIL:
+			_write_tag(r_out, TAG_NIL);
+			return true;
+		case LUA_TBOOLEAN:
+			_write_tag(r_out, lua_toboolean(p_L, p_index) ? TAG_TRUE : TAG_FALSE);
+			return true;
+		case LUA_TNUMBER:
+			if (lua_isinteger(p_L, p_index)) {
+				const int64_t value = (int64_t)lua_tointeger(p_L, p_index);
+				_write_tag(r_out, TAG_INTEGER);
+				_write_bytes(r_out, &value, sizeof(value));
+			} else {
+				const double value = (double)lua_tonumber(p_L, p_index);
+				_write_tag(r_out, TAG_NUMBER);
+				_write_bytes(r_out, &value, sizeof(value));
+			}
+			return true;
+		case LUA_TSTRING: {
+			size_t length = 0;
+			const char *data = lua_tolstring(p_L, p_index, &length);
+			const uint32_t length32 = (uint32_t)length;
+			_write_tag(r_out, TAG_STRING);
+			_write_bytes(r_out, &length32, sizeof(length32));
+			_write_bytes(r_out, data, length);
+			return true;
+		}
+		case LUA_TTABLE: {
+			if (p_depth >= MAX_SERIALIZE_DEPTH) {
+				r_error = "table nesting too deep (cyclic table?)";
+				return false;
+			}
+			if (!lua_checkstack(p_L, 3)) {
+				r_error = "stack overflow";
+				return false;
+			}
+
+			const int table_index = lua_absindex(p_L, p_index);
+			_write_tag(r_out, TAG_TABLE);
+			lua_pushnil(p_L);
+			while (lua_next(p_L, table_index) != 0) {
+				if (!_serialize_value(p_L, -2, r_out, p_depth + 1, r_error) ||
+						!_serialize_value(p_L, -1, r_out, p_depth + 1, r_error)) {
+					lua_pop(p_L, 2);
+					return false;
+				}
+				lua_pop(p_L, 1);
+			}
+			_write_tag(r_out, TAG_TABLE_END);
+			return true;
+		}
+		default:
+			r_error = godot::String("cannot pass a ") + lua_typename(p_L, lua_type(p_L, p_index)) + " value to a worker";
+			return false;
+	}
+}
+
+// 序列化栈上 [p_first, p_last] 区间的值：u32 个数 + 各值。
+static bool _serialize_range(lua_State *p_L, int p_first, int p_last, godot::LocalVector<uint8_t> &r_out, godot::String &r_error) {
+	const uint32_t count = p_last >= p_first ? (uint32_t)(p_last - p_first + 1) : 0;
+	_write_bytes(r_out, &count, sizeof(count));
+	for (int i = p_first; i <= p_last; i++) {
+		if (!_serialize_value(p_L, i, r_out, 0, r_error)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+struct WorkerBufferReader {
+	const uint8_t *data;
+	uint32_t size;
+	uint32_t pos;
+};
+
+static bool _read_bytes(WorkerBufferReader &r_reader, void *r_dst, uint32_t p_size) {
+	if (r_reader.size - r_reader.pos < p_size) {
+		return false;
+	}
+	memcpy(r_dst, r_reader.data + r_reader.pos, p_size);
+	r_reader.pos += p_size;
+	return true;
+}
+
+static bool _deserialize_value(lua_State *p_L, WorkerBufferReader &r_reader, int p_depth) {
+	uint8_t tag = 0;
+	if (p_depth > MAX_SERIALIZE_DEPTH || !lua_checkstack(p_L, 3) || !_read_bytes(r_reader, &tag, 1)) {
+		return false;
+	}
+
+	switch (tag) {
+		case TAG_NIL:
+			lua_pushnil(p_L);
+			return true;
+		case TAG_FALSE:
+			lua_pushboolean(p_L, 0);
+			return true;
+		case TAG_TRUE:
+			lua_pushboolean(p_L, 1);
+			return true;
+		case TAG_INTEGER: {
+			int64_t value = 0;
+			if (!_read_bytes(r_reader, &value, sizeof(value))) {
+				return false;
+			}
+			lua_pushinteger(p_L, (lua_Integer)value);
+			return true;
+		}
+		case TAG_NUMBER: {
+			double value = 0.0;
+			if (!_read_bytes(r_reader, &value, sizeof(value))) {
+				return false;
+			}
+			lua_pushnumber(p_L, (lua_Number)value);
+			return true;
+		}
+		case TAG_STRING: {
+			uint32_t length = 0;
+			if (!_read_bytes(r_reader, &length, sizeof(length)) || r_reader.size - r_reader.pos < length) {
+				return false;
+			}
+			lua_pushlstring(p_L, reinterpret_cast<const char *>(r_reader.data + r_reader.pos), length);
+			r_reader.pos += length;
+			return true;
+		}
+		case TAG_TABLE: {
+			lua_newtable(p_L);
+			while (true) {
+				if (r_reader.pos >= r_reader.size) {
+					return false;
+				}
+				if (r_reader.data[r_reader.pos] == TAG_TABLE_END) {
+					r_reader.pos += 1;
+					return true;
+				}
+				if (!_deserialize_value(p_L, r_reader, p_depth + 1) ||
+						!_deserialize_value(p_L, r_reader, p_depth + 1)) {
+					return false;
+				}
+				lua_rawset(p_L, -3);
+			}
+		}
+		default:
+			return false;
+	}
+}
+
+// 将缓冲区中的值依次压栈。
+// 返回：压入的值个数；数据损坏时恢复栈顶并返回 -1。
+static int _deserialize_range(lua_State *p_L, const godot::LocalVector<uint8_t> &p_buffer) {
+	WorkerBufferReader reader;
+	reader.data = p_buffer.ptr();
+	reader.size = p_buffer.size();
+	reader.pos = 0;
+
+	const int top = lua_gettop(p_L);
+	uint32_t count = 0;
+	if (!_read_bytes(reader, &count, sizeof(count))) {
+		return -1;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		if (!_deserialize_value(p_L, reader, 0)) {
+			lua_settop(p_L, top);
+			return -1;
+		}
+	}
+	return (int)count;
+}
+
+// ---------------------------------------------------------------------------
+// worker 线程
+// ---------------------------------------------------------------------------
+
+// 仅打开纯计算库，worker state 不接触引擎与文件系统
+static const luaL_Reg worker_libs[] = {
+	{LUA_GNAME, luaopen_base},
+	{LUA_TABLIBNAME, luaopen_table},
+	{LUA_STRLIBNAME, luaopen_string},
+	{LUA_MATHLIBNAME, luaopen_math},
+	{LUA_UTF8LIBNAME, luaopen_utf8},
+	{nullptr, nullptr}
+};
+
+// 打开库时的错误交给 lua_pcall 捕获，只有其余未受保护的调用才会走到这里
+static int _worker_panic(lua_State *p_L) {
+	const char *err = lua_tostring(p_L, -1);
+	godot::String err_msg = "native_worker: unprotected error in call to Lua API: ";
+	err_msg += err ? err : "(error object is not a string)";
+	godot::UtilityFunctions::printerr(err_msg);
+	return 0;
+}
+
+static int _open_worker_libs(lua_State *p_L) {
+	for (const luaL_Reg *lib = worker_libs; lib->func != nullptr; lib++) {
+		luaL_requiref(p_L, lib->name, lib->func, 1);
+		lua_pop(p_L, 1);
+	}
+	lua_pushnil(p_L);
+	lua_setglobal(p_L, "dofile");
+	lua_pushnil(p_L);
+	lua_setglobal(p_L, "loadfile");
+	return 0;
+}
+
+static lua_State *_new_worker_state(WorkerSlot *p_slot) {
+#if LUAGD_POOLED_ALLOCATOR
+#if LUA_VERSION_NUM >= 505
+	lua_State *L = lua_newstate(LuaPoolAllocator::lua_alloc, &p_slot->allocator, luaL_makeseed(nullptr));
+#else
+	lua_State *L = lua_newstate(LuaPoolAllocator::lua_alloc, &p_slot->allocator);
+#endif
+	if (L != nullptr) {
+		lua_atpanic(L, _worker_panic);
+	}
+	return L;
+#else
+	(void)p_slot;
+	return luaL_newstate();
+#endif
+}
+
+static void _close_worker_state(WorkerSlot *p_slot) {
+	if (p_slot->state != nullptr) {
+		lua_close(p_slot->state);
+		p_slot->state = nullptr;
+	}
+#if LUAGD_POOLED_ALLOCATOR
+	p_slot->allocator.release();
+#endif
+}
+
+// 创建 worker state 并执行任务脚本。
+// 失败时关闭 state，下一个任务到来时重试。
+static bool _ensure_worker_state(WorkerSlot *p_slot, godot::String &r_error) {
+	if (p_slot->state != nullptr) {
+		return true;
+	}
+
+	lua_State *L = _new_worker_state(p_slot);
+	if (L == nullptr) {
+		r_error = "failed to create worker Lua state";
+		return false;
+	}
+	p_slot->state = L;
+
+	// 内存不足等错误在保护模式下抛出，不会落到 panic 终止进程
+	lua_pushcfunction(L, _open_worker_libs);
+	if (lua_pcall(L, 0, 0, 0) != LUA_OK) {
+		const char *err = lua_tostring(L, -1);
+		r_error = godot::String("failed to open worker libraries: ") + godot::String::utf8(err ? err : "(unknown)");
+		_close_worker_state(p_slot);
+		return false;
+	}
+
+	const godot::CharString utf8_path = script_path.utf8();
+	godot::Ref<godot::FileAccess> file = godot::FileAccess::open(script_path, godot::FileAccess::READ);
+	if (!file.is_valid()) {
+		r_error = godot::String("cannot open worker script '") + script_path + "'";
+		_close_worker_state(p_slot);
+		return false;
+	}
+	const godot::PackedByteArray source = file->get_buffer((int64_t)file->get_length());
+	file->close();
+
+	lua_pushcfunction(L, lua_traceback_handler);
+	int status = luaL_loadbufferx(L, reinterpret_cast<const char *>(source.ptr()), (size_t)source.size(), utf8_path.get_data(), "t");
+	if (status == LUA_OK) {
+		status = lua_pcall(L, 0, 1, 1);
+	}
+	if (status != LUA_OK) {
+		const char *err = lua_tostring(L, -1);
+		r_error = godot::String("worker script error: ") + godot::String::utf8(err ? err : "(unknown)");
+		_close_worker_state(p_slot);
+		return false;
+	}
+	if (!lua_istable(L, -1)) {
+		r_error = "worker script must return a table of job functions";
+		_close_worker_state(p_slot);
+		return false;
+	}
+
+	lua_setfield(L, LUA_REGISTRYINDEX, WORKER_JOBS_KEY);
+	lua_settop(L, 0);
+	return true;
+}
+
+static void _run_job(WorkerSlot *p_slot, WorkerJob *p_job) {
+	p_job->ok = false;
+	if (!_ensure_worker_state(p_slot, p_job->error)) {
+		return;
+	}
+
+	lua_State *L = p_slot->state;
+	lua_settop(L, 0);
+	lua_pushcfunction(L, lua_traceback_handler);
+
+	lua_getfield(L, LUA_REGISTRYINDEX, WORKER_JOBS_KEY);
+	lua_getfield(L, -1, p_job->job_name.get_data());
+	lua_remove(L, -2);
+	if (!lua_isfunction(L, -1)) {
+		p_job->error = godot::String("unknown job '") + godot::String::utf8(p_job->job_name.get_data()) + "'";
+		lua_settop(L, 0);
+		return;
+	}
+
+	const int arg_count = _deserialize_range(L, p_job->args);
+	if (arg_count < 0) {
+		p_job->error = "corrupted job arguments";
+		lua_settop(L, 0);
+		return;
+	}
+
+	const int status = lua_pcall(L, arg_count, LUA_MULTRET, 1);
+	if (status != LUA_OK) {
+		const char *err = lua_tostring(L, -1);
+		p_job->error = godot::String::utf8(err ? err : "(unknown)");
+		lua_settop(L, 0);
+		return;
+	}
+
+	if (_serialize_range(L, 2, lua_gettop(L), p_job->results, p_job->error)) {
+		p_job->ok = true;
+	} else {
+		p_job->results.clear();
+	}
+	lua_settop(L, 0);
+}
+
+void LuaWorkerRunner::_bind_methods() {
+	godot::ClassDB::bind_method(godot::D_METHOD("run_slot", "slot"), &LuaWorkerRunner::run_slot);
+}
+
+void LuaWorkerRunner::run_slot(int p_slot) {
+	// slot 在任务结束（主线程 wait_for_task_completion）之前不会被改动或释放
+	WorkerSlot *slot = slots[p_slot];
+	_run_job(slot, slot->job);
+
+	std::lock_guard<std::mutex> lock(completed_mutex);
+	completed_slots.push_back(p_slot);
+}
+
+// ---------------------------------------------------------------------------
+// 主线程
+// ---------------------------------------------------------------------------
+
+static uint32_t _pending_size() {
+	return pending_jobs.size() - pending_head;
+}
+
+static void _release_job(lua_State *p_L, WorkerJob *p_job) {
+	if (p_L != nullptr && p_job->callback_ref != LUA_NOREF) {
+		luaL_unref(p_L, LUA_REGISTRYINDEX, p_job->callback_ref);
+	}
+	godot::memdelete(p_job);
+}
+
+static void _dispatch_pending() {
+	godot::WorkerThreadPool *pool = godot::WorkerThreadPool::get_singleton();
+	for (uint32_t i = 0; i < slots.size() && _pending_size() > 0; i++) {
+		WorkerSlot *slot = slots[i];
+		if (slot->busy) {
+			continue;
+		}
+
+		slot->job = pending_jobs[pending_head];
+		pending_jobs[pending_head] = nullptr;
+		pending_head += 1;
+		slot->busy = true;
+		slot->task_id = pool->add_task(godot::Callable(runner, "run_slot").bind((int)i), false, "luagd worker job");
+	}
+
+	// 队列取空时回收已消费的前缀
+	if (_pending_size() == 0) {
+		pending_jobs.clear();
+		pending_head = 0;
+	}
+}
+
+void lua_worker_pool_register_types() {
+	GDREGISTER_CLASS(LuaWorkerRunner);
+}
+
+bool lua_worker_pool_configure(const godot::String &p_script_path, int p_worker_count) {
+	if (lua_worker_pool_get_pending_count() > 0) {
+		godot::UtilityFunctions::printerr("native_worker.configure: jobs still pending");
+		return false;
+	}
+
+	int worker_count = p_worker_count;
+	if (worker_count <= 0) {
+		godot::OS *os = godot::OS::get_singleton();
+		worker_count = os != nullptr ? os->get_processor_count() - 1 : 1;
+		if (worker_count < 1) {
+			worker_count = 1;
+		}
+	}
+
+	for (uint32_t i = 0; i < slots.size(); i++) {
+		_close_worker_state(slots[i]);
+		godot::memdelete(slots[i]);
+	}
+	slots.clear();
+	for (int i = 0; i < worker_count; i++) {
+		slots.push_back(godot::memnew(WorkerSlot));
+	}
+
+	script_path = p_script_path;
+	if (runner == nullptr) {
+		runner = godot::memnew(LuaWorkerRunner);
+	}
+	return true;
+}
+
+int64_t lua_worker_pool_submit(lua_State *p_L, const char *p_job_name, int p_callback_index, int p_first_arg) {
+	if (slots.is_empty()) {
+		godot::UtilityFunctions::printerr("native_worker.submit: worker pool not configured");
+		return -1;
+	}
+
+	const bool has_callback = !lua_isnoneornil(p_L, p_callback_index);
+	if (has_callback && !lua_isfunction(p_L, p_callback_index)) {
+		godot::UtilityFunctions::printerr("native_worker.submit: callback must be a function or nil");
+		return -1;
+	}
+
+	WorkerJob *job = godot::memnew(WorkerJob);
+	job->job_id = next_job_id++;
+	job->job_name = godot::String::utf8(p_job_name).utf8();
+	job->callback_ref = LUA_NOREF;
+	job->ok = false;
+
+	godot::String error;
+	if (!_serialize_range(p_L, p_first_arg, lua_gettop(p_L), job->args, error)) {
+		godot::UtilityFunctions::printerr("native_worker.submit: ", error);
+		godot::memdelete(job);
+		return -1;
+	}
+
+	if (has_callback) {
+		lua_pushvalue(p_L, p_callback_index);
+		job->callback_ref = luaL_ref(p_L, LUA_REGISTRYINDEX);
+	}
+
+	const int64_t job_id = job->job_id;
+	pending_jobs.push_back(job);
+	_dispatch_pending();
+	return job_id;
+}
+
+int lua_worker_pool_drain(lua_State *p_L) {
+	godot::LocalVector<int> finished;
+	{
+		std::lock_guard<std::mutex> lock(completed_mutex);
+		if (completed_slots.is_empty()) {
+			return 0;
+		}
+		finished = completed_slots;
+		completed_slots.clear();
+	}
+
+	// 所有回调共用一个 traceback 处理函数，错误信息带完整调用栈
+	lua_pushcfunction(p_L, lua_traceback_handler);
+	const int handler_index = lua_gettop(p_L);
+
+	godot::WorkerThreadPool *pool = godot::WorkerThreadPool::get_singleton();
+	for (uint32_t i = 0; i < finished.size(); i++) {
+		WorkerSlot *slot = slots[finished[i]];
+		// 任务已推入完成队列，这里只等待 run_slot 返回并回收任务记录
+		pool->wait_for_task_completion(slot->task_id);
+
+		WorkerJob *job = slot->job;
+		slot->job = nullptr;
+		slot->task_id = -1;
+		slot->busy = false;
+
+		if (job->callback_ref != LUA_NOREF) {
+			lua_rawgeti(p_L, LUA_REGISTRYINDEX, job->callback_ref);
+			int arg_count = 1;
+			if (job->ok) {
+				lua_pushboolean(p_L, 1);
+				const int result_count = _deserialize_range(p_L, job->results);
+				arg_count += result_count > 0 ? result_count : 0;
+			} else {
+				lua_pushboolean(p_L, 0);
+				const godot::CharString utf8_error = job->error.utf8();
+				lua_pushstring(p_L, utf8_error.get_data());
+				arg_count += 1;
+			}
+
+			const int call_result = lua_pcall(p_L, arg_count, 0, handler_index);
+			if (call_result != LUA_OK) {
+				const char *err = lua_tostring(p_L, -1);
+				LUAGD_REPORT_ERROR("native_worker", "callback", err ? err : "(unknown)");
+				lua_pop(p_L, 1);
+			}
+		} else if (!job->ok) {
+			LUAGD_REPORT_ERROR("native_worker", "job", "'", job->job_name.get_data(), "' failed: ", job->error);
+		}
+
+		_release_job(p_L, job);
+	}
+	lua_pop(p_L, 1);
+
+	_dispatch_pending();
+	return (int)finished.size();
+}
+
+int lua_worker_pool_get_pending_count() {
+	int count = (int)_pending_size();
+	for (uint32_t i = 0; i < slots.size(); i++) {
+		if (slots[i]->busy) {
+			count += 1;
+		}
+	}
+	return count;
+}
+
+int lua_worker_pool_get_worker_count() {
+	return (int)slots.size();
+}
+
+void lua_worker_pool_cleanup(lua_State *p_L) {
+	godot::WorkerThreadPool *pool = godot::WorkerThreadPool::get_singleton();
+	for (uint32_t i = 0; i < slots.size(); i++) {
+		WorkerSlot *slot = slots[i];
+		if (slot->busy) {
+			if (pool != nullptr) {
+				pool->wait_for_task_completion(slot->task_id);
+			}
+			_release_job(p_L, slot->job);
+		}
+		_close_worker_state(slot);
+		godot::memdelete(slot);
+	}
+	slots.clear();
+
+	for (uint32_t i = pending_head; i < pending_jobs.size(); i++) {
+		_release_job(p_L, pending_jobs[i]);
+	}
+	pending_jobs.clear();
+	pending_head = 0;
+
+	{
+		std::lock_guard<std::mutex> lock(completed_mutex);
+		completed_slots.clear();
+	}
+
+	if (runner != nullptr) {
+		godot::memdelete(runner);
+		runner = nullptr;
+	}
+	script_path = godot::String();
+	next_job_id = 1;
+}
+
+} // namespace luagd
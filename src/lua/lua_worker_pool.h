@@ -0,0 +1,56 @@
+#ifndef LUAGD_LUA_WORKER_POOL_H
+#define LUAGD_LUA_WORKER_POOL_H
+
+#include <cstdint>
+
+#include <godot_cpp/variant/string.hpp>
+
+struct lua_State;
+
+namespace luagd {
+
+// 工作线程 Lua 池：在 Godot WorkerThreadPool 上运行若干独立的 lua_State，执行纯计算任务。
+//
+// 每个 worker state 只打开 base / table / string / math / utf8（移除 dofile、loadfile），
+// 不能访问 native_* 模块与场景。任务脚本返回一张任务函数表：
+//   return { find_path = function(grid, from, to) ... return path end }
+// 参数与返回值经序列化跨线程传递，支持 nil / boolean / number / string 与嵌套 table。
+// 任务完成后结果进入完成队列，由主线程在 LuaHost::tick 中取出并调用回调。
+
+// 注册任务执行器类型。在 GDExtension 初始化阶段调用。
+void lua_worker_pool_register_types();
+
+// 配置任务脚本与 worker 数量。已有 worker state 会被关闭，下一个任务到来时按新脚本重建。
+// p_script_path: 任务脚本路径（res:// 等，经 FileAccess 读取）。
+// p_worker_count: worker 数量，<= 0 时取 CPU 核数 - 1（至少 1）。
+// 返回：成功返回 true；仍有未完成任务时拒绝并返回 false。
+// 约束：只允许在主线程调用。
+bool lua_worker_pool_configure(const godot::String &p_script_path, int p_worker_count);
+
+// 提交任务。
+// p_job_name: 任务函数名（任务脚本返回表中的键）。
+// p_callback_index: 回调函数所在栈位置，为 nil 时不回调。
+//   回调签名：callback(true, results...) 或 callback(false, error_message)。
+// p_first_arg: 第一个任务参数所在栈位置，直到栈顶。
+// 返回：任务 id（>= 1），失败返回 -1（错误已打印）。
+// 约束：只允许在主线程调用。
+int64_t lua_worker_pool_submit(lua_State *p_L, const char *p_job_name, int p_callback_index, int p_first_arg);
+
+// 取出已完成任务并在 p_L 上调用回调，然后把排队任务派发给空闲 worker。
+// 返回：本次处理的完成任务数。
+// 约束：只允许在主线程调用。由 LuaHost::tick 在 update 回调之前调用。
+int lua_worker_pool_drain(lua_State *p_L);
+
+// 返回：排队中与执行中的任务数。
+int lua_worker_pool_get_pending_count();
+
+// 返回：配置的 worker 数量，未配置时为 0。
+int lua_worker_pool_get_worker_count();
+
+// 等待执行中的任务结束，丢弃所有任务与回调，关闭 worker state。
+// 必须在主 lua_State 关闭前调用（需要释放回调引用）。
+void lua_worker_pool_cleanup(lua_State *p_L);
+
+} // namespace luagd
+
+#endif // LUAGD_LUA_WORKER_POOL_H
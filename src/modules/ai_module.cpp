@@ -2,7 +2,9 @@
 
 #include "node_module.h"
 
+#include "../host/host_error_sink.h"
 #include "../host/host_thread_check.h"
+#include "../lua/lua_binding_stats.h"
 #include "../lua/lua_runtime.h"
 
 #include <godot_cpp/classes/engine.hpp>
@@ -31,14 +33,14 @@ static int32_t next_id = 1;
 
 static NavigationAgentRecord *get_agent(int32_t p_id, const char *p_func_name) {
 	if (!agents.has(p_id)) {
-		godot::UtilityFunctions::printerr("native_ai.", p_func_name, ": invalid id ", p_id);
+		LUAGD_REPORT_ERROR("native_ai", p_func_name, "invalid id ", p_id);
 		return nullptr;
 	}
 
 	NavigationAgentRecord *rec = &agents[p_id];
 	if (rec->agent == nullptr || !rec->agent->is_inside_tree()) {
 		agents.erase(p_id);
-		godot::UtilityFunctions::printerr("native_ai.", p_func_name, ": agent is no longer valid, id ", p_id);
+		LUAGD_REPORT_ERROR("native_ai", p_func_name, "agent is no longer valid, id ", p_id);
 		return nullptr;
 	}
 
@@ -48,13 +50,13 @@ static NavigationAgentRecord *get_agent(int32_t p_id, const char *p_func_name) {
 // create(parent_node_id, path_desired_distance, target_desired_distance) -> agent_id
 // 创建 NavigationAgent3D 并挂载到父节点。
 static int l_create(lua_State *p_L) {
-	const godot::ObjectID parent_id = godot::ObjectID((uint64_t)luaL_checkinteger(p_L, 1));
+	const NodeHandle parent_id = node_check_handle(p_L, 1);
 	const double path_desired_distance = luaL_checknumber(p_L, 2);
 	const double target_desired_distance = luaL_checknumber(p_L, 3);
 
 	godot::Node3D *parent = node_resolve(parent_id);
 	if (parent == nullptr) {
-		godot::UtilityFunctions::printerr("native_ai.create: parent node not found or invalid");
+		LUAGD_REPORT_ERROR("native_ai", "create", "parent node not found or invalid");
 		lua_pushinteger(p_L, -1);
 		return 1;
 	}
@@ -187,7 +189,7 @@ static const luaL_Reg ai_funcs[] = {
 };
 
 int luaopen_native_ai(lua_State *p_L) {
-	luaL_newlib(p_L, ai_funcs);
+	lua_binding_new_lib(p_L, "native_ai", ai_funcs);
 	return 1;
 }
 
@@ -2,6 +2,11 @@
 
 #include "node_module.h"
 
+#include "../host/host_error_sink.h"
+#include "../host/host_thread_check.h"
+#include "../host/host_trace.h"
+#include "../lua/lua_binding_stats.h"
+
 #include <godot_cpp/classes/animation.hpp>
 #include <godot_cpp/classes/animation_library.hpp>
 #include <godot_cpp/classes/animation_mixer.hpp>
@@ -99,7 +104,7 @@ struct LayerRecord {
 
 struct AnimatorRecord {
 	int32_t id;
-	godot::ObjectID owner_node_id;
+	NodeHandle owner_node_id;
 	godot::AnimationPlayer *animation_player;
 	godot::AnimationTree *animation_tree;
 	godot::Ref<godot::AnimationNodeBlendTree> tree_root;
@@ -167,12 +172,12 @@ static bool _ensure_internal_library(AnimatorRecord *p_animator) {
 	if (library.is_null()) {
 		library.instantiate();
 		if (p_animator->animation_player->add_animation_library(library_name, library) != godot::OK) {
-			godot::UtilityFunctions::printerr("native_anim.create_animator: failed to add internal animation library to player");
+			LUAGD_REPORT_ERROR("native_anim", "create_animator", "failed to add internal animation library to player");
 			return false;
 		}
 		if (p_animator->animation_tree->add_animation_library(library_name, library) != godot::OK) {
 			p_animator->animation_player->remove_animation_library(library_name);
-			godot::UtilityFunctions::printerr("native_anim.create_animator: failed to add internal animation library to tree");
+			LUAGD_REPORT_ERROR("native_anim", "create_animator", "failed to add internal animation library to tree");
 			return false;
 		}
 		p_animator->libraries[library_name] = library;
@@ -212,7 +217,7 @@ static godot::AnimationPlayer *_get_animation_player(AnimatorRecord *p_animator,
 	}
 
 	if (p_animator->animation_player == nullptr || !p_animator->animation_player->is_inside_tree()) {
-		godot::UtilityFunctions::printerr("native_anim.", p_func_name, ": animation player is no longer valid");
+		LUAGD_REPORT_ERROR("native_anim", p_func_name, "animation player is no longer valid");
 		return nullptr;
 	}
 
@@ -221,13 +226,13 @@ static godot::AnimationPlayer *_get_animation_player(AnimatorRecord *p_animator,
 
 static AnimatorRecord *_get_animator(int32_t p_animator_id, const char *p_func_name) {
 	if (!animators.has(p_animator_id)) {
-		godot::UtilityFunctions::printerr("native_anim.", p_func_name, ": invalid animator id ", p_animator_id);
+		LUAGD_REPORT_ERROR("native_anim", p_func_name, "invalid animator id ", p_animator_id);
 		return nullptr;
 	}
 
 	AnimatorRecord *animator = &animators[p_animator_id];
 	if (!_is_animator_runtime_valid(*animator)) {
-		godot::UtilityFunctions::printerr("native_anim.", p_func_name, ": animator is no longer valid, id ", p_animator_id);
+		LUAGD_REPORT_ERROR("native_anim", p_func_name, "animator is no longer valid, id ", p_animator_id);
 		return nullptr;
 	}
 
@@ -239,7 +244,7 @@ static LayerRecord *_get_layer(AnimatorRecord *p_animator, const godot::StringNa
 		return nullptr;
 	}
 	if (!p_animator->layers.has(p_layer_name)) {
-		godot::UtilityFunctions::printerr("native_anim.", p_func_name, ": layer not found: ", godot::String(p_layer_name));
+		LUAGD_REPORT_ERROR("native_anim", p_func_name, "layer not found: ", godot::String(p_layer_name));
 		return nullptr;
 	}
 	return &p_animator->layers[p_layer_name];
@@ -293,7 +298,7 @@ static godot::Ref<godot::AnimationNode> _get_layer_mix_node(AnimatorRecord *p_an
 		return godot::Ref<godot::AnimationNode>();
 	}
 	if (!p_animator->tree_root->has_node(p_layer->layer_mix_node_name)) {
-		godot::UtilityFunctions::printerr("native_anim.", p_func_name, ": layer mix node not found: ", godot::String(p_layer->layer_mix_node_name));
+		LUAGD_REPORT_ERROR("native_anim", p_func_name, "layer mix node not found: ", godot::String(p_layer->layer_mix_node_name));
 		return godot::Ref<godot::AnimationNode>();
 	}
 	return p_animator->tree_root->get_node(p_layer->layer_mix_node_name);
@@ -404,7 +409,7 @@ static bool _assign_slot_anim(AnimatorRecord *p_animator, LayerRecord *p_layer,
 		return false;
 	}
 	if (!_has_animation(p_animator, p_anim_name)) {
-		godot::UtilityFunctions::printerr("native_anim.play: animation not found: ", godot::String(p_anim_name));
+		LUAGD_REPORT_ERROR("native_anim", "play", "animation not found: ", godot::String(p_anim_name));
 		return false;
 	}
 
@@ -437,11 +442,11 @@ static bool _assign_slot_blend2d(AnimatorRecord *p_animator, LayerRecord *p_laye
 		return false;
 	}
 	if ((p_layer->flags & FLAG_ALLOW_BLEND2D) == 0) {
-		godot::UtilityFunctions::printerr("native_anim.play_blend2d: layer does not allow blend2d: ", godot::String(p_layer->name));
+		LUAGD_REPORT_ERROR("native_anim", "play_blend2d", "layer does not allow blend2d: ", godot::String(p_layer->name));
 		return false;
 	}
 	if (p_layer->blend2d_points.is_empty()) {
-		godot::UtilityFunctions::printerr("native_anim.play_blend2d: no blend2d points configured: ", godot::String(p_layer->name));
+		LUAGD_REPORT_ERROR("native_anim", "play_blend2d", "no blend2d points configured: ", godot::String(p_layer->name));
 		return false;
 	}
 
@@ -460,7 +465,7 @@ static bool _assign_slot_blend2d(AnimatorRecord *p_animator, LayerRecord *p_laye
 	for (int32_t i = 0; i < p_layer->blend2d_points.size(); i++) {
 		const Blend2DPointRecord &point = p_layer->blend2d_points[i];
 		if (!_has_animation(p_animator, point.anim_name)) {
-			godot::UtilityFunctions::printerr("native_anim.play_blend2d: animation not found: ", godot::String(point.anim_name));
+			LUAGD_REPORT_ERROR("native_anim", "play_blend2d", "animation not found: ", godot::String(point.anim_name));
 			return false;
 		}
 
@@ -481,7 +486,7 @@ static bool _assign_slot_blend2d(AnimatorRecord *p_animator, LayerRecord *p_laye
 				anim_node->set_loop_mode(anim->get_loop_mode());
 			}
 		} else {
-			godot::UtilityFunctions::printerr("native_anim.play_blend2d: failed to get animation: ", godot::String(point.anim_name));
+			LUAGD_REPORT_ERROR("native_anim", "play_blend2d", "failed to get animation: ", godot::String(point.anim_name));
 		}
 
 		node->add_blend_point(anim_node, point.position);
@@ -520,7 +525,7 @@ static bool _read_slot_time_value(AnimatorRecord *p_animator, SlotRecord *p_slot
 	}
 	*r_value = 0.0;
 	if (p_animator == nullptr || p_animator->animation_tree == nullptr || p_slot == nullptr || p_slot->time_scale_node_name.is_empty()) {
-		godot::UtilityFunctions::printerr("native_anim.", p_func_name, ": active slot is not available");
+		LUAGD_REPORT_ERROR("native_anim", p_func_name, "active slot is not available");
 		return false;
 	}
 
@@ -528,7 +533,7 @@ static bool _read_slot_time_value(AnimatorRecord *p_animator, SlotRecord *p_slot
 	const godot::Variant value = p_animator->animation_tree->get(path);
 	const godot::Variant::Type value_type = value.get_type();
 	if (value_type != godot::Variant::FLOAT && value_type != godot::Variant::INT) {
-		godot::UtilityFunctions::printerr("native_anim.", p_func_name, ": failed to read tree parameter ", path);
+		LUAGD_REPORT_ERROR("native_anim", p_func_name, "failed to read tree parameter ", path);
 		return false;
 	}
 
@@ -654,10 +659,10 @@ static bool _remove_layer_nodes(AnimatorRecord *p_animator, LayerRecord *p_layer
 
 // 创建 Animator，并在宿主节点下创建内部 AnimationPlayer 和 AnimationTree。
 static int l_create_animator(lua_State *p_L) {
-	godot::ObjectID owner_node_id((uint64_t)luaL_checkinteger(p_L, 1));
+	const NodeHandle owner_node_id = node_check_handle(p_L, 1);
 	godot::Node *owner = node_resolve_any(owner_node_id);
 	if (owner == nullptr) {
-		godot::UtilityFunctions::printerr("native_anim.create_animator: invalid owner node id ", owner_node_id);
+		LUAGD_REPORT_ERROR("native_anim", "create_animator", "invalid owner node id ", owner_node_id);
 		lua_pushinteger(p_L, INVALID_ANIMATOR_ID);
 		return 1;
 	}
@@ -690,6 +695,8 @@ static int l_create_animator(lua_State *p_L) {
 	animator.tree_root->add_node(godot::StringName(BASE_NODE_NAME), base_node);
 	animator.tree_root->connect_node(godot::StringName("output"), 0, godot::StringName(BASE_NODE_NAME));
 
+	// 动画器存续期间保持宿主记录有效，传入的 userdata 被回收后仍能解析宿主
+	node_retain(owner_node_id);
 	animators[animator.id] = animator;
 	lua_pushinteger(p_L, animator.id);
 	return 1;
@@ -707,7 +714,9 @@ static int l_destroy_animator(lua_State *p_L) {
 	if (animator->animation_tree != nullptr) {
 		animator->animation_tree->queue_free();
 	}
+	const NodeHandle owner_node_id = animator->owner_node_id;
 	animators.erase(animator_id);
+	node_unretain(owner_node_id);
 	return 0;
 }
 
@@ -739,37 +748,37 @@ static int l_add_animation_library(lua_State *p_L) {
 
 	const godot::StringName library_name(library_name_cstr);
 	if (library_name == godot::StringName(INTERNAL_LIBRARY_NAME)) {
-		godot::UtilityFunctions::printerr("native_anim.add_animation_library: reserved library name: ", godot::String(library_name));
+		LUAGD_REPORT_ERROR("native_anim", "add_animation_library", "reserved library name: ", godot::String(library_name));
 		_push_bool(p_L, false);
 		return 1;
 	}
 	if (animator->libraries.has(library_name)) {
-		godot::UtilityFunctions::printerr("native_anim.add_animation_library: duplicated library: ", godot::String(library_name));
+		LUAGD_REPORT_ERROR("native_anim", "add_animation_library", "duplicated library: ", godot::String(library_name));
 		_push_bool(p_L, false);
 		return 1;
 	}
 
 	godot::Ref<godot::Resource> resource = godot::ResourceLoader::get_singleton()->load(godot::String(library_path_cstr));
 	if (resource.is_null()) {
-		godot::UtilityFunctions::printerr("native_anim.add_animation_library: failed to load resource: ", library_path_cstr);
+		LUAGD_REPORT_ERROR("native_anim", "add_animation_library", "failed to load resource: ", library_path_cstr);
 		_push_bool(p_L, false);
 		return 1;
 	}
 
 	godot::Ref<godot::AnimationLibrary> library = resource;
 	if (library.is_null()) {
-		godot::UtilityFunctions::printerr("native_anim.add_animation_library: resource is not AnimationLibrary: ", library_path_cstr);
+		LUAGD_REPORT_ERROR("native_anim", "add_animation_library", "resource is not AnimationLibrary: ", library_path_cstr);
 		_push_bool(p_L, false);
 		return 1;
 	}
 	if (animator->animation_player->add_animation_library(library_name, library) != godot::OK) {
-		godot::UtilityFunctions::printerr("native_anim.add_animation_library: failed to add library to player: ", library_path_cstr);
+		LUAGD_REPORT_ERROR("native_anim", "add_animation_library", "failed to add library to player: ", library_path_cstr);
 		_push_bool(p_L, false);
 		return 1;
 	}
 	if (animator->animation_tree->add_animation_library(library_name, library) != godot::OK) {
 		animator->animation_player->remove_animation_library(library_name);
-		godot::UtilityFunctions::printerr("native_anim.add_animation_library: failed to add library to tree: ", library_path_cstr);
+		LUAGD_REPORT_ERROR("native_anim", "add_animation_library", "failed to add library to tree: ", library_path_cstr);
 		_push_bool(p_L, false);
 		return 1;
 	}
@@ -792,14 +801,14 @@ static int l_create_layer(lua_State *p_L) {
 		return 1;
 	}
 	if (!_is_valid_mix_mode(mix_mode)) {
-		godot::UtilityFunctions::printerr("native_anim.create_layer: invalid mix_mode ", mix_mode);
+		LUAGD_REPORT_ERROR("native_anim", "create_layer", "invalid mix_mode ", mix_mode);
 		_push_bool(p_L, false);
 		return 1;
 	}
 
 	const godot::StringName layer_name(layer_name_cstr);
 	if (animator->layers.has(layer_name)) {
-		godot::UtilityFunctions::printerr("native_anim.create_layer: duplicated layer: ", godot::String(layer_name));
+		LUAGD_REPORT_ERROR("native_anim", "create_layer", "duplicated layer: ", godot::String(layer_name));
 		_push_bool(p_L, false);
 		return 1;
 	}
@@ -1233,6 +1242,7 @@ static int l_is_layer_looping(lua_State *p_L) {
 
 // 由 Lua 显式推进 fade 和 AnimationTree。
 static int l_update(lua_State *p_L) {
+	LUAGD_TRACE_ZONE("native_anim.update");
 	int32_t animator_id = (int32_t)luaL_checkinteger(p_L, 1);
 	double delta = luaL_checknumber(p_L, 2);
 	AnimatorRecord *animator = _get_animator(animator_id, "update");
@@ -1294,7 +1304,7 @@ static const luaL_Reg anim_funcs[] = {
 };
 
 int luaopen_native_anim(lua_State *p_L) {
-	luaL_newlib(p_L, anim_funcs);
+	lua_binding_new_lib(p_L, "native_anim", anim_funcs);
 	lua_pushinteger(p_L, MIX_BLEND);
 	lua_setfield(p_L, -2, "MIX_BLEND");
 	lua_pushinteger(p_L, MIX_ADD);
@@ -1306,7 +1316,29 @@ int luaopen_native_anim(lua_State *p_L) {
 	return 1;
 }
 
+void anim_collect_memory(godot::LocalVector<HostMemoryTable> &r_tables) {
+	int64_t bytes = host_memory_hash_map_bytes(animators);
+	for (const godot::KeyValue<int32_t, AnimatorRecord> &entry : animators) {
+		const AnimatorRecord &animator = entry.value;
+		bytes += host_memory_hash_map_bytes(animator.libraries);
+		bytes += host_memory_hash_map_bytes(animator.layers);
+		bytes += (int64_t)animator.layer_order.size() * (int64_t)sizeof(godot::StringName);
+		for (const godot::KeyValue<godot::StringName, LayerRecord> &layer : animator.layers) {
+			bytes += (int64_t)layer.value.mask_paths.size() * (int64_t)sizeof(godot::NodePath);
+			bytes += (int64_t)layer.value.blend2d_points.size() * (int64_t)sizeof(Blend2DPointRecord);
+		}
+	}
+	r_tables.push_back({"native_anim.animators", (int64_t)animators.size(), bytes});
+}
+
+int anim_get_animator_count() {
+	return (int)animators.size();
+}
+
 void anim_cleanup() {
+	for (const godot::KeyValue<int32_t, AnimatorRecord> &entry : animators) {
+		node_unretain(entry.value.owner_node_id);
+	}
 	animators.clear();
 	next_animator_id = 1;
 }
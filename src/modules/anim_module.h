@@ -1,6 +1,8 @@
 #ifndef LUAGD_ANIM_MODULE_H
 #define LUAGD_ANIM_MODULE_H
 
+#include "../host/host_memory_stats.h"
+
 struct lua_State;
 
 namespace luagd {
@@ -9,6 +11,12 @@ namespace luagd {
 // 提供 Animator / Layer 的基础动画控制 API。
 int luaopen_native_anim(lua_State *p_L);
 
+// 返回：存活的 Animator 记录数。
+int anim_get_animator_count();
+
+// 把模块表的条目数与估算字节数追加到 r_tables，供 host_memory_collect 使用。
+void anim_collect_memory(godot::LocalVector<HostMemoryTable> &r_tables);
+
 // 清理 native_anim 模块状态。
 // 释放模块创建的 Animator 运行时对象。
 void anim_cleanup();
@@ -1,6 +1,8 @@
 #include "audio_module.h"
 
+#include "../host/host_error_sink.h"
 #include "../host/host_thread_check.h"
+#include "../lua/lua_binding_stats.h"
 
 #include <godot_cpp/classes/audio_server.hpp>
 #include <godot_cpp/classes/audio_stream.hpp>
@@ -39,7 +41,7 @@ static bool initialized = false;
 // 获取播放器记录，不存在时打印错误
 static PlayerRecord *get_player(int32_t p_id, const char *p_func_name) {
 	if (!players.has(p_id)) {
-		godot::UtilityFunctions::printerr("native_audio.", p_func_name, ": invalid id ", p_id);
+		LUAGD_REPORT_ERROR("native_audio", p_func_name, "invalid id ", p_id);
 		return nullptr;
 	}
 	return &players[p_id];
@@ -97,7 +99,7 @@ static int l_init(lua_State *p_L) {
 		godot::Engine::get_singleton()->get_main_loop()
 	);
 	if (tree == nullptr) {
-		godot::UtilityFunctions::printerr("native_audio.init: SceneTree not available");
+		LUAGD_REPORT_ERROR("native_audio", "init", "SceneTree not available");
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
@@ -128,7 +130,7 @@ static int l_is_initialized(lua_State *p_L) {
 // 返回播放器 ID，失败返回 -1。
 static int l_create_player(lua_State *p_L) {
 	if (!initialized) {
-		godot::UtilityFunctions::printerr("native_audio.create_player: not initialized, call init() first");
+		LUAGD_REPORT_ERROR("native_audio", "create_player", "not initialized, call init() first");
 		lua_pushinteger(p_L, -1);
 		return 1;
 	}
@@ -187,7 +189,7 @@ static int l_set_stream(lua_State *p_L) {
 
 	godot::Ref<godot::AudioStream> stream = godot::ResourceLoader::get_singleton()->load(path);
 	if (stream.is_null()) {
-		godot::UtilityFunctions::printerr("native_audio.set_stream: failed to load ", path);
+		LUAGD_REPORT_ERROR("native_audio", "set_stream", "failed to load ", path);
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
@@ -362,7 +364,7 @@ static int l_set_position(lua_State *p_L) {
 	}
 
 	if (!rec->is_spatial) {
-		godot::UtilityFunctions::printerr("native_audio.set_position: player is not spatial, id ", id);
+		LUAGD_REPORT_ERROR("native_audio", "set_position", "player is not spatial, id ", id);
 		return 0;
 	}
 
@@ -383,7 +385,7 @@ static int l_set_attenuation_params(lua_State *p_L) {
 	}
 
 	if (!rec->is_spatial) {
-		godot::UtilityFunctions::printerr("native_audio.set_attenuation_params: player is not spatial, id ", id);
+		LUAGD_REPORT_ERROR("native_audio", "set_attenuation_params", "player is not spatial, id ", id);
 		return 0;
 	}
 
@@ -411,7 +413,7 @@ static int l_set_loop(lua_State *p_L) {
 	}
 
 	if (stream.is_null()) {
-		godot::UtilityFunctions::printerr("native_audio.set_loop: no stream set, id ", id);
+		LUAGD_REPORT_ERROR("native_audio", "set_loop", "no stream set, id ", id);
 		return 0;
 	}
 
@@ -429,7 +431,7 @@ static int l_set_loop(lua_State *p_L) {
 		return 0;
 	}
 
-	godot::UtilityFunctions::printerr("native_audio.set_loop: unsupported stream type, id ", id);
+	LUAGD_REPORT_ERROR("native_audio", "set_loop", "unsupported stream type, id ", id);
 	return 0;
 }
 
@@ -445,7 +447,7 @@ static int l_add_bus(lua_State *p_L) {
 
 	godot::AudioServer *audio_server = godot::AudioServer::get_singleton();
 	if (audio_server == nullptr) {
-		godot::UtilityFunctions::printerr("native_audio.add_bus: AudioServer not available");
+		LUAGD_REPORT_ERROR("native_audio", "add_bus", "AudioServer not available");
 		lua_pushinteger(p_L, -1);
 		return 1;
 	}
@@ -475,13 +477,13 @@ static int l_set_bus_volume(lua_State *p_L) {
 
 	godot::AudioServer *audio_server = godot::AudioServer::get_singleton();
 	if (audio_server == nullptr) {
-		godot::UtilityFunctions::printerr("native_audio.set_bus_volume: AudioServer not available");
+		LUAGD_REPORT_ERROR("native_audio", "set_bus_volume", "AudioServer not available");
 		return 0;
 	}
 
 	int32_t bus_idx = audio_server->get_bus_index(name);
 	if (bus_idx < 0) {
-		godot::UtilityFunctions::printerr("native_audio.set_bus_volume: bus not found: ", name);
+		LUAGD_REPORT_ERROR("native_audio", "set_bus_volume", "bus not found: ", name);
 		return 0;
 	}
 
@@ -497,14 +499,14 @@ static int l_get_bus_volume(lua_State *p_L) {
 
 	godot::AudioServer *audio_server = godot::AudioServer::get_singleton();
 	if (audio_server == nullptr) {
-		godot::UtilityFunctions::printerr("native_audio.get_bus_volume: AudioServer not available");
+		LUAGD_REPORT_ERROR("native_audio", "get_bus_volume", "AudioServer not available");
 		lua_pushnumber(p_L, 0.0);
 		return 1;
 	}
 
 	int32_t bus_idx = audio_server->get_bus_index(name);
 	if (bus_idx < 0) {
-		godot::UtilityFunctions::printerr("native_audio.get_bus_volume: bus not found: ", name);
+		LUAGD_REPORT_ERROR("native_audio", "get_bus_volume", "bus not found: ", name);
 		lua_pushnumber(p_L, 0.0);
 		return 1;
 	}
@@ -522,7 +524,7 @@ static int l_set_master_volume(lua_State *p_L) {
 
 	godot::AudioServer *audio_server = godot::AudioServer::get_singleton();
 	if (audio_server == nullptr) {
-		godot::UtilityFunctions::printerr("native_audio.set_master_volume: AudioServer not available");
+		LUAGD_REPORT_ERROR("native_audio", "set_master_volume", "AudioServer not available");
 		return 0;
 	}
 
@@ -536,7 +538,7 @@ static int l_set_master_volume(lua_State *p_L) {
 static int l_get_master_volume(lua_State *p_L) {
 	godot::AudioServer *audio_server = godot::AudioServer::get_singleton();
 	if (audio_server == nullptr) {
-		godot::UtilityFunctions::printerr("native_audio.get_master_volume: AudioServer not available");
+		LUAGD_REPORT_ERROR("native_audio", "get_master_volume", "AudioServer not available");
 		lua_pushnumber(p_L, 0.0);
 		return 1;
 	}
@@ -585,12 +587,20 @@ static const luaL_Reg audio_funcs[] = {
 };
 
 int luaopen_native_audio(lua_State *p_L) {
-	luaL_newlib(p_L, audio_funcs);
+	lua_binding_new_lib(p_L, "native_audio", audio_funcs);
 	return 1;
 }
 
+void audio_collect_memory(godot::LocalVector<HostMemoryTable> &r_tables) {
+	r_tables.push_back({"native_audio.players", (int64_t)players.size(), host_memory_hash_map_bytes(players)});
+}
+
+int audio_get_player_count() {
+	return (int)players.size();
+}
+
 void audio_cleanup() {
-	if (!ensure_main_thread("native_audio.audio_cleanup")) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_audio.audio_cleanup")) {
 		return;
 	}
 
@@ -1,6 +1,8 @@
 #ifndef LUAGD_AUDIO_MODULE_H
 #define LUAGD_AUDIO_MODULE_H
 
+#include "../host/host_memory_stats.h"
+
 struct lua_State;
 
 namespace luagd {
@@ -10,6 +12,12 @@ namespace luagd {
 // 返回：在 Lua 栈上返回 1（模块表）。
 int luaopen_native_audio(lua_State *p_L);
 
+// 返回：存活的播放器记录数。
+int audio_get_player_count();
+
+// 把模块表的条目数与估算字节数追加到 r_tables，供 host_memory_collect 使用。
+void audio_collect_memory(godot::LocalVector<HostMemoryTable> &r_tables);
+
 // 清理音频模块资源。
 // GDExtension 反初始化阶段只清理模块记录，场景对象交给引擎统一销毁。
 // 约束：只允许在主线程调用。
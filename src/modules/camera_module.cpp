@@ -1,7 +1,12 @@
 #include "camera_module.h"
 
+#include "math_module.h"
 #include "node_module.h"
 
+#include "../host/host_error_sink.h"
+#include "../host/host_thread_check.h"
+#include "../lua/lua_binding_stats.h"
+
 #include <godot_cpp/classes/camera3d.hpp>
 #include <godot_cpp/core/object.hpp>
 #include <godot_cpp/core/object_id.hpp>
@@ -14,25 +19,25 @@ extern "C" {
 
 namespace luagd {
 
-static godot::ObjectID _read_node_id(lua_State *p_L, int p_index) {
-	return godot::ObjectID((uint64_t)luaL_checkinteger(p_L, p_index));
+static NodeHandle _read_node_id(lua_State *p_L, int p_index) {
+	return node_check_handle(p_L, p_index);
 }
 
-static godot::Camera3D *_resolve_camera(godot::ObjectID p_node_id, const char *p_func_name) {
-	if (p_node_id.is_null()) {
-		godot::UtilityFunctions::printerr("native_camera.", p_func_name, ": node id is 0");
+static godot::Camera3D *_resolve_camera(NodeHandle p_node_id, const char *p_func_name) {
+	if (p_node_id == 0) {
+		LUAGD_REPORT_ERROR("native_camera", p_func_name, "node id is 0");
 		return nullptr;
 	}
 
 	godot::Node3D *node = node_resolve(p_node_id);
 	if (node == nullptr) {
-		godot::UtilityFunctions::printerr("native_camera.", p_func_name, ": node is no longer valid, id ", p_node_id);
+		LUAGD_REPORT_ERROR("native_camera", p_func_name, "node is no longer valid, id ", p_node_id);
 		return nullptr;
 	}
 
 	godot::Camera3D *camera = godot::Object::cast_to<godot::Camera3D>(node);
 	if (camera == nullptr) {
-		godot::UtilityFunctions::printerr("native_camera.", p_func_name, ": node is not Camera3D, id ", p_node_id);
+		LUAGD_REPORT_ERROR("native_camera", p_func_name, "node is not Camera3D, id ", p_node_id);
 		return nullptr;
 	}
 
@@ -42,7 +47,7 @@ static godot::Camera3D *_resolve_camera(godot::ObjectID p_node_id, const char *p
 // set_fov(node_id, fov) -> void
 // 设置相机视场角。
 static int l_set_fov(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	const double fov = luaL_checknumber(p_L, 2);
 
 	godot::Camera3D *camera = _resolve_camera(node_id, "set_fov");
@@ -57,7 +62,7 @@ static int l_set_fov(lua_State *p_L) {
 // get_fov(node_id) -> fov
 // 获取相机视场角。
 static int l_get_fov(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	godot::Camera3D *camera = _resolve_camera(node_id, "get_fov");
 	if (camera == nullptr) {
 		lua_pushnumber(p_L, 0);
@@ -69,19 +74,18 @@ static int l_get_fov(lua_State *p_L) {
 }
 
 // unproject_position(node_id, x, y, z) -> screen_x, screen_y
-// 将世界坐标投影为视口内 2D 屏幕坐标。
+// unproject_position(node_id, v) -> screen_x, screen_y
+// 将世界坐标投影为视口内 2D 屏幕坐标。世界坐标可为 native_math.Vector3。
 static int l_unproject_position(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
-	const double x = luaL_checknumber(p_L, 2);
-	const double y = luaL_checknumber(p_L, 3);
-	const double z = luaL_checknumber(p_L, 4);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
+	godot::Vector3 world_point;
+	math_check_vector3(p_L, 2, world_point);
 
 	godot::Camera3D *camera = _resolve_camera(node_id, "unproject_position");
 	if (camera == nullptr) {
 		return 0;
 	}
 
-	const godot::Vector3 world_point((float)x, (float)y, (float)z);
 	const godot::Vector2 screen_point = camera->unproject_position(world_point);
 	lua_pushnumber(p_L, screen_point.x);
 	lua_pushnumber(p_L, screen_point.y);
@@ -95,8 +99,17 @@ static const luaL_Reg camera_funcs[] = {
 	{nullptr, nullptr}
 };
 
+// 以节点为第一个参数、作为 native_node.Node 方法暴露的函数
+static const char *const camera_node_methods[] = {
+	"set_fov",
+	"get_fov",
+	"unproject_position",
+	nullptr
+};
+
 int luaopen_native_camera(lua_State *p_L) {
-	luaL_newlib(p_L, camera_funcs);
+	lua_binding_new_lib(p_L, "native_camera", camera_funcs);
+	node_register_methods(p_L, -1, camera_node_methods);
 	return 1;
 }
 
@@ -1,5 +1,9 @@
 #include "collision_module.h"
 
+#include "../host/host_error_sink.h"
+#include "../host/host_thread_check.h"
+#include "../host/host_trace.h"
+#include "../lua/lua_binding_stats.h"
 #include "../lua/lua_signal_binding.h"
 #include "node_module.h"
 
@@ -98,19 +102,19 @@ void TriggerSignalReceiver::on_body_exited(godot::Node3D *p_body) {
 	lua_signal_binding_call_no_return(lua_state, 2, "trigger.body_exited");
 }
 
-static godot::ObjectID _read_node_id(lua_State *p_L, int p_index) {
-	return godot::ObjectID((uint64_t)luaL_checkinteger(p_L, p_index));
+static NodeHandle _read_node_id(lua_State *p_L, int p_index) {
+	return node_check_handle(p_L, p_index);
 }
 
-static godot::Node3D *_resolve_node(godot::ObjectID p_node_id, const char *p_func_name) {
-	if (p_node_id.is_null()) {
-		godot::UtilityFunctions::printerr("native_collision.", p_func_name, ": node id is 0");
+static godot::Node3D *_resolve_node(NodeHandle p_node_id, const char *p_func_name) {
+	if (p_node_id == 0) {
+		LUAGD_REPORT_ERROR("native_collision", p_func_name, "node id is 0");
 		return nullptr;
 	}
 
 	godot::Node3D *node = node_resolve(p_node_id);
 	if (node == nullptr) {
-		godot::UtilityFunctions::printerr("native_collision.", p_func_name, ": node is no longer valid, id ", p_node_id);
+		LUAGD_REPORT_ERROR("native_collision", p_func_name, "node is no longer valid, id ", p_node_id);
 		return nullptr;
 	}
 
@@ -206,7 +210,7 @@ static bool _try_get_node_aabb(godot::Node3D *p_node, godot::AABB *r_aabb) {
 // 获取主碰撞体在节点自身坐标系下的 AABB。
 // 节点本身不是碰撞体时，自动查找直接子节点中的碰撞体。
 static int l_get_aabb(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	godot::Node3D *node = _resolve_node(node_id, "get_aabb");
 	if (node == nullptr) {
 		return _push_zero_aabb(p_L);
@@ -271,6 +275,7 @@ static bool _perform_shape_query(
 		double p_sector_angle,         // 度
 		int p_callback_index,
 		godot::RBSet<uint64_t> *p_processed_ids) {  // nullptr = 不去重
+	LUAGD_TRACE_ZONE("native_collision.shape_query");
 
 	cached_query_params->set_shape(p_shape);
 	cached_query_params->set_transform(p_transform);
@@ -278,13 +283,13 @@ static bool _perform_shape_query(
 
 	godot::Ref<godot::World3D> world = p_reference_node->get_world_3d();
 	if (world.is_null()) {
-		godot::UtilityFunctions::printerr("native_collision: reference node not in world");
+		LUAGD_REPORT_ERROR("native_collision", "shape_query", "reference node not in world");
 		return false;
 	}
 
 	godot::PhysicsDirectSpaceState3D *space_state = world->get_direct_space_state();
 	if (!space_state) {
-		godot::UtilityFunctions::printerr("native_collision: failed to get space state");
+		LUAGD_REPORT_ERROR("native_collision", "shape_query", "failed to get space state");
 		return false;
 	}
 
@@ -338,7 +343,7 @@ static bool _perform_shape_query(
 		lua_pushinteger(p_L, target_id);
 
 		if (lua_pcall(p_L, 1, 1, 0) != LUA_OK) {
-			godot::UtilityFunctions::printerr("native_collision: callback error: ", lua_tostring(p_L, -1));
+			LUAGD_REPORT_ERROR("native_collision", "shape_query", "callback error: ", lua_tostring(p_L, -1));
 			lua_pop(p_L, 1);
 			return false;
 		}
@@ -434,11 +439,11 @@ static bool _process_single_hitbox(
 static int l_intersect_cylinder(lua_State *p_L) {
 	int argc = lua_gettop(p_L);
 	if (argc < 12) {
-		godot::UtilityFunctions::printerr("native_collision.intersect_cylinder: expected 12 args, got ", argc);
+		LUAGD_REPORT_ERROR("native_collision", "intersect_cylinder", "expected 12 args, got ", argc);
 		return 0;
 	}
 
-	godot::ObjectID node_id = _read_node_id(p_L, 1);
+	NodeHandle node_id = _read_node_id(p_L, 1);
 
 	godot::Vector3 position(
 			(float)luaL_checknumber(p_L, 2),
@@ -450,7 +455,7 @@ static int l_intersect_cylinder(lua_State *p_L) {
 			(float)luaL_checknumber(p_L, 7));
 
 	if (forward.length_squared() < 0.001) {
-		godot::UtilityFunctions::printerr("native_collision.intersect_cylinder: forward vector is zero");
+		LUAGD_REPORT_ERROR("native_collision", "intersect_cylinder", "forward vector is zero");
 		return 0;
 	}
 
@@ -498,11 +503,11 @@ static int l_intersect_cylinder(lua_State *p_L) {
 static int l_intersect_box(lua_State *p_L) {
 	int argc = lua_gettop(p_L);
 	if (argc < 12) {
-		godot::UtilityFunctions::printerr("native_collision.intersect_box: expected 12 args, got ", argc);
+		LUAGD_REPORT_ERROR("native_collision", "intersect_box", "expected 12 args, got ", argc);
 		return 0;
 	}
 
-	godot::ObjectID node_id = _read_node_id(p_L, 1);
+	NodeHandle node_id = _read_node_id(p_L, 1);
 
 	godot::Vector3 position(
 			(float)luaL_checknumber(p_L, 2),
@@ -563,12 +568,12 @@ static int l_intersect_hitbox(lua_State *p_L) {
 	// 1. 参数校验
 	int argc = lua_gettop(p_L);
 	if (argc < 3) {
-		godot::UtilityFunctions::printerr("native_collision.intersect_hitbox: expected 3 args (node_id, collision_mask, callback), got ", argc);
+		LUAGD_REPORT_ERROR("native_collision", "intersect_hitbox", "expected 3 args (node_id, collision_mask, callback), got ", argc);
 		return 0;
 	}
 
 	// 2. 解析参数
-	godot::ObjectID node_id = _read_node_id(p_L, 1);
+	NodeHandle node_id = _read_node_id(p_L, 1);
 	uint32_t collision_mask = (uint32_t)luaL_checkinteger(p_L, 2);
 	luaL_checktype(p_L, 3, LUA_TFUNCTION);
 
@@ -636,12 +641,12 @@ static int l_set_hitbox_active(lua_State *p_L) {
 	// 1. 参数校验
 	int argc = lua_gettop(p_L);
 	if (argc < 2) {
-		godot::UtilityFunctions::printerr("native_collision.set_hitbox_active: expected 2 args (node_id, active), got ", argc);
+		LUAGD_REPORT_ERROR("native_collision", "set_hitbox_active", "expected 2 args (node_id, active), got ", argc);
 		return 0;
 	}
 
 	// 2. 解析参数
-	godot::ObjectID node_id = _read_node_id(p_L, 1);
+	NodeHandle node_id = _read_node_id(p_L, 1);
 	bool active = lua_toboolean(p_L, 2);
 
 	// 3. 解析节点
@@ -682,11 +687,11 @@ static int l_set_hitbox_active(lua_State *p_L) {
 static int l_set_trigger_callback(lua_State *p_L) {
 	int argc = lua_gettop(p_L);
 	if (argc < 2) {
-		godot::UtilityFunctions::printerr("native_collision.set_trigger_callback: expected 2 args (area_id, callback), got ", argc);
+		LUAGD_REPORT_ERROR("native_collision", "set_trigger_callback", "expected 2 args (area_id, callback), got ", argc);
 		return 0;
 	}
 
-	godot::ObjectID area_id = _read_node_id(p_L, 1);
+	NodeHandle area_id = _read_node_id(p_L, 1);
 	luaL_checktype(p_L, 2, LUA_TFUNCTION);
 
 	godot::Node3D *node = _resolve_node(area_id, "set_trigger_callback");
@@ -696,7 +701,7 @@ static int l_set_trigger_callback(lua_State *p_L) {
 
 	godot::Area3D *area = godot::Object::cast_to<godot::Area3D>(node);
 	if (!area) {
-		godot::UtilityFunctions::printerr("native_collision.set_trigger_callback: node is not an Area3D, id ", area_id);
+		LUAGD_REPORT_ERROR("native_collision", "set_trigger_callback", "node is not an Area3D, id ", area_id);
 		return 0;
 	}
 
@@ -746,11 +751,11 @@ static int l_set_trigger_callback(lua_State *p_L) {
 static int l_set_trigger_size(lua_State *p_L) {
 	int argc = lua_gettop(p_L);
 	if (argc < 4) {
-		godot::UtilityFunctions::printerr("native_collision.set_trigger_size: expected 4 args (area_id, size_x, size_y, size_z), got ", argc);
+		LUAGD_REPORT_ERROR("native_collision", "set_trigger_size", "expected 4 args (area_id, size_x, size_y, size_z), got ", argc);
 		return 0;
 	}
 
-	godot::ObjectID area_id = _read_node_id(p_L, 1);
+	NodeHandle area_id = _read_node_id(p_L, 1);
 	godot::Vector3 scale(
 			(float)luaL_checknumber(p_L, 2),
 			(float)luaL_checknumber(p_L, 3),
@@ -763,7 +768,7 @@ static int l_set_trigger_size(lua_State *p_L) {
 
 	godot::Area3D *area = godot::Object::cast_to<godot::Area3D>(node);
 	if (!area) {
-		godot::UtilityFunctions::printerr("native_collision.set_trigger_size: node is not an Area3D, id ", area_id);
+		LUAGD_REPORT_ERROR("native_collision", "set_trigger_size", "node is not an Area3D, id ", area_id);
 		return 0;
 	}
 
@@ -779,7 +784,7 @@ static int l_set_trigger_size(lua_State *p_L) {
 	}
 
 	if (count == 0) {
-		godot::UtilityFunctions::printerr("native_collision.set_trigger_size: no CollisionShape3D child found, id ", area_id);
+		LUAGD_REPORT_ERROR("native_collision", "set_trigger_size", "no CollisionShape3D child found, id ", area_id);
 	}
 
 	return 0;
@@ -797,7 +802,7 @@ static const luaL_Reg collision_funcs[] = {
 };
 
 int luaopen_native_collision(lua_State *p_L) {
-	luaL_newlib(p_L, collision_funcs);
+	lua_binding_new_lib(p_L, "native_collision", collision_funcs);
 	return 1;
 }
 
@@ -1,10 +1,21 @@
 #include "core_module.h"
 
+#include "../host/host_error_sink.h"
+#include "../host/host_interpolation.h"
 #include "../host/host_thread_check.h"
+#include "../host/host_trace.h"
+#include "../lua/lua_alloc_profiler.h"
+#include "../lua/lua_binding_stats.h"
+#include "../lua/lua_float_buffer.h"
+#include "../lua/lua_runtime.h"
 
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <godot_cpp/classes/engine.hpp>
 #include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+
+#include <algorithm>
 
 extern "C" {
 #include <lua.h>
@@ -14,43 +25,243 @@ extern "C" {
 namespace luagd {
 
 // Lua registry 键名，用于存储回调函数引用
-static const char *UPDATE_CALLBACK_KEY = "native_core.update_callback";
 static const char *SHUTDOWN_CALLBACK_KEY = "native_core.shutdown_callback";
 
+// ---------------------------------------------------------------------------
+// 分阶段回调
+// 每个阶段持有按优先级排序的回调列表（registry 整数引用），由一个原生循环派发，
+// 所有回调共用同一个错误处理函数。派发期间的注册请求延迟到本次派发结束后生效，
+// 注销请求立即屏蔽该回调、延迟到派发结束后移除。
+// ---------------------------------------------------------------------------
+
+static const char *PHASE_NAMES[CORE_PHASE_COUNT] = {
+	"pre_physics",
+	"physics",
+	"process",
+	"late",
+	"render_prep",
+};
+
+struct PhaseCallback {
+	int64_t id;
+	int callback_ref;
+	int priority;
+	// 派发期间被注销，派发结束后移除
+	bool removed;
+};
+
+struct PhaseRequest {
+	int64_t id;
+	int phase;
+	int callback_ref;
+	int priority;
+};
+
+static godot::LocalVector<PhaseCallback> phase_callbacks[CORE_PHASE_COUNT];
+// 回调 id -> 所属阶段（含尚未生效的注册请求）
+static godot::HashMap<int64_t, int> phase_callback_phases;
+// 派发期间的注册请求；注销请求直接标记 removed
+static godot::LocalVector<PhaseRequest> phase_requests;
+static bool phase_dispatching = false;
+static bool phase_has_removed = false;
+static int64_t next_phase_callback_id = 1;
+// bind_update 绑定的回调 id，重新绑定时替换
+static int64_t update_callback_id = 0;
+
+// 按优先级插入，相同优先级保持注册顺序
+static void _insert_phase_callback(const PhaseRequest &p_request) {
+	godot::LocalVector<PhaseCallback> &list = phase_callbacks[p_request.phase];
+	uint32_t position = list.size();
+	for (uint32_t i = 0; i < list.size(); i++) {
+		if (list[i].priority > p_request.priority) {
+			position = i;
+			break;
+		}
+	}
+	list.insert(position, {p_request.id, p_request.callback_ref, p_request.priority, false});
+}
+
+static int64_t _add_phase_callback(lua_State *p_L, int p_phase, int p_func_index, int p_priority) {
+	const int64_t id = next_phase_callback_id++;
+	lua_pushvalue(p_L, p_func_index);
+	const PhaseRequest request = {id, p_phase, luaL_ref(p_L, LUA_REGISTRYINDEX), p_priority};
+	phase_callback_phases.insert(id, p_phase);
+
+	if (phase_dispatching) {
+		phase_requests.push_back(request);
+	} else {
+		_insert_phase_callback(request);
+	}
+	return id;
+}
+
+static bool _remove_phase_callback(lua_State *p_L, int64_t p_id) {
+	const int *phase = phase_callback_phases.getptr(p_id);
+	if (phase == nullptr) {
+		return false;
+	}
+	godot::LocalVector<PhaseCallback> &list = phase_callbacks[*phase];
+	phase_callback_phases.erase(p_id);
+
+	// 尚未生效的注册请求直接撤销
+	for (uint32_t i = 0; i < phase_requests.size(); i++) {
+		if (phase_requests[i].id == p_id) {
+			luaL_unref(p_L, LUA_REGISTRYINDEX, phase_requests[i].callback_ref);
+			phase_requests.remove_at(i);
+			return true;
+		}
+	}
+
+	for (uint32_t i = 0; i < list.size(); i++) {
+		if (list[i].id != p_id) {
+			continue;
+		}
+		if (phase_dispatching) {
+			list[i].removed = true;
+			phase_has_removed = true;
+		} else {
+			luaL_unref(p_L, LUA_REGISTRYINDEX, list[i].callback_ref);
+			list.remove_at(i);
+		}
+		return true;
+	}
+	return false;
+}
+
+// 派发结束后应用延迟的注册与注销请求
+static void _flush_phase_requests(lua_State *p_L) {
+	if (phase_has_removed) {
+		for (int phase = 0; phase < CORE_PHASE_COUNT; phase++) {
+			godot::LocalVector<PhaseCallback> &list = phase_callbacks[phase];
+			uint32_t write = 0;
+			for (uint32_t read = 0; read < list.size(); read++) {
+				if (list[read].removed) {
+					luaL_unref(p_L, LUA_REGISTRYINDEX, list[read].callback_ref);
+					continue;
+				}
+				list[write++] = list[read];
+			}
+			list.resize(write);
+		}
+		phase_has_removed = false;
+	}
+
+	for (uint32_t i = 0; i < phase_requests.size(); i++) {
+		_insert_phase_callback(phase_requests[i]);
+	}
+	phase_requests.clear();
+}
+
+// 依次派发 [p_first, p_last] 阶段。
+// 返回：全部成功返回 0，否则返回第一个失败回调的错误码。
+static int _run_phases(lua_State *p_L, int p_first, int p_last, double p_delta) {
+	bool has_callbacks = false;
+	for (int phase = p_first; phase <= p_last; phase++) {
+		if (!phase_callbacks[phase].is_empty()) {
+			has_callbacks = true;
+			break;
+		}
+	}
+	if (!has_callbacks) {
+		return 0;
+	}
+
+	lua_pushcfunction(p_L, lua_traceback_handler);
+	const int handler_index = lua_gettop(p_L);
+	int result = 0;
+
+	phase_dispatching = true;
+	for (int phase = p_first; phase <= p_last; phase++) {
+		// 派发期间列表不会增删元素，下标保持有效
+		const godot::LocalVector<PhaseCallback> &list = phase_callbacks[phase];
+		for (uint32_t i = 0; i < list.size(); i++) {
+			if (list[i].removed) {
+				continue;
+			}
+			lua_rawgeti(p_L, LUA_REGISTRYINDEX, list[i].callback_ref);
+			lua_pushnumber(p_L, p_delta);
+			const int call_result = lua_pcall(p_L, 1, 0, handler_index);
+			if (call_result != LUA_OK) {
+				const char *err = lua_tostring(p_L, -1);
+				// 按阶段分别计数，同一回调每帧出错时按间隔限流
+				LUAGD_REPORT_ERROR("native_core", PHASE_NAMES[phase], "callback error: ", err ? err : "(unknown)");
+				lua_pop(p_L, 1);
+				if (result == 0) {
+					result = call_result;
+				}
+			}
+		}
+	}
+	phase_dispatching = false;
+
+	lua_pop(p_L, 1);
+	_flush_phase_requests(p_L);
+	return result;
+}
+
 // native_core.bind_update(func) -> void
-// 绑定 update 回调函数。
+// 绑定 update 回调函数，等价于在 PHYSICS 阶段以优先级 0 注册；重复调用时替换上一次绑定。
 // func: 接收 delta 参数的函数。
 static int l_bind_update(lua_State *p_L) {
 	int argc = lua_gettop(p_L);
 	if (argc < 1) {
-		godot::UtilityFunctions::printerr("native_core.bind_update: expected 1 argument (function), got ", argc);
+		LUAGD_REPORT_ERROR("native_core", "bind_update", "expected 1 argument (function), got ", argc);
 		return 0;
 	}
 
 	if (!lua_isfunction(p_L, 1)) {
-		godot::UtilityFunctions::printerr("native_core.bind_update: argument must be a function");
+		LUAGD_REPORT_ERROR("native_core", "bind_update", "argument must be a function");
 		return 0;
 	}
 
-	// 将函数存储到 registry
-	lua_pushvalue(p_L, 1);  // 复制函数到栈顶
-	lua_setfield(p_L, LUA_REGISTRYINDEX, UPDATE_CALLBACK_KEY);
+	if (update_callback_id != 0) {
+		_remove_phase_callback(p_L, update_callback_id);
+	}
+	update_callback_id = _add_phase_callback(p_L, CORE_PHASE_PHYSICS, 1, 0);
 
 	return 0;
 }
 
+// native_core.bind_phase(phase, func, priority) -> integer
+// 在指定阶段注册回调，func 接收 delta 参数。
+// priority: 数值小的先执行，相同优先级按注册顺序，默认 0。
+// 派发期间注册的回调从下一次派发开始生效。
+// 返回：回调 id，用于 unbind_phase。
+static int l_bind_phase(lua_State *p_L) {
+	const lua_Integer phase = luaL_checkinteger(p_L, 1);
+	luaL_argcheck(p_L, phase >= 0 && phase < CORE_PHASE_COUNT, 1, "invalid phase");
+	luaL_checktype(p_L, 2, LUA_TFUNCTION);
+	const int priority = (int)luaL_optinteger(p_L, 3, 0);
+
+	lua_pushinteger(p_L, _add_phase_callback(p_L, (int)phase, 2, priority));
+	return 1;
+}
+
+// native_core.unbind_phase(id) -> bool
+// 注销回调；派发期间注销时本次派发中不再调用。
+// 返回：id 有效时返回 true。
+static int l_unbind_phase(lua_State *p_L) {
+	const int64_t id = (int64_t)luaL_checkinteger(p_L, 1);
+	const bool removed = _remove_phase_callback(p_L, id);
+	if (removed && id == update_callback_id) {
+		update_callback_id = 0;
+	}
+	lua_pushboolean(p_L, removed);
+	return 1;
+}
+
 // native_core.bind_shutdown(func) -> void
 // 绑定 shutdown 回调函数。
 // func: 无参函数。
 static int l_bind_shutdown(lua_State *p_L) {
 	int argc = lua_gettop(p_L);
 	if (argc < 1) {
-		godot::UtilityFunctions::printerr("native_core.bind_shutdown: expected 1 argument (function), got ", argc);
+		LUAGD_REPORT_ERROR("native_core", "bind_shutdown", "expected 1 argument (function), got ", argc);
 		return 0;
 	}
 
 	if (!lua_isfunction(p_L, 1)) {
-		godot::UtilityFunctions::printerr("native_core.bind_shutdown: argument must be a function");
+		LUAGD_REPORT_ERROR("native_core", "bind_shutdown", "argument must be a function");
 		return 0;
 	}
 
@@ -82,7 +293,7 @@ static int l_quit(lua_State *p_L) {
 static int l_set_time_scale(lua_State *p_L) {
 	int argc = lua_gettop(p_L);
 	if (argc < 1) {
-		godot::UtilityFunctions::printerr("native_core.set_time_scale: expected 1 argument (number), got ", argc);
+		LUAGD_REPORT_ERROR("native_core", "set_time_scale", "expected 1 argument (number), got ", argc);
 		return 0;
 	}
 
@@ -100,59 +311,423 @@ static int l_get_time_scale(lua_State *p_L) {
 	return 1;
 }
 
+// ---------------------------------------------------------------------------
+// 固定步长
+// 累加器由 LuaHost 持有，这里只保存供 Lua 查询的当前值。
+// ---------------------------------------------------------------------------
+
+static double frame_fixed_delta = 0.0;
+static double frame_interpolation_alpha = 1.0;
+
+// native_core.get_fixed_delta() -> number
+// 返回：固定步长（秒）；未启用固定步长时返回 0。
+static int l_get_fixed_delta(lua_State *p_L) {
+	lua_pushnumber(p_L, frame_fixed_delta);
+	return 1;
+}
+
+// native_core.get_interpolation_alpha() -> number
+// 返回：当前渲染帧位于最近两个固定步之间的比例（0..1）；未启用固定步长时返回 1。
+static int l_get_interpolation_alpha(lua_State *p_L) {
+	lua_pushnumber(p_L, frame_interpolation_alpha);
+	return 1;
+}
+
+// native_core.interpolate(node_id, enabled) -> bool
+// 登记 / 取消 Node3D 的原生变换插值。启用固定步长后，渲染帧在最近两个固定步的局部变换之间插值。
+// 约束：登记的节点只应在固定步（PRE_PHYSICS / PHYSICS 阶段与协程、定时器）中移动。
+// enabled: 默认 true。
+// 返回：操作成功返回 true。
+static int l_interpolate(lua_State *p_L) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_core.interpolate")) {
+		lua_pushboolean(p_L, 0);
+		return 1;
+	}
+
+	const NodeHandle node_id = node_check_handle(p_L, 1);
+	const bool enabled = lua_isnoneornil(p_L, 2) ? true : lua_toboolean(p_L, 2);
+	const bool ok = enabled ? host_interpolation_add(node_id) : host_interpolation_remove(node_id);
+	lua_pushboolean(p_L, ok);
+	return 1;
+}
+
+// native_core.reset_interpolation(node_id) -> bool
+// 以节点当前变换重置插值快照，用于瞬移。
+// 返回：节点已登记时返回 true。
+static int l_reset_interpolation(lua_State *p_L) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_core.reset_interpolation")) {
+		lua_pushboolean(p_L, 0);
+		return 1;
+	}
+
+	const NodeHandle node_id = node_check_handle(p_L, 1);
+	lua_pushboolean(p_L, host_interpolation_reset(node_id));
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+// 协程调度器
+// 挂起的协程按唤醒时间 / 唤醒帧放入最小堆，或挂在信号等待表上；tick 只恢复到期的协程，
+// 休眠中的协程每帧没有任何开销。
+// ---------------------------------------------------------------------------
+
+enum CoroutineWait {
+	COROUTINE_WAIT_NONE = 0,
+	COROUTINE_WAIT_FRAMES = 1,
+	COROUTINE_WAIT_SECONDS = 2,
+	COROUTINE_WAIT_SIGNAL = 3,
+	COROUTINE_WAIT_READY = 4,
+};
+
+struct CoroutineTask {
+	lua_State *thread;
+	int thread_ref;
+	CoroutineWait wait;
+	// 每次挂起递增；堆与等待表中 token 不一致的条目视为过期
+	uint64_t wait_token;
+	// READY 状态下已移入协程栈、待作为 resume 参数的值个数
+	int resume_arg_count;
+	bool running;
+	bool cancelled;
+};
+
+struct CoroutineTimeEntry {
+	double wake_time;
+	int64_t task_id;
+	uint64_t token;
+};
+
+struct CoroutineFrameEntry {
+	uint64_t wake_frame;
+	int64_t task_id;
+	uint64_t token;
+};
+
+struct CoroutineWaiter {
+	int64_t task_id;
+	uint64_t token;
+};
+
+static godot::HashMap<int64_t, CoroutineTask> coroutine_tasks;
+static godot::HashMap<lua_State *, int64_t> coroutine_ids;
+static godot::LocalVector<CoroutineTimeEntry> time_heap;
+static godot::LocalVector<CoroutineFrameEntry> frame_heap;
+static godot::HashMap<godot::String, godot::LocalVector<CoroutineWaiter>> signal_waiters;
+static godot::LocalVector<CoroutineWaiter> ready_list;
+static int64_t next_coroutine_id = 1;
+static uint64_t scheduler_frame = 0;
+static double scheduler_time = 0.0;
+
+// 最小堆比较器（std::push_heap 默认是最大堆）
+static bool _time_entry_later(const CoroutineTimeEntry &p_a, const CoroutineTimeEntry &p_b) {
+	return p_a.wake_time > p_b.wake_time;
+}
+
+static bool _frame_entry_later(const CoroutineFrameEntry &p_a, const CoroutineFrameEntry &p_b) {
+	return p_a.wake_frame > p_b.wake_frame;
+}
+
+// 返回当前协程对应的调度任务；不在 spawn 创建的协程中调用时抛出 Lua 错误。
+static CoroutineTask *_current_task(lua_State *p_L, const char *p_func_name, int64_t *r_task_id) {
+	const int64_t *task_id = coroutine_ids.getptr(p_L);
+	if (task_id == nullptr) {
+		luaL_error(p_L, "native_core.%s: must be called from a coroutine started by native_core.spawn", p_func_name);
+		return nullptr;
+	}
+	*r_task_id = *task_id;
+	return coroutine_tasks.getptr(*task_id);
+}
+
+static void _remove_task(lua_State *p_L, int64_t p_task_id) {
+	CoroutineTask *task = coroutine_tasks.getptr(p_task_id);
+	if (task == nullptr) {
+		return;
+	}
+	coroutine_ids.erase(task->thread);
+	luaL_unref(p_L, LUA_REGISTRYINDEX, task->thread_ref);
+	coroutine_tasks.erase(p_task_id);
+}
+
+// 恢复协程并根据结果更新任务状态。
+// p_arg_count: 已位于协程栈顶、作为 resume 参数的值个数。
+static void _resume_task(lua_State *p_L, int64_t p_task_id, int p_arg_count) {
+	CoroutineTask *task = coroutine_tasks.getptr(p_task_id);
+	if (task == nullptr) {
+		return;
+	}
+
+	lua_State *thread = task->thread;
+	task->wait = COROUTINE_WAIT_NONE;
+	task->running = true;
+
+	int result_count = 0;
+	lua_State *previous_thread = lua_alloc_profiler_set_thread(thread);
+	const int status = lua_resume(thread, p_L, p_arg_count, &result_count);
+	lua_alloc_profiler_set_thread(previous_thread);
+
+	// resume 期间可能有新任务插入，哈希表可能重排，重新查找
+	task = coroutine_tasks.getptr(p_task_id);
+	task->running = false;
+
+	if (status == LUA_YIELD) {
+		lua_pop(thread, result_count);
+		if (task->cancelled) {
+			_remove_task(p_L, p_task_id);
+		} else if (task->wait == COROUTINE_WAIT_NONE) {
+			// 直接调用 coroutine.yield() 视为等待一帧
+			task->wait = COROUTINE_WAIT_FRAMES;
+			task->wait_token += 1;
+			frame_heap.push_back({scheduler_frame + 1, p_task_id, task->wait_token});
+			std::push_heap(frame_heap.ptr(), frame_heap.ptr() + frame_heap.size(), _frame_entry_later);
+		}
+		return;
+	}
+
+	if (status != LUA_OK) {
+		const char *err = lua_tostring(thread, -1);
+		luaL_traceback(p_L, thread, err ? err : "(error object is not a string)", 0);
+		LUAGD_REPORT_ERROR("native_core", "coroutine", lua_tostring(p_L, -1));
+		lua_pop(p_L, 1);
+	}
+	_remove_task(p_L, p_task_id);
+}
+
+// native_core.spawn(func, ...) -> integer
+// 创建协程并立即运行到第一次等待。
+// 返回：协程句柄，可用于 cancel / is_alive。
+static int l_spawn(lua_State *p_L) {
+	luaL_checktype(p_L, 1, LUA_TFUNCTION);
+	const int arg_count = lua_gettop(p_L) - 1;
+
+	lua_State *thread = lua_newthread(p_L);
+	lua_insert(p_L, 1);
+	// 将函数与参数移入新协程，栈上只剩 thread
+	lua_xmove(p_L, thread, arg_count + 1);
+	const int thread_ref = luaL_ref(p_L, LUA_REGISTRYINDEX);
+
+	const int64_t task_id = next_coroutine_id++;
+	CoroutineTask task;
+	task.thread = thread;
+	task.thread_ref = thread_ref;
+	task.wait = COROUTINE_WAIT_NONE;
+	task.wait_token = 0;
+	task.resume_arg_count = 0;
+	task.running = false;
+	task.cancelled = false;
+	coroutine_tasks[task_id] = task;
+	coroutine_ids[thread] = task_id;
+
+	_resume_task(p_L, task_id, arg_count);
+
+	lua_pushinteger(p_L, (lua_Integer)task_id);
+	return 1;
+}
+
+// native_core.wait_frames([n]) -> void
+// 挂起当前协程 n 帧（默认 1，最少 1）。
+static int l_wait_frames(lua_State *p_L) {
+	int64_t task_id = 0;
+	CoroutineTask *task = _current_task(p_L, "wait_frames", &task_id);
+	lua_Integer frames = luaL_optinteger(p_L, 1, 1);
+	if (frames < 1) {
+		frames = 1;
+	}
+
+	task->wait = COROUTINE_WAIT_FRAMES;
+	task->wait_token += 1;
+	frame_heap.push_back({scheduler_frame + (uint64_t)frames, task_id, task->wait_token});
+	std::push_heap(frame_heap.ptr(), frame_heap.ptr() + frame_heap.size(), _frame_entry_later);
+	return lua_yield(p_L, 0);
+}
+
+// native_core.wait_seconds(seconds) -> void
+// 挂起当前协程指定的游戏时间（tick 的 delta 累计）。<= 0 时等待一帧。
+static int l_wait_seconds(lua_State *p_L) {
+	int64_t task_id = 0;
+	CoroutineTask *task = _current_task(p_L, "wait_seconds", &task_id);
+	const double seconds = luaL_checknumber(p_L, 1);
+
+	task->wait_token += 1;
+	if (seconds <= 0.0) {
+		task->wait = COROUTINE_WAIT_FRAMES;
+		frame_heap.push_back({scheduler_frame + 1, task_id, task->wait_token});
+		std::push_heap(frame_heap.ptr(), frame_heap.ptr() + frame_heap.size(), _frame_entry_later);
+		return lua_yield(p_L, 0);
+	}
+
+	task->wait = COROUTINE_WAIT_SECONDS;
+	time_heap.push_back({scheduler_time + seconds, task_id, task->wait_token});
+	std::push_heap(time_heap.ptr(), time_heap.ptr() + time_heap.size(), _time_entry_later);
+	return lua_yield(p_L, 0);
+}
+
+// native_core.wait_signal(name) -> ...
+// 挂起当前协程直到 emit_signal(name, ...) 被调用。
+// 返回：emit_signal 传入的参数。
+static int l_wait_signal(lua_State *p_L) {
+	int64_t task_id = 0;
+	CoroutineTask *task = _current_task(p_L, "wait_signal", &task_id);
+	const char *name = luaL_checkstring(p_L, 1);
+
+	task->wait = COROUTINE_WAIT_SIGNAL;
+	task->wait_token += 1;
+	signal_waiters[godot::String::utf8(name)].push_back({task_id, task->wait_token});
+	return lua_yield(p_L, 0);
+}
+
+// native_core.emit_signal(name, ...) -> integer
+// 唤醒所有等待该信号的协程，参数作为 wait_signal 的返回值。
+// 协程在下一次 tick 时恢复。
+// 返回：被唤醒的协程数。
+static int l_emit_signal(lua_State *p_L) {
+	const char *name = luaL_checkstring(p_L, 1);
+	const int arg_count = lua_gettop(p_L) - 1;
+
+	const godot::String signal_name = godot::String::utf8(name);
+	godot::LocalVector<CoroutineWaiter> *waiters = signal_waiters.getptr(signal_name);
+	if (waiters == nullptr) {
+		lua_pushinteger(p_L, 0);
+		return 1;
+	}
+
+	// 先摘下等待表，回调过程中新登记的等待者留给下一次 emit
+	godot::LocalVector<CoroutineWaiter> woken = *waiters;
+	signal_waiters.erase(signal_name);
+
+	int woken_count = 0;
+	for (uint32_t i = 0; i < woken.size(); i++) {
+		CoroutineTask *task = coroutine_tasks.getptr(woken[i].task_id);
+		if (task == nullptr || task->wait != COROUTINE_WAIT_SIGNAL || task->wait_token != woken[i].token) {
+			continue;
+		}
+		if (!lua_checkstack(task->thread, arg_count)) {
+			LUAGD_REPORT_ERROR("native_core", "emit_signal", "coroutine stack overflow");
+			continue;
+		}
+
+		for (int arg = 2; arg <= arg_count + 1; arg++) {
+			lua_pushvalue(p_L, arg);
+		}
+		lua_xmove(p_L, task->thread, arg_count);
+
+		task->wait = COROUTINE_WAIT_READY;
+		task->wait_token += 1;
+		task->resume_arg_count = arg_count;
+		ready_list.push_back({woken[i].task_id, task->wait_token});
+		woken_count += 1;
+	}
+
+	lua_pushinteger(p_L, woken_count);
+	return 1;
+}
+
+// native_core.cancel(handle) -> bool
+// 取消协程。协程取消自身时在下一次挂起后生效。
+// 返回：句柄有效时返回 true。
+static int l_cancel(lua_State *p_L) {
+	const int64_t task_id = (int64_t)luaL_checkinteger(p_L, 1);
+	CoroutineTask *task = coroutine_tasks.getptr(task_id);
+	if (task == nullptr) {
+		lua_pushboolean(p_L, 0);
+		return 1;
+	}
+
+	if (task->running) {
+		// 仍在 C 栈上（正在运行或正在 resume 其他协程），释放推迟到它挂起之后
+		task->cancelled = true;
+	} else {
+		// 堆与等待表中的条目在取出时因找不到任务而被跳过
+		_remove_task(p_L, task_id);
+	}
+	lua_pushboolean(p_L, 1);
+	return 1;
+}
+
+// native_core.is_alive(handle) -> bool
+static int l_is_alive(lua_State *p_L) {
+	const int64_t task_id = (int64_t)luaL_checkinteger(p_L, 1);
+	const CoroutineTask *task = coroutine_tasks.getptr(task_id);
+	lua_pushboolean(p_L, task != nullptr && !task->cancelled);
+	return 1;
+}
+
+// native_core.float_buffer(size) -> FloatBuffer
+// 创建元素初始化为 0 的 float 缓冲区，供批量接口使用。
+static int l_float_buffer(lua_State *p_L) {
+	const lua_Integer size = luaL_checkinteger(p_L, 1);
+	luaL_argcheck(p_L, size >= 0 && size <= (lua_Integer)LUA_FLOAT_BUFFER_MAX_SIZE, 1, "size out of range");
+	lua_float_buffer_new(p_L, (uint32_t)size);
+	return 1;
+}
+
 static const luaL_Reg core_funcs[] = {
 	{"bind_update", l_bind_update},
 	{"bind_shutdown", l_bind_shutdown},
+	{"bind_phase", l_bind_phase},
+	{"unbind_phase", l_unbind_phase},
 	{"quit", l_quit},
 	{"set_time_scale", l_set_time_scale},
 	{"get_time_scale", l_get_time_scale},
+	{"get_fixed_delta", l_get_fixed_delta},
+	{"get_interpolation_alpha", l_get_interpolation_alpha},
+	{"interpolate", l_interpolate},
+	{"reset_interpolation", l_reset_interpolation},
+	{"spawn", l_spawn},
+	{"wait_frames", l_wait_frames},
+	{"wait_seconds", l_wait_seconds},
+	{"wait_signal", l_wait_signal},
+	{"emit_signal", l_emit_signal},
+	{"cancel", l_cancel},
+	{"is_alive", l_is_alive},
+	{"float_buffer", l_float_buffer},
 	{nullptr, nullptr}
 };
 
 int luaopen_native_core(lua_State *p_L) {
-	luaL_newlib(p_L, core_funcs);
+	lua_binding_new_lib(p_L, "native_core", core_funcs);
+	lua_pushinteger(p_L, CORE_PHASE_PRE_PHYSICS);
+	lua_setfield(p_L, -2, "PHASE_PRE_PHYSICS");
+	lua_pushinteger(p_L, CORE_PHASE_PHYSICS);
+	lua_setfield(p_L, -2, "PHASE_PHYSICS");
+	lua_pushinteger(p_L, CORE_PHASE_PROCESS);
+	lua_setfield(p_L, -2, "PHASE_PROCESS");
+	lua_pushinteger(p_L, CORE_PHASE_LATE);
+	lua_setfield(p_L, -2, "PHASE_LATE");
+	lua_pushinteger(p_L, CORE_PHASE_RENDER_PREP);
+	lua_setfield(p_L, -2, "PHASE_RENDER_PREP");
 	return 1;
 }
 
 int core_call_update(lua_State *p_L, double p_delta) {
-	if (!ensure_main_thread("native_core.core_call_update")) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_core.core_call_update")) {
 		return -1;
 	}
+	LUAGD_TRACE_ZONE("core_call_update");
+	return _run_phases(p_L, CORE_PHASE_PRE_PHYSICS, CORE_PHASE_PHYSICS, p_delta);
+}
 
-	// 从 registry 获取回调函数
-	lua_getfield(p_L, LUA_REGISTRYINDEX, UPDATE_CALLBACK_KEY);
-
-	if (lua_isnil(p_L, -1)) {
-		// 未绑定回调，静默跳过
-		lua_pop(p_L, 1);
-		return 0;
-	}
-
-	if (!lua_isfunction(p_L, -1)) {
-		godot::UtilityFunctions::printerr("native_core: update callback is not a function");
-		lua_pop(p_L, 1);
+int core_call_process(lua_State *p_L, double p_delta) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_core.core_call_process")) {
 		return -1;
 	}
+	LUAGD_TRACE_ZONE("core_call_process");
+	return _run_phases(p_L, CORE_PHASE_PROCESS, CORE_PHASE_RENDER_PREP, p_delta);
+}
 
-	// 压入 delta 参数
-	lua_pushnumber(p_L, p_delta);
-
-	// 调用函数（1 个参数，0 个返回值）
-	int call_result = lua_pcall(p_L, 1, 0, 0);
-	if (call_result != LUA_OK) {
-		const char *err = lua_tostring(p_L, -1);
-		godot::String err_msg = "native_core: update callback error: ";
-		err_msg += err ? err : "(unknown)";
-		godot::UtilityFunctions::printerr(err_msg);
-		lua_pop(p_L, 1);
-		return call_result;
+int core_call_phase(lua_State *p_L, CorePhase p_phase, double p_delta) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_core.core_call_phase")) {
+		return -1;
 	}
+	return _run_phases(p_L, p_phase, p_phase, p_delta);
+}
 
-	return 0;
+void core_set_frame_timing(double p_fixed_delta, double p_alpha) {
+	frame_fixed_delta = p_fixed_delta;
+	frame_interpolation_alpha = p_alpha;
 }
 
 void core_call_shutdown(lua_State *p_L) {
-	if (!ensure_main_thread("native_core.core_call_shutdown")) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_core.core_call_shutdown")) {
 		return;
 	}
 
@@ -166,7 +741,7 @@ void core_call_shutdown(lua_State *p_L) {
 	}
 
 	if (!lua_isfunction(p_L, -1)) {
-		godot::UtilityFunctions::printerr("native_core: shutdown callback is not a function");
+		LUAGD_REPORT_ERROR("native_core", "bind_shutdown", "shutdown callback is not a function");
 		lua_pop(p_L, 1);
 		return;
 	}
@@ -175,12 +750,90 @@ void core_call_shutdown(lua_State *p_L) {
 	int call_result = lua_pcall(p_L, 0, 0, 0);
 	if (call_result != LUA_OK) {
 		const char *err = lua_tostring(p_L, -1);
-		godot::String err_msg = "native_core: shutdown callback error: ";
-		err_msg += err ? err : "(unknown)";
-		godot::UtilityFunctions::printerr(err_msg);
+		LUAGD_REPORT_ERROR("native_core", "shutdown", "callback error: ", err ? err : "(unknown)");
 		lua_pop(p_L, 1);
 		// shutdown 错误只打印，不影响退出流程
 	}
 }
 
+void core_scheduler_tick(lua_State *p_L, double p_delta) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_core.core_scheduler_tick")) {
+		return;
+	}
+
+	scheduler_frame += 1;
+	scheduler_time += p_delta;
+
+	// 信号唤醒：本帧新产生的 READY 留到下一帧
+	if (!ready_list.is_empty()) {
+		godot::LocalVector<CoroutineWaiter> ready = ready_list;
+		ready_list.clear();
+		for (uint32_t i = 0; i < ready.size(); i++) {
+			const CoroutineTask *task = coroutine_tasks.getptr(ready[i].task_id);
+			if (task == nullptr || task->wait != COROUTINE_WAIT_READY || task->wait_token != ready[i].token) {
+				continue;
+			}
+			_resume_task(p_L, ready[i].task_id, task->resume_arg_count);
+		}
+	}
+
+	// 帧等待：新挂起的唤醒帧至少为 scheduler_frame + 1，不会在本帧重复取出
+	while (!frame_heap.is_empty() && frame_heap[0].wake_frame <= scheduler_frame) {
+		std::pop_heap(frame_heap.ptr(), frame_heap.ptr() + frame_heap.size(), _frame_entry_later);
+		const CoroutineFrameEntry entry = frame_heap[frame_heap.size() - 1];
+		frame_heap.resize(frame_heap.size() - 1);
+
+		const CoroutineTask *task = coroutine_tasks.getptr(entry.task_id);
+		if (task == nullptr || task->wait != COROUTINE_WAIT_FRAMES || task->wait_token != entry.token) {
+			continue;
+		}
+		_resume_task(p_L, entry.task_id, 0);
+	}
+
+	// 时间等待：等待时长 > 0，新条目的唤醒时间必然晚于当前时间
+	while (!time_heap.is_empty() && time_heap[0].wake_time <= scheduler_time) {
+		std::pop_heap(time_heap.ptr(), time_heap.ptr() + time_heap.size(), _time_entry_later);
+		const CoroutineTimeEntry entry = time_heap[time_heap.size() - 1];
+		time_heap.resize(time_heap.size() - 1);
+
+		const CoroutineTask *task = coroutine_tasks.getptr(entry.task_id);
+		if (task == nullptr || task->wait != COROUTINE_WAIT_SECONDS || task->wait_token != entry.token) {
+			continue;
+		}
+		_resume_task(p_L, entry.task_id, 0);
+	}
+}
+
+int core_scheduler_get_count() {
+	return (int)coroutine_tasks.size();
+}
+
+void core_scheduler_cleanup() {
+	// 协程线程随 lua_close 一并释放，这里只清理调度记录
+	coroutine_tasks.clear();
+	coroutine_ids.clear();
+	time_heap.clear();
+	frame_heap.clear();
+	signal_waiters.clear();
+	ready_list.clear();
+	next_coroutine_id = 1;
+	scheduler_frame = 0;
+	scheduler_time = 0.0;
+}
+
+void core_phases_cleanup() {
+	// 回调引用随 lua_close 一并释放，这里只清理记录
+	for (int phase = 0; phase < CORE_PHASE_COUNT; phase++) {
+		phase_callbacks[phase].clear();
+	}
+	phase_callback_phases.clear();
+	phase_requests.clear();
+	phase_dispatching = false;
+	phase_has_removed = false;
+	next_phase_callback_id = 1;
+	update_callback_id = 0;
+	frame_fixed_delta = 0.0;
+	frame_interpolation_alpha = 1.0;
+}
+
 } // namespace luagd
@@ -5,22 +5,63 @@ struct lua_State;
 
 namespace luagd {
 
+// 帧阶段，按声明顺序执行。
+// PRE_PHYSICS / PHYSICS 由 core_call_update 派发，PROCESS / LATE / RENDER_PREP 由 core_call_process 派发。
+enum CorePhase {
+	CORE_PHASE_PRE_PHYSICS = 0,
+	CORE_PHASE_PHYSICS = 1,
+	CORE_PHASE_PROCESS = 2,
+	CORE_PHASE_LATE = 3,
+	CORE_PHASE_RENDER_PREP = 4,
+	CORE_PHASE_COUNT = 5,
+};
+
 // 打开 native_core 模块。
-// 注册 bind_update、bind_shutdown 函数。
+// 注册 bind_update、bind_shutdown、bind_phase / unbind_phase 函数，以及协程调度 spawn / wait_* / emit_signal / cancel。
 // 返回：在 Lua 栈上返回 1（模块表）。
 int luaopen_native_core(lua_State *p_L);
 
-// 调用 Lua 的 update 回调。
+// 依次派发 PRE_PHYSICS 与 PHYSICS 阶段回调（bind_update 绑定的回调属于 PHYSICS 阶段）。
 // p_delta: 距上一物理帧的秒数。
 // 约束：只允许在主线程调用。
-// 返回：成功返回 0，失败返回非零值。
+// 返回：成功返回 0，任一回调失败时返回第一个错误码；失败的回调不影响后续回调。
 int core_call_update(lua_State *p_L, double p_delta);
 
+// 依次派发 PROCESS、LATE 与 RENDER_PREP 阶段回调。
+// p_delta: 距上一渲染帧的秒数。
+// 约束：只允许在主线程调用。
+// 返回：同 core_call_update。
+int core_call_process(lua_State *p_L, double p_delta);
+
+// 只派发单个阶段。
+// 约束：只允许在主线程调用。
+// 返回：同 core_call_update。
+int core_call_phase(lua_State *p_L, CorePhase p_phase, double p_delta);
+
+// 更新供 Lua 查询的固定步长与插值比例（get_fixed_delta / get_interpolation_alpha）。
+// p_fixed_delta: 固定步长（秒），未启用时为 0。
+// p_alpha: 渲染帧位于最近两个固定步之间的比例，未启用时为 1。
+void core_set_frame_timing(double p_fixed_delta, double p_alpha);
+
 // 调用 Lua 的 shutdown 回调。
 // 约束：只允许在主线程调用。
 // 错误只打印，不影响退出流程。
 void core_call_shutdown(lua_State *p_L);
 
+// 推进协程调度器一帧：先恢复被信号唤醒的协程，再恢复到期的帧等待与时间等待协程。
+// p_delta: 本帧时间（秒），累计为 wait_seconds 的时钟。
+// 约束：只允许在主线程调用。由 LuaHost::tick 在 update 回调之后调用。
+void core_scheduler_tick(lua_State *p_L, double p_delta);
+
+// 返回：存活的调度协程数。
+int core_scheduler_get_count();
+
+// 清理调度记录。在 LuaRuntime::shutdown 时调用。
+void core_scheduler_cleanup();
+
+// 清理分阶段回调与固定步长记录。在 LuaRuntime::shutdown 时调用。
+void core_phases_cleanup();
+
 } // namespace luagd
 
 #endif // LUAGD_CORE_MODULE_H
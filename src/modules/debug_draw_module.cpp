@@ -2,7 +2,9 @@
 
 #include "../debug_draw/debug_draw_types.h"
 
+#include "../host/host_error_sink.h"
 #include "../host/host_thread_check.h"
+#include "../lua/lua_binding_stats.h"
 
 #include <godot_cpp/classes/engine.hpp>
 #include <godot_cpp/classes/scene_tree.hpp>
@@ -60,31 +62,31 @@ static bool _set_root_path(const char *p_path) {
 
 	godot::SceneTree *tree = godot::Object::cast_to<godot::SceneTree>(godot::Engine::get_singleton()->get_main_loop());
 	if (tree == nullptr) {
-		godot::UtilityFunctions::printerr("native_debug_draw.set_root: SceneTree not available");
+		LUAGD_REPORT_ERROR("native_debug_draw", "set_root", "SceneTree not available");
 		return false;
 	}
 
 	godot::Window *root_window = tree->get_root();
 	if (root_window == nullptr) {
-		godot::UtilityFunctions::printerr("native_debug_draw.set_root: scene root not available");
+		LUAGD_REPORT_ERROR("native_debug_draw", "set_root", "scene root not available");
 		return false;
 	}
 
 	godot::Node *root_node = godot::Object::cast_to<godot::Node>(root_window);
 	if (root_node == nullptr) {
-		godot::UtilityFunctions::printerr("native_debug_draw.set_root: root window is not a Node");
+		LUAGD_REPORT_ERROR("native_debug_draw", "set_root", "root window is not a Node");
 		return false;
 	}
 
 	godot::Node *found_node = root_node->get_node_or_null(godot::NodePath(godot::String(p_path)));
 	if (found_node == nullptr) {
-		godot::UtilityFunctions::printerr("native_debug_draw.set_root: node not found: ", p_path);
+		LUAGD_REPORT_ERROR("native_debug_draw", "set_root", "node not found: ", p_path);
 		return false;
 	}
 
 	godot::Node3D *found_node3d = godot::Object::cast_to<godot::Node3D>(found_node);
 	if (found_node3d == nullptr) {
-		godot::UtilityFunctions::printerr("native_debug_draw.set_root: node is not Node3D: ", p_path);
+		LUAGD_REPORT_ERROR("native_debug_draw", "set_root", "node is not Node3D: ", p_path);
 		return false;
 	}
 
@@ -177,7 +179,7 @@ static int l_add_point(lua_State *p_L) {
 	command.is_xray = lua_toboolean(p_L, 9);
 
 	if (command.size <= 0.0f) {
-		godot::UtilityFunctions::printerr("native_debug_draw.add_point: size must be > 0");
+		LUAGD_REPORT_ERROR("native_debug_draw", "add_point", "size must be > 0");
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
@@ -207,12 +209,12 @@ static int l_add_line(lua_State *p_L) {
 	command.is_xray = lua_toboolean(p_L, 12);
 
 	if (command.width <= 0.0f) {
-		godot::UtilityFunctions::printerr("native_debug_draw.add_line: width must be > 0");
+		LUAGD_REPORT_ERROR("native_debug_draw", "add_line", "width must be > 0");
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
 	if ((command.to - command.from).length_squared() <= 0.000001f) {
-		godot::UtilityFunctions::printerr("native_debug_draw.add_line: line length must be > 0");
+		LUAGD_REPORT_ERROR("native_debug_draw", "add_line", "line length must be > 0");
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
@@ -245,12 +247,12 @@ static int l_add_circle(lua_State *p_L) {
 	command.is_fill = lua_toboolean(p_L, 15);
 
 	if (command.radius <= 0.0f) {
-		godot::UtilityFunctions::printerr("native_debug_draw.add_circle: radius must be > 0");
+		LUAGD_REPORT_ERROR("native_debug_draw", "add_circle", "radius must be > 0");
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
 	if (command.normal.length_squared() <= 0.000001f) {
-		godot::UtilityFunctions::printerr("native_debug_draw.add_circle: normal length must be > 0");
+		LUAGD_REPORT_ERROR("native_debug_draw", "add_circle", "normal length must be > 0");
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
@@ -258,7 +260,7 @@ static int l_add_circle(lua_State *p_L) {
 		command.segments = 3;
 	}
 	if (!command.is_fill && command.line_width <= 0.0f) {
-		godot::UtilityFunctions::printerr("native_debug_draw.add_circle: line_width must be > 0 when is_fill is false");
+		LUAGD_REPORT_ERROR("native_debug_draw", "add_circle", "line_width must be > 0 when is_fill is false");
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
@@ -297,22 +299,22 @@ static int l_add_sector(lua_State *p_L) {
 	command.is_fill = lua_toboolean(p_L, 19);
 
 	if (command.radius <= 0.0f) {
-		godot::UtilityFunctions::printerr("native_debug_draw.add_sector: radius must be > 0");
+		LUAGD_REPORT_ERROR("native_debug_draw", "add_sector", "radius must be > 0");
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
 	if (command.normal.length_squared() <= 0.000001f) {
-		godot::UtilityFunctions::printerr("native_debug_draw.add_sector: normal length must be > 0");
+		LUAGD_REPORT_ERROR("native_debug_draw", "add_sector", "normal length must be > 0");
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
 	if (command.direction.length_squared() <= 0.000001f) {
-		godot::UtilityFunctions::printerr("native_debug_draw.add_sector: direction length must be > 0");
+		LUAGD_REPORT_ERROR("native_debug_draw", "add_sector", "direction length must be > 0");
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
 	if (command.angle_degrees <= 0.0f || command.angle_degrees > 360.0f) {
-		godot::UtilityFunctions::printerr("native_debug_draw.add_sector: angle_degrees must be in (0, 360]");
+		LUAGD_REPORT_ERROR("native_debug_draw", "add_sector", "angle_degrees must be in (0, 360]");
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
@@ -320,7 +322,7 @@ static int l_add_sector(lua_State *p_L) {
 		command.segments = 1;
 	}
 	if (!command.is_fill && command.line_width <= 0.0f) {
-		godot::UtilityFunctions::printerr("native_debug_draw.add_sector: line_width must be > 0 when is_fill is false");
+		LUAGD_REPORT_ERROR("native_debug_draw", "add_sector", "line_width must be > 0 when is_fill is false");
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
@@ -362,14 +364,14 @@ static const luaL_Reg debug_draw_funcs[] = {
 };
 
 int luaopen_native_debug_draw(lua_State *p_L) {
-	luaL_newlib(p_L, debug_draw_funcs);
+	lua_binding_new_lib(p_L, "native_debug_draw", debug_draw_funcs);
 	return 1;
 }
 
 // 清理模块状态。
 // 注意：场景对象交给引擎统一销毁，这里只清理模块记录。
 void debug_draw_cleanup() {
-	if (!ensure_main_thread("native_debug_draw.debug_draw_cleanup")) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_debug_draw.debug_draw_cleanup")) {
 		return;
 	}
 
@@ -388,4 +390,33 @@ void debug_draw_cleanup() {
 	debug_draw_state = nullptr;
 }
 
+void debug_draw_collect_memory(godot::LocalVector<HostMemoryTable> &r_tables) {
+	if (debug_draw_state == nullptr) {
+		return;
+	}
+
+	int64_t vertices = 0;
+	int64_t bucket_bytes = 0;
+	for (int32_t i = 0; i < DEBUG_BUCKET_COUNT; ++i) {
+		const DebugBucketBuffers &buffers = debug_draw_state->buckets[i].buffers;
+		vertices += buffers.positions.size();
+		bucket_bytes += (int64_t)buffers.positions.size() * (int64_t)sizeof(godot::Vector3);
+		bucket_bytes += (int64_t)buffers.colors.size() * (int64_t)sizeof(godot::Color);
+	}
+	r_tables.push_back({"native_debug_draw.buckets", vertices, bucket_bytes});
+
+	const int64_t commands = debug_draw_state->point_commands.size() + debug_draw_state->line_commands.size() +
+			debug_draw_state->circle_commands.size() + debug_draw_state->sector_commands.size();
+	const int64_t command_bytes =
+			(int64_t)debug_draw_state->point_commands.size() * (int64_t)sizeof(DebugPointCommand) +
+			(int64_t)debug_draw_state->line_commands.size() * (int64_t)sizeof(DebugLineCommand) +
+			(int64_t)debug_draw_state->circle_commands.size() * (int64_t)sizeof(DebugCircleCommand) +
+			(int64_t)debug_draw_state->sector_commands.size() * (int64_t)sizeof(DebugSectorCommand);
+	r_tables.push_back({"native_debug_draw.commands", commands, command_bytes});
+}
+
+const DebugFrameStats *debug_draw_get_frame_stats() {
+	return debug_draw_state != nullptr ? &debug_draw_state->stats : nullptr;
+}
+
 } // namespace luagd
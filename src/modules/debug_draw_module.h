@@ -1,10 +1,14 @@
 #ifndef LUAGD_DEBUG_DRAW_MODULE_H
 #define LUAGD_DEBUG_DRAW_MODULE_H
 
+#include "../host/host_memory_stats.h"
+
 struct lua_State;
 
 namespace luagd {
 
+struct DebugFrameStats;
+
 // 打开 native_debug_draw 模块。
 // 提供运行时 3D 调试绘制接口。
 int luaopen_native_debug_draw(lua_State *p_L);
@@ -14,6 +18,12 @@ int luaopen_native_debug_draw(lua_State *p_L);
 // 约束：只允许在主线程调用。
 void debug_draw_cleanup();
 
+// 把模块表的条目数与估算字节数追加到 r_tables，供 host_memory_collect 使用。
+void debug_draw_collect_memory(godot::LocalVector<HostMemoryTable> &r_tables);
+
+// 返回：最近一次提交的绘制统计；模块尚未使用时返回 nullptr。
+const DebugFrameStats *debug_draw_get_frame_stats();
+
 } // namespace luagd
 
 #endif // LUAGD_DEBUG_DRAW_MODULE_H
@@ -0,0 +1,363 @@
+#include "debug_module.h"
+
+#include "../host/host_error_sink.h"
+#include "../host/host_memory_stats.h"
+#include "../host/host_thread_check.h"
+#include "../host/host_trace.h"
+#include "../lua/lua_alloc_profiler.h"
+#include "../lua/lua_binding_stats.h"
+#include "../lua/lua_profiler.h"
+#include "../lua/lua_runtime.h"
+
+extern "C" {
+#include <lua.h>
+#include <lauxlib.h>
+}
+
+namespace luagd {
+
+// native_debug.profiler_start([interval]) -> void
+// 开始采样主 lua_State 的调用栈。
+// interval: 采样间隔（指令数），默认 1000。
+static int l_profiler_start(lua_State *p_L) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_debug.profiler_start")) {
+		return 0;
+	}
+
+	const int interval = (int)luaL_optinteger(p_L, 1, LUA_PROFILER_DEFAULT_INTERVAL);
+	// hook 装在主 state 上，之后创建的协程同样会被采样
+	lua_profiler_start(LuaRuntime::get_state(), interval);
+	return 0;
+}
+
+// native_debug.profiler_stop() -> void
+static int l_profiler_stop(lua_State *p_L) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_debug.profiler_stop")) {
+		return 0;
+	}
+
+	lua_profiler_stop(LuaRuntime::get_state());
+	return 0;
+}
+
+// native_debug.profiler_is_running() -> bool
+static int l_profiler_is_running(lua_State *p_L) {
+	lua_pushboolean(p_L, lua_profiler_is_running());
+	return 1;
+}
+
+// native_debug.profiler_dump() -> string
+// 返回：collapsed stack 文本。
+static int l_profiler_dump(lua_State *p_L) {
+	const godot::CharString text = lua_profiler_dump().utf8();
+	lua_pushlstring(p_L, text.get_data(), (size_t)text.length());
+	return 1;
+}
+
+// native_debug.profiler_get_sample_count() -> integer
+static int l_profiler_get_sample_count(lua_State *p_L) {
+	lua_pushinteger(p_L, (lua_Integer)lua_profiler_get_sample_count());
+	return 1;
+}
+
+// native_debug.profiler_reset() -> void
+static int l_profiler_reset(lua_State *p_L) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_debug.profiler_reset")) {
+		return 0;
+	}
+
+	lua_profiler_reset();
+	return 0;
+}
+
+// native_debug.alloc_track_start([interval]) -> void
+// 开始按调用点统计主 lua_State 的分配。
+// interval: 采样间隔（分配次数），默认 64。
+static int l_alloc_track_start(lua_State *p_L) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_debug.alloc_track_start")) {
+		return 0;
+	}
+
+	const int interval = (int)luaL_optinteger(p_L, 1, LUA_ALLOC_PROFILER_DEFAULT_INTERVAL);
+	lua_alloc_profiler_start(LuaRuntime::get_state(), interval);
+	return 0;
+}
+
+// native_debug.alloc_track_stop() -> void
+static int l_alloc_track_stop(lua_State *p_L) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_debug.alloc_track_stop")) {
+		return 0;
+	}
+
+	lua_alloc_profiler_stop(LuaRuntime::get_state());
+	return 0;
+}
+
+// native_debug.alloc_track_is_running() -> bool
+static int l_alloc_track_is_running(lua_State *p_L) {
+	lua_pushboolean(p_L, lua_alloc_profiler_is_running());
+	return 1;
+}
+
+// native_debug.alloc_top([n], [frame]) -> table
+// 返回：按字节数降序的调用点数组 { { site, bytes, count }, ... }，bytes / count 为按采样间隔放大的估算值。
+// n: 最多返回的调用点数，默认 20。
+// frame: 为 true 时按上一帧统计，否则按自 start / reset 起的累计值。
+static int l_alloc_top(lua_State *p_L) {
+	const int top_n = (int)luaL_optinteger(p_L, 1, 20);
+	const bool frame = lua_toboolean(p_L, 2);
+
+	godot::LocalVector<const LuaAllocSite *> top;
+	lua_alloc_profiler_get_top(top, top_n, frame);
+	lua_createtable(p_L, (int)top.size(), 0);
+	for (uint32_t i = 0; i < top.size(); i++) {
+		const LuaAllocSite *site = top[i];
+		const godot::CharString name = site->site.utf8();
+		lua_createtable(p_L, 0, 3);
+		lua_pushlstring(p_L, name.get_data(), (size_t)name.length());
+		lua_setfield(p_L, -2, "site");
+		lua_pushinteger(p_L, (lua_Integer)(frame ? site->frame_bytes : site->bytes));
+		lua_setfield(p_L, -2, "bytes");
+		lua_pushinteger(p_L, (lua_Integer)(frame ? site->frame_count : site->count));
+		lua_setfield(p_L, -2, "count");
+		lua_rawseti(p_L, -2, (lua_Integer)i + 1);
+	}
+	return 1;
+}
+
+// native_debug.alloc_track_reset() -> void
+static int l_alloc_track_reset(lua_State *p_L) {
+	lua_alloc_profiler_reset();
+	return 0;
+}
+
+// native_debug.zone_begin(name) -> integer
+// 开始一个时间线区间，返回令牌，传给 zone_end 结束。未在记录时返回 0。
+static int l_zone_begin(lua_State *p_L) {
+	const char *name = luaL_checkstring(p_L, 1);
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_debug.zone_begin")) {
+		lua_pushinteger(p_L, 0);
+		return 1;
+	}
+
+	lua_pushinteger(p_L, (lua_Integer)host_trace_zone_begin(name));
+	return 1;
+}
+
+// native_debug.zone_end([token]) -> void
+// 结束 token 对应的区间；省略时结束最近一个区间，token 为 0 时什么也不做。
+static int l_zone_end(lua_State *p_L) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_debug.zone_end")) {
+		return 0;
+	}
+
+	if (lua_isnoneornil(p_L, 1)) {
+		if (!host_trace_zone_end(0) && host_trace_is_running()) {
+			LUAGD_REPORT_ERROR("native_debug", "zone_end", "no open zone");
+		}
+		return 0;
+	}
+
+	const lua_Integer token = luaL_checkinteger(p_L, 1);
+	if (token == 0) {
+		return 0;
+	}
+	if (token < 0 || token > (lua_Integer)UINT32_MAX || !host_trace_zone_end((uint32_t)token)) {
+		LUAGD_REPORT_ERROR("native_debug", "zone_end", "unknown zone token ", (int64_t)token);
+	}
+	return 0;
+}
+
+// native_debug.trace_start([capacity]) -> void
+// 开始记录帧时间线并清空已有事件。
+// capacity: 环形缓冲容量（事件数），默认 65536。
+static int l_trace_start(lua_State *p_L) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_debug.trace_start")) {
+		return 0;
+	}
+
+	const lua_Integer capacity = luaL_optinteger(p_L, 1, HOST_TRACE_DEFAULT_CAPACITY);
+	host_trace_start(capacity > 0 ? (uint32_t)capacity : HOST_TRACE_DEFAULT_CAPACITY);
+	return 0;
+}
+
+// native_debug.trace_stop() -> void
+static int l_trace_stop(lua_State *p_L) {
+	host_trace_stop();
+	return 0;
+}
+
+// native_debug.trace_dump() -> string
+// 返回：Chrome trace event JSON。
+static int l_trace_dump(lua_State *p_L) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_debug.trace_dump")) {
+		return 0;
+	}
+
+	const godot::CharString text = host_trace_dump_json().utf8();
+	lua_pushlstring(p_L, text.get_data(), (size_t)text.length());
+	return 1;
+}
+
+// native_debug.memory_stats([diff]) -> table
+// 返回：{ [name] = { entries, bytes, peak_entries, peak_bytes, delta_entries, delta_bytes } }。
+// diff: 为 true 时 delta_* 为相对上一次 diff 查询的变化，并记录新的快照。
+static int l_memory_stats(lua_State *p_L) {
+	const bool diff = lua_toboolean(p_L, 1);
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_debug.memory_stats")) {
+		return 0;
+	}
+
+	godot::LocalVector<HostMemoryReport> reports;
+	host_memory_collect(reports, diff);
+	lua_createtable(p_L, 0, (int)reports.size());
+	for (uint32_t i = 0; i < reports.size(); i++) {
+		const HostMemoryReport &report = reports[i];
+		lua_createtable(p_L, 0, 6);
+		lua_pushinteger(p_L, (lua_Integer)report.entries);
+		lua_setfield(p_L, -2, "entries");
+		lua_pushinteger(p_L, (lua_Integer)report.bytes);
+		lua_setfield(p_L, -2, "bytes");
+		lua_pushinteger(p_L, (lua_Integer)report.peak_entries);
+		lua_setfield(p_L, -2, "peak_entries");
+		lua_pushinteger(p_L, (lua_Integer)report.peak_bytes);
+		lua_setfield(p_L, -2, "peak_bytes");
+		lua_pushinteger(p_L, (lua_Integer)report.delta_entries);
+		lua_setfield(p_L, -2, "delta_entries");
+		lua_pushinteger(p_L, (lua_Integer)report.delta_bytes);
+		lua_setfield(p_L, -2, "delta_bytes");
+		lua_setfield(p_L, -2, report.name);
+	}
+	return 1;
+}
+
+// native_debug.memory_stats_reset() -> void
+// 清除高水位与 diff 快照。
+static int l_memory_stats_reset(lua_State *p_L) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_debug.memory_stats_reset")) {
+		return 0;
+	}
+
+	host_memory_reset();
+	return 0;
+}
+
+// native_debug.binding_stats_enabled() -> bool
+// 返回：构建时是否启用了 LUAGD_BINDING_STATS。
+static int l_binding_stats_enabled(lua_State *p_L) {
+	lua_pushboolean(p_L, lua_binding_stats_is_enabled());
+	return 1;
+}
+
+// native_debug.binding_stats() -> table
+// 返回：{ [module] = { [func] = { calls, nsec, frame_calls, frame_nsec } } }。
+// 未启用绑定统计时返回空表。
+static int l_binding_stats(lua_State *p_L) {
+	const godot::LocalVector<LuaBindingRecord *> &records = lua_binding_stats_get_records();
+	lua_newtable(p_L);
+	for (uint32_t i = 0; i < records.size(); i++) {
+		const LuaBindingRecord *record = records[i];
+
+		if (lua_getfield(p_L, -1, record->module_name) != LUA_TTABLE) {
+			lua_pop(p_L, 1);
+			lua_newtable(p_L);
+			lua_pushvalue(p_L, -1);
+			lua_setfield(p_L, -3, record->module_name);
+		}
+
+		lua_createtable(p_L, 0, 4);
+		lua_pushinteger(p_L, (lua_Integer)record->calls);
+		lua_setfield(p_L, -2, "calls");
+		lua_pushinteger(p_L, (lua_Integer)record->nsec);
+		lua_setfield(p_L, -2, "nsec");
+		lua_pushinteger(p_L, (lua_Integer)record->frame_calls);
+		lua_setfield(p_L, -2, "frame_calls");
+		lua_pushinteger(p_L, (lua_Integer)record->frame_nsec);
+		lua_setfield(p_L, -2, "frame_nsec");
+		lua_setfield(p_L, -2, record->func_name);
+
+		lua_pop(p_L, 1);
+	}
+	return 1;
+}
+
+// native_debug.binding_stats_reset() -> void
+static int l_binding_stats_reset(lua_State *p_L) {
+	lua_binding_stats_reset();
+	return 0;
+}
+
+// native_debug.error_summary() -> table
+// 返回：按累计次数降序的错误数组 { { func, message, count, suppressed }, ... }。
+static int l_error_summary(lua_State *p_L) {
+	godot::LocalVector<const HostErrorRecord *> summary;
+	host_error_get_summary(summary);
+	lua_createtable(p_L, (int)summary.size(), 0);
+	for (uint32_t i = 0; i < summary.size(); i++) {
+		const HostErrorRecord *record = summary[i];
+		lua_createtable(p_L, 0, 4);
+		lua_pushfstring(p_L, "%s.%s", record->module, record->func);
+		lua_setfield(p_L, -2, "func");
+		const godot::CharString message = record->message.utf8();
+		lua_pushlstring(p_L, message.get_data(), (size_t)message.length());
+		lua_setfield(p_L, -2, "message");
+		lua_pushinteger(p_L, (lua_Integer)record->count);
+		lua_setfield(p_L, -2, "count");
+		lua_pushinteger(p_L, (lua_Integer)record->suppressed);
+		lua_setfield(p_L, -2, "suppressed");
+		lua_rawseti(p_L, -2, (lua_Integer)i + 1);
+	}
+	return 1;
+}
+
+// native_debug.error_summary_reset() -> void
+static int l_error_summary_reset(lua_State *p_L) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_debug.error_summary_reset")) {
+		return 0;
+	}
+
+	host_error_reset();
+	return 0;
+}
+
+// native_debug.set_error_interval(msec) -> void
+// 设置同一错误的最短输出间隔（毫秒），0 表示每次都输出。
+static int l_set_error_interval(lua_State *p_L) {
+	host_error_set_interval_msec((int64_t)luaL_checkinteger(p_L, 1));
+	return 0;
+}
+
+static const luaL_Reg debug_funcs[] = {
+	{"profiler_start", l_profiler_start},
+	{"profiler_stop", l_profiler_stop},
+	{"profiler_is_running", l_profiler_is_running},
+	{"profiler_dump", l_profiler_dump},
+	{"profiler_get_sample_count", l_profiler_get_sample_count},
+	{"profiler_reset", l_profiler_reset},
+	{"alloc_track_start", l_alloc_track_start},
+	{"alloc_track_stop", l_alloc_track_stop},
+	{"alloc_track_is_running", l_alloc_track_is_running},
+	{"alloc_top", l_alloc_top},
+	{"alloc_track_reset", l_alloc_track_reset},
+	{"zone_begin", l_zone_begin},
+	{"zone_end", l_zone_end},
+	{"trace_start", l_trace_start},
+	{"trace_stop", l_trace_stop},
+	{"trace_dump", l_trace_dump},
+	{"memory_stats", l_memory_stats},
+	{"memory_stats_reset", l_memory_stats_reset},
+	{"binding_stats_enabled", l_binding_stats_enabled},
+	{"binding_stats", l_binding_stats},
+	{"binding_stats_reset", l_binding_stats_reset},
+	{"error_summary", l_error_summary},
+	{"error_summary_reset", l_error_summary_reset},
+	{"set_error_interval", l_set_error_interval},
+	{nullptr, nullptr}
+};
+
+int luaopen_native_debug(lua_State *p_L) {
+	lua_binding_new_lib(p_L, "native_debug", debug_funcs);
+	return 1;
+}
+
+} // namespace luagd
@@ -0,0 +1,15 @@
+#ifndef LUAGD_DEBUG_MODULE_H
+#define LUAGD_DEBUG_MODULE_H
+
+struct lua_State;
+
+namespace luagd {
+
+// 打开 native_debug 模块。
+// 提供采样分析器的启动、停止与导出，以及绑定函数调用统计的查询。
+// 返回：在 Lua 栈上返回 1（模块表）。
+int luaopen_native_debug(lua_State *p_L);
+
+} // namespace luagd
+
+#endif // LUAGD_DEBUG_MODULE_H
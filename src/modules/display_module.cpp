@@ -1,5 +1,9 @@
 #include "display_module.h"
 
+#include "../host/host_error_sink.h"
+#include "../host/host_thread_check.h"
+#include "../lua/lua_binding_stats.h"
+
 #include <godot_cpp/classes/display_server.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 
@@ -18,7 +22,7 @@ static const int32_t MAIN_WINDOW_ID = 0;
 static int l_window_get_size(lua_State *p_L) {
 	godot::DisplayServer *ds = godot::DisplayServer::get_singleton();
 	if (ds == nullptr) {
-		godot::UtilityFunctions::printerr("native_display.window_get_size: DisplayServer not available");
+		LUAGD_REPORT_ERROR("native_display", "window_get_size", "DisplayServer not available");
 		lua_pushinteger(p_L, 0);
 		lua_pushinteger(p_L, 0);
 		return 2;
@@ -36,13 +40,13 @@ static int l_window_get_size(lua_State *p_L) {
 static int l_window_set_size(lua_State *p_L) {
 	int argc = lua_gettop(p_L);
 	if (argc < 2) {
-		godot::UtilityFunctions::printerr("native_display.window_set_size: expected 2 arguments (w, h), got ", argc);
+		LUAGD_REPORT_ERROR("native_display", "window_set_size", "expected 2 arguments (w, h), got ", argc);
 		lua_pushinteger(p_L, -1);
 		return 1;
 	}
 
 	if (!lua_isinteger(p_L, 1) || !lua_isinteger(p_L, 2)) {
-		godot::UtilityFunctions::printerr("native_display.window_set_size: arguments must be integers");
+		LUAGD_REPORT_ERROR("native_display", "window_set_size", "arguments must be integers");
 		lua_pushinteger(p_L, -1);
 		return 1;
 	}
@@ -51,19 +55,14 @@ static int l_window_set_size(lua_State *p_L) {
 	int64_t h = lua_tointeger(p_L, 2);
 
 	if (w <= 0 || h <= 0) {
-		godot::String err_msg = "native_display.window_set_size: invalid size (";
-		err_msg += godot::String::num_int64(w);
-		err_msg += ", ";
-		err_msg += godot::String::num_int64(h);
-		err_msg += "), width and height must be > 0";
-		godot::UtilityFunctions::printerr(err_msg);
+		LUAGD_REPORT_ERROR("native_display", "window_set_size", "invalid size (", w, ", ", h, "), width and height must be > 0");
 		lua_pushinteger(p_L, -1);
 		return 1;
 	}
 
 	godot::DisplayServer *ds = godot::DisplayServer::get_singleton();
 	if (ds == nullptr) {
-		godot::UtilityFunctions::printerr("native_display.window_set_size: DisplayServer not available");
+		LUAGD_REPORT_ERROR("native_display", "window_set_size", "DisplayServer not available");
 		lua_pushinteger(p_L, -1);
 		return 1;
 	}
@@ -87,10 +86,7 @@ static int l_window_set_size(lua_State *p_L) {
 			default:
 				break;
 		}
-		godot::String err_msg = "native_display.window_set_size: cannot set size in ";
-		err_msg += mode_name;
-		err_msg += " mode";
-		godot::UtilityFunctions::printerr(err_msg);
+		LUAGD_REPORT_ERROR("native_display", "window_set_size", "cannot set size in ", mode_name, " mode");
 		lua_pushinteger(p_L, -1);
 		return 1;
 	}
@@ -109,7 +105,7 @@ static const luaL_Reg display_funcs[] = {
 };
 
 int luaopen_native_display(lua_State *p_L) {
-	luaL_newlib(p_L, display_funcs);
+	lua_binding_new_lib(p_L, "native_display", display_funcs);
 	return 1;
 }
 
@@ -1,6 +1,9 @@
 #include "input_module.h"
 
+#include "../host/host_error_sink.h"
 #include "../host/host_thread_check.h"
+#include "../host/host_trace.h"
+#include "../lua/lua_binding_stats.h"
 
 #include <godot_cpp/classes/input.hpp>
 #include <godot_cpp/classes/input_event.hpp>
@@ -26,12 +29,12 @@ static const char *INPUT_CALLBACK_KEY = "native_input.input_callback";
 static int l_bind_input(lua_State *p_L) {
 	int argc = lua_gettop(p_L);
 	if (argc < 1) {
-		godot::UtilityFunctions::printerr("native_input.bind_input: expected 1 argument (function), got ", argc);
+		LUAGD_REPORT_ERROR("native_input", "bind_input", "expected 1 argument (function), got ", argc);
 		return 0;
 	}
 
 	if (!lua_isfunction(p_L, 1)) {
-		godot::UtilityFunctions::printerr("native_input.bind_input: argument must be a function");
+		LUAGD_REPORT_ERROR("native_input", "bind_input", "argument must be a function");
 		return 0;
 	}
 
@@ -47,7 +50,7 @@ static int l_bind_input(lua_State *p_L) {
 static int l_is_pressed(lua_State *p_L) {
 	int argc = lua_gettop(p_L);
 	if (argc < 1) {
-		godot::UtilityFunctions::printerr("native_input.is_pressed: expected 1 argument (action_name), got ", argc);
+		LUAGD_REPORT_ERROR("native_input", "is_pressed", "expected 1 argument (action_name), got ", argc);
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
@@ -64,7 +67,7 @@ static int l_is_pressed(lua_State *p_L) {
 static int l_is_hold(lua_State *p_L) {
 	int argc = lua_gettop(p_L);
 	if (argc < 1) {
-		godot::UtilityFunctions::printerr("native_input.is_hold: expected 1 argument (action_name), got ", argc);
+		LUAGD_REPORT_ERROR("native_input", "is_hold", "expected 1 argument (action_name), got ", argc);
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
@@ -81,7 +84,7 @@ static int l_is_hold(lua_State *p_L) {
 static int l_is_released(lua_State *p_L) {
 	int argc = lua_gettop(p_L);
 	if (argc < 1) {
-		godot::UtilityFunctions::printerr("native_input.is_released: expected 1 argument (action_name), got ", argc);
+		LUAGD_REPORT_ERROR("native_input", "is_released", "expected 1 argument (action_name), got ", argc);
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
@@ -98,7 +101,7 @@ static int l_is_released(lua_State *p_L) {
 static int l_get_strength(lua_State *p_L) {
 	int argc = lua_gettop(p_L);
 	if (argc < 1) {
-		godot::UtilityFunctions::printerr("native_input.get_strength: expected 1 argument (action_name), got ", argc);
+		LUAGD_REPORT_ERROR("native_input", "get_strength", "expected 1 argument (action_name), got ", argc);
 		lua_pushnumber(p_L, 0.0);
 		return 1;
 	}
@@ -115,7 +118,7 @@ static int l_get_strength(lua_State *p_L) {
 static int l_get_axis(lua_State *p_L) {
 	int argc = lua_gettop(p_L);
 	if (argc < 2) {
-		godot::UtilityFunctions::printerr("native_input.get_axis: expected 2 arguments (neg_action_name, pos_action_name), got ", argc);
+		LUAGD_REPORT_ERROR("native_input", "get_axis", "expected 2 arguments (neg_action_name, pos_action_name), got ", argc);
 		lua_pushnumber(p_L, 0.0);
 		return 1;
 	}
@@ -133,7 +136,7 @@ static int l_get_axis(lua_State *p_L) {
 static int l_get_vector(lua_State *p_L) {
 	int argc = lua_gettop(p_L);
 	if (argc < 4) {
-		godot::UtilityFunctions::printerr("native_input.get_vector: expected 4 arguments (left_action_name, right_action_name, up_action_name, down_action_name), got ", argc);
+		LUAGD_REPORT_ERROR("native_input", "get_vector", "expected 4 arguments (left_action_name, right_action_name, up_action_name, down_action_name), got ", argc);
 		lua_pushnumber(p_L, 0.0);
 		lua_pushnumber(p_L, 0.0);
 		return 2;
@@ -158,7 +161,7 @@ static int l_get_vector(lua_State *p_L) {
 static int l_vibrate(lua_State *p_L) {
 	int argc = lua_gettop(p_L);
 	if (argc < 3) {
-		godot::UtilityFunctions::printerr("native_input.vibrate: expected 3 arguments (weak, strong, duration), got ", argc);
+		LUAGD_REPORT_ERROR("native_input", "vibrate", "expected 3 arguments (weak, strong, duration), got ", argc);
 		return 0;
 	}
 
@@ -180,7 +183,7 @@ static int l_vibrate(lua_State *p_L) {
 static int l_get_joy_name(lua_State *p_L) {
 	int argc = lua_gettop(p_L);
 	if (argc < 1) {
-		godot::UtilityFunctions::printerr("native_input.get_joy_name: expected 1 argument (device), got ", argc);
+		LUAGD_REPORT_ERROR("native_input", "get_joy_name", "expected 1 argument (device), got ", argc);
 		lua_pushstring(p_L, "");
 		return 1;
 	}
@@ -212,7 +215,7 @@ static const luaL_Reg input_funcs[] = {
 };
 
 int luaopen_native_input(lua_State *p_L) {
-	luaL_newlib(p_L, input_funcs);
+	lua_binding_new_lib(p_L, "native_input", input_funcs);
 	return 1;
 }
 
@@ -231,13 +234,14 @@ static const char *get_device_type(const godot::InputEvent *p_event) {
 }
 
 void input_dispatch_event(lua_State *p_L, const godot::InputEvent *p_event) {
-	if (!ensure_main_thread("native_input.input_dispatch_event")) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_input.input_dispatch_event")) {
 		return;
 	}
 
 	if (p_L == nullptr || p_event == nullptr) {
 		return;
 	}
+	LUAGD_TRACE_ZONE("input_dispatch_event");
 
 	// 从 registry 获取回调函数
 	lua_getfield(p_L, LUA_REGISTRYINDEX, INPUT_CALLBACK_KEY);
@@ -248,7 +252,7 @@ void input_dispatch_event(lua_State *p_L, const godot::InputEvent *p_event) {
 	}
 
 	if (!lua_isfunction(p_L, -1)) {
-		godot::UtilityFunctions::printerr("native_input: input callback is not a function");
+		LUAGD_REPORT_ERROR("native_input", "bind_input", "input callback is not a function");
 		lua_pop(p_L, 1);
 		return;
 	}
@@ -2,6 +2,10 @@
 
 #include "node_module.h"
 
+#include "../host/host_error_sink.h"
+#include "../host/host_thread_check.h"
+#include "../lua/lua_binding_stats.h"
+
 #include <godot_cpp/classes/geometry_instance3d.hpp>
 #include <godot_cpp/classes/material.hpp>
 #include <godot_cpp/classes/mesh_instance3d.hpp>
@@ -21,8 +25,8 @@ extern "C" {
 
 namespace luagd {
 
-static godot::ObjectID _read_node_id(lua_State *p_L, int p_index) {
-	return godot::ObjectID((uint64_t)luaL_checkinteger(p_L, p_index));
+static NodeHandle _read_node_id(lua_State *p_L, int p_index) {
+	return node_check_handle(p_L, p_index);
 }
 
 // 遍历节点自身及其直接子节点，对GeometryInstance3D执行操作
@@ -110,22 +114,22 @@ static bool _set_shader_parameter_to_children(
 // set_param_color(node_id, param_name, r, g, b, a) -> bool
 // 在节点的直接子节点中设置实例着色器颜色参数。
 static int l_set_param_color(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	const char *param_name = luaL_checkstring(p_L, 2);
 	const double r = luaL_checknumber(p_L, 3);
 	const double g = luaL_checknumber(p_L, 4);
 	const double b = luaL_checknumber(p_L, 5);
 	const double a = luaL_checknumber(p_L, 6);
 
-	if (node_id.is_null()) {
-		godot::UtilityFunctions::printerr("native_material.set_param_color: node id is 0");
+	if (node_id == 0) {
+		LUAGD_REPORT_ERROR("native_material", "set_param_color", "node id is 0");
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
 
 	godot::Node3D *root_node_3d = node_resolve(node_id);
 	if (root_node_3d == nullptr) {
-		godot::UtilityFunctions::printerr("native_material.set_param_color: node is no longer valid, id ", node_id);
+		LUAGD_REPORT_ERROR("native_material", "set_param_color", "node is no longer valid, id ", node_id);
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
@@ -148,21 +152,21 @@ static int l_set_param_color(lua_State *p_L) {
 // set_param_vec3(node_id, param_name, x, y, z) -> bool
 // 在节点的直接子节点中设置实例着色器Vector3参数。
 static int l_set_param_vec3(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	const char *param_name = luaL_checkstring(p_L, 2);
 	const double x = luaL_checknumber(p_L, 3);
 	const double y = luaL_checknumber(p_L, 4);
 	const double z = luaL_checknumber(p_L, 5);
 
-	if (node_id.is_null()) {
-		godot::UtilityFunctions::printerr("native_material.set_param_vec3: node id is 0");
+	if (node_id == 0) {
+		LUAGD_REPORT_ERROR("native_material", "set_param_vec3", "node id is 0");
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
 
 	godot::Node3D *root_node_3d = node_resolve(node_id);
 	if (root_node_3d == nullptr) {
-		godot::UtilityFunctions::printerr("native_material.set_param_vec3: node is no longer valid, id ", node_id);
+		LUAGD_REPORT_ERROR("native_material", "set_param_vec3", "node is no longer valid, id ", node_id);
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
@@ -185,19 +189,19 @@ static int l_set_param_vec3(lua_State *p_L) {
 // set_param_float(node_id, param_name, value) -> bool
 // 在节点的直接子节点中设置实例着色器float参数。
 static int l_set_param_float(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	const char *param_name = luaL_checkstring(p_L, 2);
 	const double value = luaL_checknumber(p_L, 3);
 
-	if (node_id.is_null()) {
-		godot::UtilityFunctions::printerr("native_material.set_param_float: node id is 0");
+	if (node_id == 0) {
+		LUAGD_REPORT_ERROR("native_material", "set_param_float", "node id is 0");
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
 
 	godot::Node3D *root_node_3d = node_resolve(node_id);
 	if (root_node_3d == nullptr) {
-		godot::UtilityFunctions::printerr("native_material.set_param_float: node is no longer valid, id ", node_id);
+		LUAGD_REPORT_ERROR("native_material", "set_param_float", "node is no longer valid, id ", node_id);
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
@@ -220,32 +224,32 @@ static int l_set_param_float(lua_State *p_L) {
 // set_material_override(node_id, material_path) -> count
 // 设置节点自身及其直接子节点的material_override属性。
 static int l_set_material_override(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	const char *material_path = luaL_checkstring(p_L, 2);
 
-	if (node_id.is_null()) {
-		godot::UtilityFunctions::printerr("native_material.set_material_override: node id is 0");
+	if (node_id == 0) {
+		LUAGD_REPORT_ERROR("native_material", "set_material_override", "node id is 0");
 		lua_pushinteger(p_L, 0);
 		return 1;
 	}
 
 	godot::Node3D *root_node_3d = node_resolve(node_id);
 	if (root_node_3d == nullptr) {
-		godot::UtilityFunctions::printerr("native_material.set_material_override: node is no longer valid, id ", node_id);
+		LUAGD_REPORT_ERROR("native_material", "set_material_override", "node is no longer valid, id ", node_id);
 		lua_pushinteger(p_L, 0);
 		return 1;
 	}
 
 	godot::Ref<godot::Resource> resource = godot::ResourceLoader::get_singleton()->load(godot::String(material_path));
 	if (resource.is_null()) {
-		godot::UtilityFunctions::printerr("native_material.set_material_override: failed to load material: ", material_path);
+		LUAGD_REPORT_ERROR("native_material", "set_material_override", "failed to load material: ", material_path);
 		lua_pushinteger(p_L, 0);
 		return 1;
 	}
 
 	godot::Ref<godot::Material> material = resource;
 	if (material.is_null()) {
-		godot::UtilityFunctions::printerr("native_material.set_material_override: resource is not a Material: ", material_path);
+		LUAGD_REPORT_ERROR("native_material", "set_material_override", "resource is not a Material: ", material_path);
 		lua_pushinteger(p_L, 0);
 		return 1;
 	}
@@ -268,17 +272,17 @@ static int l_set_material_override(lua_State *p_L) {
 // 设置节点自身及其直接子节点的material_overlay属性。
 // material_path为nil时清空overlay。
 static int l_set_material_overlay(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 
-	if (node_id.is_null()) {
-		godot::UtilityFunctions::printerr("native_material.set_material_overlay: node id is 0");
+	if (node_id == 0) {
+		LUAGD_REPORT_ERROR("native_material", "set_material_overlay", "node id is 0");
 		lua_pushinteger(p_L, 0);
 		return 1;
 	}
 
 	godot::Node3D *root_node_3d = node_resolve(node_id);
 	if (root_node_3d == nullptr) {
-		godot::UtilityFunctions::printerr("native_material.set_material_overlay: node is no longer valid, id ", node_id);
+		LUAGD_REPORT_ERROR("native_material", "set_material_overlay", "node is no longer valid, id ", node_id);
 		lua_pushinteger(p_L, 0);
 		return 1;
 	}
@@ -297,14 +301,14 @@ static int l_set_material_overlay(lua_State *p_L) {
 
 		godot::Ref<godot::Resource> resource = godot::ResourceLoader::get_singleton()->load(godot::String(material_path));
 		if (resource.is_null()) {
-			godot::UtilityFunctions::printerr("native_material.set_material_overlay: failed to load material: ", material_path);
+			LUAGD_REPORT_ERROR("native_material", "set_material_overlay", "failed to load material: ", material_path);
 			lua_pushinteger(p_L, 0);
 			return 1;
 		}
 
 		material = resource;
 		if (material.is_null()) {
-			godot::UtilityFunctions::printerr("native_material.set_material_overlay: resource is not a Material: ", material_path);
+			LUAGD_REPORT_ERROR("native_material", "set_material_overlay", "resource is not a Material: ", material_path);
 			lua_pushinteger(p_L, 0);
 			return 1;
 		}
@@ -321,18 +325,18 @@ static int l_set_material_overlay(lua_State *p_L) {
 // set_transparency(node_id, transparency) -> count
 // 设置节点自身及其直接子节点的transparency属性。
 static int l_set_transparency(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	const double transparency = luaL_checknumber(p_L, 2);
 
-	if (node_id.is_null()) {
-		godot::UtilityFunctions::printerr("native_material.set_transparency: node id is 0");
+	if (node_id == 0) {
+		LUAGD_REPORT_ERROR("native_material", "set_transparency", "node id is 0");
 		lua_pushinteger(p_L, 0);
 		return 1;
 	}
 
 	godot::Node3D *root_node_3d = node_resolve(node_id);
 	if (root_node_3d == nullptr) {
-		godot::UtilityFunctions::printerr("native_material.set_transparency: node is no longer valid, id ", node_id);
+		LUAGD_REPORT_ERROR("native_material", "set_transparency", "node is no longer valid, id ", node_id);
 		lua_pushinteger(p_L, 0);
 		return 1;
 	}
@@ -355,18 +359,18 @@ static int l_set_transparency(lua_State *p_L) {
 // 设置节点自身及其直接子节点的阴影投射开关。
 // enabled: true=投射阴影(ON)，false=关闭阴影(OFF)。
 static int l_enable_cast_shadow(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	const bool enabled = lua_toboolean(p_L, 2);
 
-	if (node_id.is_null()) {
-		godot::UtilityFunctions::printerr("native_material.enable_cast_shadow: node id is 0");
+	if (node_id == 0) {
+		LUAGD_REPORT_ERROR("native_material", "enable_cast_shadow", "node id is 0");
 		lua_pushinteger(p_L, 0);
 		return 1;
 	}
 
 	godot::Node3D *root_node_3d = node_resolve(node_id);
 	if (root_node_3d == nullptr) {
-		godot::UtilityFunctions::printerr("native_material.enable_cast_shadow: node is no longer valid, id ", node_id);
+		LUAGD_REPORT_ERROR("native_material", "enable_cast_shadow", "node is no longer valid, id ", node_id);
 		lua_pushinteger(p_L, 0);
 		return 1;
 	}
@@ -393,17 +397,17 @@ static int l_enable_cast_shadow(lua_State *p_L) {
 // 复制节点自身及其直接子节点（MeshInstance3D）的材质。
 // 复制 material_override 与所有 surface_override_material，避免材质复用导致动画驱动产生问题。
 static int l_duplicate_materials(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 
-	if (node_id.is_null()) {
-		godot::UtilityFunctions::printerr("native_material.duplicate_materials: node id is 0");
+	if (node_id == 0) {
+		LUAGD_REPORT_ERROR("native_material", "duplicate_materials", "node id is 0");
 		lua_pushinteger(p_L, 0);
 		return 1;
 	}
 
 	godot::Node3D *root_node_3d = node_resolve(node_id);
 	if (root_node_3d == nullptr) {
-		godot::UtilityFunctions::printerr("native_material.duplicate_materials: node is no longer valid, id ", node_id);
+		LUAGD_REPORT_ERROR("native_material", "duplicate_materials", "node is no longer valid, id ", node_id);
 		lua_pushinteger(p_L, 0);
 		return 1;
 	}
@@ -495,7 +499,7 @@ static const luaL_Reg material_funcs[] = {
 };
 
 int luaopen_native_material(lua_State *p_L) {
-	luaL_newlib(p_L, material_funcs);
+	lua_binding_new_lib(p_L, "native_material", material_funcs);
 	return 1;
 }
 
@@ -0,0 +1,781 @@
+#include "math_module.h"
+
+#include "../lua/lua_binding_stats.h"
+
+#include <godot_cpp/core/math.hpp>
+#include <godot_cpp/variant/basis.hpp>
+
+#include <new>
+
+extern "C" {
+#include <lua.h>
+#include <lauxlib.h>
+}
+
+namespace luagd {
+
+static const char *VECTOR3_METATABLE = "native_math.Vector3";
+static const char *QUATERNION_METATABLE = "native_math.Quaternion";
+static const char *TRANSFORM_METATABLE = "native_math.Transform3D";
+
+static void _push_vector3_metatable(lua_State *p_L);
+static void _push_quaternion_metatable(lua_State *p_L);
+static void _push_transform_metatable(lua_State *p_L);
+
+template <typename T>
+static T *_new_value(lua_State *p_L, const T &p_value, void (*p_push_metatable)(lua_State *)) {
+	T *value = (T *)lua_newuserdatauv(p_L, sizeof(T), 0);
+	new (value) T(p_value);
+	p_push_metatable(p_L);
+	lua_setmetatable(p_L, -2);
+	return value;
+}
+
+static godot::Vector3 *_check_vector3(lua_State *p_L, int p_index) {
+	return (godot::Vector3 *)luaL_checkudata(p_L, p_index, VECTOR3_METATABLE);
+}
+
+static godot::Quaternion *_check_quaternion(lua_State *p_L, int p_index) {
+	return (godot::Quaternion *)luaL_checkudata(p_L, p_index, QUATERNION_METATABLE);
+}
+
+static godot::Transform3D *_check_transform(lua_State *p_L, int p_index) {
+	return (godot::Transform3D *)luaL_checkudata(p_L, p_index, TRANSFORM_METATABLE);
+}
+
+static godot::Vector3 _deg_to_rad(const godot::Vector3 &p_degrees) {
+	return godot::Vector3(
+			godot::Math::deg_to_rad(p_degrees.x),
+			godot::Math::deg_to_rad(p_degrees.y),
+			godot::Math::deg_to_rad(p_degrees.z));
+}
+
+static godot::Vector3 _rad_to_deg(const godot::Vector3 &p_radians) {
+	return godot::Vector3(
+			godot::Math::rad_to_deg(p_radians.x),
+			godot::Math::rad_to_deg(p_radians.y),
+			godot::Math::rad_to_deg(p_radians.z));
+}
+
+// 单字符分量名（x / y / z / w）对应的下标，不是分量名时返回 -1。
+static int _component_index(lua_State *p_L, int p_key_index, int p_count) {
+	if (lua_type(p_L, p_key_index) != LUA_TSTRING) {
+		return -1;
+	}
+	size_t length = 0;
+	const char *key = lua_tolstring(p_L, p_key_index, &length);
+	if (length != 1) {
+		return -1;
+	}
+	switch (key[0]) {
+		case 'x':
+			return 0;
+		case 'y':
+			return 1;
+		case 'z':
+			return 2;
+		case 'w':
+			return p_count == 4 ? 3 : -1;
+		default:
+			return -1;
+	}
+}
+
+// __index：分量名读分量，其余键查方法表（upvalue 1）。T 需支持 operator[]。
+template <typename T, int N>
+static int _index_components(lua_State *p_L) {
+	const T *value = (const T *)lua_touserdata(p_L, 1);
+	const int component = _component_index(p_L, 2, N);
+	if (component >= 0) {
+		lua_pushnumber(p_L, (*value)[component]);
+		return 1;
+	}
+	lua_pushvalue(p_L, 2);
+	lua_rawget(p_L, lua_upvalueindex(1));
+	return 1;
+}
+
+template <typename T, int N>
+static int _newindex_components(lua_State *p_L) {
+	T *value = (T *)lua_touserdata(p_L, 1);
+	const int component = _component_index(p_L, 2, N);
+	if (component < 0) {
+		return luaL_error(p_L, "cannot set field '%s'", luaL_tolstring(p_L, 2, nullptr));
+	}
+	(*value)[component] = (real_t)luaL_checknumber(p_L, 3);
+	return 0;
+}
+
+// 创建元表：p_meta 为元方法，p_methods 放入 __index 闭包的 upvalue。
+static bool _new_metatable(lua_State *p_L, const char *p_name, const luaL_Reg *p_meta, const luaL_Reg *p_methods, lua_CFunction p_index) {
+	if (luaL_newmetatable(p_L, p_name) == 0) {
+		return false;
+	}
+	luaL_setfuncs(p_L, p_meta, 0);
+	lua_newtable(p_L);
+	luaL_setfuncs(p_L, p_methods, 0);
+	lua_pushcclosure(p_L, p_index, 1);
+	lua_setfield(p_L, -2, "__index");
+	return true;
+}
+
+// ============================================================================
+// Vector3
+// ============================================================================
+
+// Vector3 或数字（展开为三个分量相同的向量）运算数。
+static godot::Vector3 _check_vector3_operand(lua_State *p_L, int p_index) {
+	const godot::Vector3 *vector = math_test_vector3(p_L, p_index);
+	if (vector != nullptr) {
+		return *vector;
+	}
+	if (lua_type(p_L, p_index) != LUA_TNUMBER) {
+		luaL_typeerror(p_L, p_index, "Vector3 or number");
+	}
+	const real_t scalar = (real_t)lua_tonumber(p_L, p_index);
+	return godot::Vector3(scalar, scalar, scalar);
+}
+
+static int v_add(lua_State *p_L) {
+	math_push_vector3(p_L, *_check_vector3(p_L, 1) + *_check_vector3(p_L, 2));
+	return 1;
+}
+
+static int v_sub(lua_State *p_L) {
+	math_push_vector3(p_L, *_check_vector3(p_L, 1) - *_check_vector3(p_L, 2));
+	return 1;
+}
+
+static int v_mul(lua_State *p_L) {
+	math_push_vector3(p_L, _check_vector3_operand(p_L, 1) * _check_vector3_operand(p_L, 2));
+	return 1;
+}
+
+static int v_div(lua_State *p_L) {
+	math_push_vector3(p_L, _check_vector3_operand(p_L, 1) / _check_vector3_operand(p_L, 2));
+	return 1;
+}
+
+static int v_unm(lua_State *p_L) {
+	math_push_vector3(p_L, -*_check_vector3(p_L, 1));
+	return 1;
+}
+
+static int v_eq(lua_State *p_L) {
+	const godot::Vector3 *a = math_test_vector3(p_L, 1);
+	const godot::Vector3 *b = math_test_vector3(p_L, 2);
+	lua_pushboolean(p_L, a != nullptr && b != nullptr && *a == *b);
+	return 1;
+}
+
+static int v_tostring(lua_State *p_L) {
+	const godot::Vector3 *v = _check_vector3(p_L, 1);
+	lua_pushfstring(p_L, "Vector3(%f, %f, %f)", (lua_Number)v->x, (lua_Number)v->y, (lua_Number)v->z);
+	return 1;
+}
+
+// v:length() -> number
+static int v_length(lua_State *p_L) {
+	lua_pushnumber(p_L, _check_vector3(p_L, 1)->length());
+	return 1;
+}
+
+// v:length_squared() -> number
+static int v_length_squared(lua_State *p_L) {
+	lua_pushnumber(p_L, _check_vector3(p_L, 1)->length_squared());
+	return 1;
+}
+
+// v:normalized() -> Vector3
+static int v_normalized(lua_State *p_L) {
+	math_push_vector3(p_L, _check_vector3(p_L, 1)->normalized());
+	return 1;
+}
+
+// v:dot(b) -> number
+static int v_dot(lua_State *p_L) {
+	lua_pushnumber(p_L, _check_vector3(p_L, 1)->dot(*_check_vector3(p_L, 2)));
+	return 1;
+}
+
+// v:cross(b) -> Vector3
+static int v_cross(lua_State *p_L) {
+	math_push_vector3(p_L, _check_vector3(p_L, 1)->cross(*_check_vector3(p_L, 2)));
+	return 1;
+}
+
+// v:distance_to(b) -> number
+static int v_distance_to(lua_State *p_L) {
+	lua_pushnumber(p_L, _check_vector3(p_L, 1)->distance_to(*_check_vector3(p_L, 2)));
+	return 1;
+}
+
+// v:distance_squared_to(b) -> number
+static int v_distance_squared_to(lua_State *p_L) {
+	lua_pushnumber(p_L, _check_vector3(p_L, 1)->distance_squared_to(*_check_vector3(p_L, 2)));
+	return 1;
+}
+
+// v:lerp(b, t) -> Vector3
+static int v_lerp(lua_State *p_L) {
+	const godot::Vector3 *v = _check_vector3(p_L, 1);
+	math_push_vector3(p_L, v->lerp(*_check_vector3(p_L, 2), (real_t)luaL_checknumber(p_L, 3)));
+	return 1;
+}
+
+// v:copy() -> Vector3
+static int v_copy(lua_State *p_L) {
+	math_push_vector3(p_L, *_check_vector3(p_L, 1));
+	return 1;
+}
+
+// v:unpack() -> x, y, z
+static int v_unpack(lua_State *p_L) {
+	const godot::Vector3 *v = _check_vector3(p_L, 1);
+	lua_pushnumber(p_L, v->x);
+	lua_pushnumber(p_L, v->y);
+	lua_pushnumber(p_L, v->z);
+	return 3;
+}
+
+// 以下原地修改的方法返回 self，可链式调用。
+
+// v:set(x, y, z) / v:set(b) -> self
+static int v_set(lua_State *p_L) {
+	godot::Vector3 *v = _check_vector3(p_L, 1);
+	math_check_vector3(p_L, 2, *v);
+	lua_settop(p_L, 1);
+	return 1;
+}
+
+// v:add_in_place(b) -> self
+static int v_add_in_place(lua_State *p_L) {
+	*_check_vector3(p_L, 1) += *_check_vector3(p_L, 2);
+	lua_settop(p_L, 1);
+	return 1;
+}
+
+// v:sub_in_place(b) -> self
+static int v_sub_in_place(lua_State *p_L) {
+	*_check_vector3(p_L, 1) -= *_check_vector3(p_L, 2);
+	lua_settop(p_L, 1);
+	return 1;
+}
+
+// v:mul_in_place(b | number) -> self
+static int v_mul_in_place(lua_State *p_L) {
+	*_check_vector3(p_L, 1) *= _check_vector3_operand(p_L, 2);
+	lua_settop(p_L, 1);
+	return 1;
+}
+
+// v:add_scaled_in_place(b, s) -> self
+// v += b * s，常用于 position += velocity * delta。
+static int v_add_scaled_in_place(lua_State *p_L) {
+	godot::Vector3 *v = _check_vector3(p_L, 1);
+	*v += *_check_vector3(p_L, 2) * (real_t)luaL_checknumber(p_L, 3);
+	lua_settop(p_L, 1);
+	return 1;
+}
+
+// v:normalize_in_place() -> self
+static int v_normalize_in_place(lua_State *p_L) {
+	_check_vector3(p_L, 1)->normalize();
+	lua_settop(p_L, 1);
+	return 1;
+}
+
+// v:lerp_in_place(b, t) -> self
+static int v_lerp_in_place(lua_State *p_L) {
+	godot::Vector3 *v = _check_vector3(p_L, 1);
+	*v = v->lerp(*_check_vector3(p_L, 2), (real_t)luaL_checknumber(p_L, 3));
+	lua_settop(p_L, 1);
+	return 1;
+}
+
+static const luaL_Reg vector3_meta[] = {
+	{"__add", v_add},
+	{"__sub", v_sub},
+	{"__mul", v_mul},
+	{"__div", v_div},
+	{"__unm", v_unm},
+	{"__eq", v_eq},
+	{"__tostring", v_tostring},
+	{"__newindex", _newindex_components<godot::Vector3, 3>},
+	{nullptr, nullptr}
+};
+
+static const luaL_Reg vector3_methods[] = {
+	{"length", v_length},
+	{"length_squared", v_length_squared},
+	{"normalized", v_normalized},
+	{"dot", v_dot},
+	{"cross", v_cross},
+	{"distance_to", v_distance_to},
+	{"distance_squared_to", v_distance_squared_to},
+	{"lerp", v_lerp},
+	{"copy", v_copy},
+	{"unpack", v_unpack},
+	{"set", v_set},
+	{"add_in_place", v_add_in_place},
+	{"sub_in_place", v_sub_in_place},
+	{"mul_in_place", v_mul_in_place},
+	{"add_scaled_in_place", v_add_scaled_in_place},
+	{"normalize_in_place", v_normalize_in_place},
+	{"lerp_in_place", v_lerp_in_place},
+	{nullptr, nullptr}
+};
+
+static void _push_vector3_metatable(lua_State *p_L) {
+	_new_metatable(p_L, VECTOR3_METATABLE, vector3_meta, vector3_methods, _index_components<godot::Vector3, 3>);
+}
+
+// ============================================================================
+// Quaternion
+// ============================================================================
+
+// q * q -> Quaternion，q * v -> Vector3（旋转向量）
+static int q_mul(lua_State *p_L) {
+	const godot::Quaternion *q = _check_quaternion(p_L, 1);
+	const godot::Vector3 *v = math_test_vector3(p_L, 2);
+	if (v != nullptr) {
+		math_push_vector3(p_L, q->xform(*v));
+		return 1;
+	}
+	math_push_quaternion(p_L, *q * *_check_quaternion(p_L, 2));
+	return 1;
+}
+
+static int q_eq(lua_State *p_L) {
+	const godot::Quaternion *a = math_test_quaternion(p_L, 1);
+	const godot::Quaternion *b = math_test_quaternion(p_L, 2);
+	lua_pushboolean(p_L, a != nullptr && b != nullptr && *a == *b);
+	return 1;
+}
+
+static int q_tostring(lua_State *p_L) {
+	const godot::Quaternion *q = _check_quaternion(p_L, 1);
+	lua_pushfstring(p_L, "Quaternion(%f, %f, %f, %f)", (lua_Number)q->x, (lua_Number)q->y, (lua_Number)q->z, (lua_Number)q->w);
+	return 1;
+}
+
+// q:normalized() -> Quaternion
+static int q_normalized(lua_State *p_L) {
+	math_push_quaternion(p_L, _check_quaternion(p_L, 1)->normalized());
+	return 1;
+}
+
+// q:inverse() -> Quaternion
+static int q_inverse(lua_State *p_L) {
+	math_push_quaternion(p_L, _check_quaternion(p_L, 1)->inverse());
+	return 1;
+}
+
+// q:dot(b) -> number
+static int q_dot(lua_State *p_L) {
+	lua_pushnumber(p_L, _check_quaternion(p_L, 1)->dot(*_check_quaternion(p_L, 2)));
+	return 1;
+}
+
+// q:slerp(b, t) -> Quaternion
+static int q_slerp(lua_State *p_L) {
+	const godot::Quaternion *q = _check_quaternion(p_L, 1);
+	math_push_quaternion(p_L, q->slerp(*_check_quaternion(p_L, 2), (real_t)luaL_checknumber(p_L, 3)));
+	return 1;
+}
+
+// q:xform(v) -> Vector3
+static int q_xform(lua_State *p_L) {
+	math_push_vector3(p_L, _check_quaternion(p_L, 1)->xform(*_check_vector3(p_L, 2)));
+	return 1;
+}
+
+// q:to_euler() -> Vector3（度数，YXZ 顺序，与 Node3D 默认一致）
+static int q_to_euler(lua_State *p_L) {
+	math_push_vector3(p_L, _rad_to_deg(_check_quaternion(p_L, 1)->get_euler()));
+	return 1;
+}
+
+// q:copy() -> Quaternion
+static int q_copy(lua_State *p_L) {
+	math_push_quaternion(p_L, *_check_quaternion(p_L, 1));
+	return 1;
+}
+
+// q:unpack() -> x, y, z, w
+static int q_unpack(lua_State *p_L) {
+	const godot::Quaternion *q = _check_quaternion(p_L, 1);
+	lua_pushnumber(p_L, q->x);
+	lua_pushnumber(p_L, q->y);
+	lua_pushnumber(p_L, q->z);
+	lua_pushnumber(p_L, q->w);
+	return 4;
+}
+
+// q:set(b) -> self
+static int q_set(lua_State *p_L) {
+	*_check_quaternion(p_L, 1) = *_check_quaternion(p_L, 2);
+	lua_settop(p_L, 1);
+	return 1;
+}
+
+// q:mul_in_place(b) -> self
+static int q_mul_in_place(lua_State *p_L) {
+	*_check_quaternion(p_L, 1) *= *_check_quaternion(p_L, 2);
+	lua_settop(p_L, 1);
+	return 1;
+}
+
+// q:normalize_in_place() -> self
+static int q_normalize_in_place(lua_State *p_L) {
+	_check_quaternion(p_L, 1)->normalize();
+	lua_settop(p_L, 1);
+	return 1;
+}
+
+// q:slerp_in_place(b, t) -> self
+static int q_slerp_in_place(lua_State *p_L) {
+	godot::Quaternion *q = _check_quaternion(p_L, 1);
+	*q = q->slerp(*_check_quaternion(p_L, 2), (real_t)luaL_checknumber(p_L, 3));
+	lua_settop(p_L, 1);
+	return 1;
+}
+
+static const luaL_Reg quaternion_meta[] = {
+	{"__mul", q_mul},
+	{"__eq", q_eq},
+	{"__tostring", q_tostring},
+	{"__newindex", _newindex_components<godot::Quaternion, 4>},
+	{nullptr, nullptr}
+};
+
+static const luaL_Reg quaternion_methods[] = {
+	{"normalized", q_normalized},
+	{"inverse", q_inverse},
+	{"dot", q_dot},
+	{"slerp", q_slerp},
+	{"xform", q_xform},
+	{"to_euler", q_to_euler},
+	{"copy", q_copy},
+	{"unpack", q_unpack},
+	{"set", q_set},
+	{"mul_in_place", q_mul_in_place},
+	{"normalize_in_place", q_normalize_in_place},
+	{"slerp_in_place", q_slerp_in_place},
+	{nullptr, nullptr}
+};
+
+static void _push_quaternion_metatable(lua_State *p_L) {
+	_new_metatable(p_L, QUATERNION_METATABLE, quaternion_meta, quaternion_methods, _index_components<godot::Quaternion, 4>);
+}
+
+// ============================================================================
+// Transform3D
+// ============================================================================
+
+// t * t -> Transform3D，t * v -> Vector3（变换点）
+static int t_mul(lua_State *p_L) {
+	const godot::Transform3D *t = _check_transform(p_L, 1);
+	const godot::Vector3 *v = math_test_vector3(p_L, 2);
+	if (v != nullptr) {
+		math_push_vector3(p_L, t->xform(*v));
+		return 1;
+	}
+	math_push_transform(p_L, *t * *_check_transform(p_L, 2));
+	return 1;
+}
+
+static int t_eq(lua_State *p_L) {
+	const godot::Transform3D *a = math_test_transform(p_L, 1);
+	const godot::Transform3D *b = math_test_transform(p_L, 2);
+	lua_pushboolean(p_L, a != nullptr && b != nullptr && *a == *b);
+	return 1;
+}
+
+static int t_tostring(lua_State *p_L) {
+	const godot::Transform3D *t = _check_transform(p_L, 1);
+	lua_pushfstring(p_L, "Transform3D(origin=(%f, %f, %f))", (lua_Number)t->origin.x, (lua_Number)t->origin.y, (lua_Number)t->origin.z);
+	return 1;
+}
+
+// t:origin(out) -> Vector3
+// out 为 Vector3 时写入并返回 out，否则新建。
+static int t_origin(lua_State *p_L) {
+	const godot::Transform3D *t = _check_transform(p_L, 1);
+	if (!math_write_vector3(p_L, 2, t->origin)) {
+		math_push_vector3(p_L, t->origin);
+	}
+	return 1;
+}
+
+// t:scale(out) -> Vector3
+static int t_scale(lua_State *p_L) {
+	const godot::Vector3 scale = _check_transform(p_L, 1)->basis.get_scale();
+	if (!math_write_vector3(p_L, 2, scale)) {
+		math_push_vector3(p_L, scale);
+	}
+	return 1;
+}
+
+// t:rotation() -> Quaternion
+static int t_rotation(lua_State *p_L) {
+	math_push_quaternion(p_L, _check_transform(p_L, 1)->basis.get_rotation_quaternion());
+	return 1;
+}
+
+// t:inverse() -> Transform3D（允许缩放的仿射逆）
+static int t_inverse(lua_State *p_L) {
+	math_push_transform(p_L, _check_transform(p_L, 1)->affine_inverse());
+	return 1;
+}
+
+// t:xform(v) -> Vector3
+static int t_xform(lua_State *p_L) {
+	math_push_vector3(p_L, _check_transform(p_L, 1)->xform(*_check_vector3(p_L, 2)));
+	return 1;
+}
+
+// t:xform_inv(v) -> Vector3（仅适用于正交基）
+static int t_xform_inv(lua_State *p_L) {
+	math_push_vector3(p_L, _check_transform(p_L, 1)->xform_inv(*_check_vector3(p_L, 2)));
+	return 1;
+}
+
+// t:copy() -> Transform3D
+static int t_copy(lua_State *p_L) {
+	math_push_transform(p_L, *_check_transform(p_L, 1));
+	return 1;
+}
+
+// t:set(b) -> self
+static int t_set(lua_State *p_L) {
+	*_check_transform(p_L, 1) = *_check_transform(p_L, 2);
+	lua_settop(p_L, 1);
+	return 1;
+}
+
+// t:set_origin(v) / t:set_origin(x, y, z) -> self
+static int t_set_origin(lua_State *p_L) {
+	godot::Transform3D *t = _check_transform(p_L, 1);
+	math_check_vector3(p_L, 2, t->origin);
+	lua_settop(p_L, 1);
+	return 1;
+}
+
+// t:set_rotation(q) -> self（保留缩放）
+static int t_set_rotation(lua_State *p_L) {
+	godot::Transform3D *t = _check_transform(p_L, 1);
+	const godot::Vector3 scale = t->basis.get_scale();
+	t->basis.set_quaternion_scale(*_check_quaternion(p_L, 2), scale);
+	lua_settop(p_L, 1);
+	return 1;
+}
+
+// t:set_scale(v) / t:set_scale(x, y, z) -> self（保留旋转）
+static int t_set_scale(lua_State *p_L) {
+	godot::Transform3D *t = _check_transform(p_L, 1);
+	godot::Vector3 scale;
+	math_check_vector3(p_L, 2, scale);
+	const godot::Quaternion rotation = t->basis.get_rotation_quaternion();
+	t->basis.set_quaternion_scale(rotation, scale);
+	lua_settop(p_L, 1);
+	return 1;
+}
+
+// t:translate_in_place(v) / t:translate_in_place(x, y, z) -> self（世界空间平移）
+static int t_translate_in_place(lua_State *p_L) {
+	godot::Transform3D *t = _check_transform(p_L, 1);
+	godot::Vector3 offset;
+	math_check_vector3(p_L, 2, offset);
+	t->origin += offset;
+	lua_settop(p_L, 1);
+	return 1;
+}
+
+// t:mul_in_place(b) -> self（t = t * b）
+static int t_mul_in_place(lua_State *p_L) {
+	*_check_transform(p_L, 1) *= *_check_transform(p_L, 2);
+	lua_settop(p_L, 1);
+	return 1;
+}
+
+static const luaL_Reg transform_meta[] = {
+	{"__mul", t_mul},
+	{"__eq", t_eq},
+	{"__tostring", t_tostring},
+	{nullptr, nullptr}
+};
+
+static const luaL_Reg transform_methods[] = {
+	{"origin", t_origin},
+	{"scale", t_scale},
+	{"rotation", t_rotation},
+	{"inverse", t_inverse},
+	{"xform", t_xform},
+	{"xform_inv", t_xform_inv},
+	{"copy", t_copy},
+	{"set", t_set},
+	{"set_origin", t_set_origin},
+	{"set_rotation", t_set_rotation},
+	{"set_scale", t_set_scale},
+	{"translate_in_place", t_translate_in_place},
+	{"mul_in_place", t_mul_in_place},
+	{nullptr, nullptr}
+};
+
+// Transform3D 没有分量字段，__index 直接查方法表
+static int t_index(lua_State *p_L) {
+	lua_pushvalue(p_L, 2);
+	lua_rawget(p_L, lua_upvalueindex(1));
+	return 1;
+}
+
+static void _push_transform_metatable(lua_State *p_L) {
+	_new_metatable(p_L, TRANSFORM_METATABLE, transform_meta, transform_methods, t_index);
+}
+
+// ============================================================================
+// 模块函数
+// ============================================================================
+
+// vec3(x, y, z) / vec3(v) -> Vector3
+// 省略参数时为零向量。
+static int l_vec3(lua_State *p_L) {
+	godot::Vector3 value;
+	if (!lua_isnoneornil(p_L, 1)) {
+		math_check_vector3(p_L, 1, value);
+	}
+	math_push_vector3(p_L, value);
+	return 1;
+}
+
+// quat(x, y, z, w) -> Quaternion
+// 省略参数时为单位四元数。
+static int l_quat(lua_State *p_L) {
+	if (lua_isnoneornil(p_L, 1)) {
+		math_push_quaternion(p_L, godot::Quaternion());
+		return 1;
+	}
+	math_push_quaternion(p_L, godot::Quaternion(
+			(real_t)luaL_checknumber(p_L, 1),
+			(real_t)luaL_checknumber(p_L, 2),
+			(real_t)luaL_checknumber(p_L, 3),
+			(real_t)luaL_checknumber(p_L, 4)));
+	return 1;
+}
+
+// quat_from_euler(x, y, z) / quat_from_euler(v) -> Quaternion
+// 欧拉角为度数（YXZ 顺序）。
+static int l_quat_from_euler(lua_State *p_L) {
+	godot::Vector3 degrees;
+	math_check_vector3(p_L, 1, degrees);
+	math_push_quaternion(p_L, godot::Quaternion::from_euler(_deg_to_rad(degrees)));
+	return 1;
+}
+
+// quat_from_axis_angle(axis, degrees) -> Quaternion
+// axis 可为 Vector3 或三个数字，内部会归一化。
+static int l_quat_from_axis_angle(lua_State *p_L) {
+	godot::Vector3 axis;
+	const int consumed = math_check_vector3(p_L, 1, axis);
+	const real_t degrees = (real_t)luaL_checknumber(p_L, 1 + consumed);
+	luaL_argcheck(p_L, axis.length_squared() > 0, 1, "axis must not be zero");
+	math_push_quaternion(p_L, godot::Quaternion(axis.normalized(), godot::Math::deg_to_rad(degrees)));
+	return 1;
+}
+
+// transform(origin, rotation, scale) -> Transform3D
+// origin: Vector3，rotation: Quaternion，scale: Vector3，均可省略（单位变换）。
+static int l_transform(lua_State *p_L) {
+	godot::Transform3D value;
+	if (!lua_isnoneornil(p_L, 1)) {
+		value.origin = *_check_vector3(p_L, 1);
+	}
+	const godot::Quaternion rotation = lua_isnoneornil(p_L, 2) ? godot::Quaternion() : *_check_quaternion(p_L, 2);
+	const godot::Vector3 scale = lua_isnoneornil(p_L, 3) ? godot::Vector3(1, 1, 1) : *_check_vector3(p_L, 3);
+	value.basis.set_quaternion_scale(rotation, scale);
+	math_push_transform(p_L, value);
+	return 1;
+}
+
+static const luaL_Reg math_funcs[] = {
+	{"vec3", l_vec3},
+	{"quat", l_quat},
+	{"quat_from_euler", l_quat_from_euler},
+	{"quat_from_axis_angle", l_quat_from_axis_angle},
+	{"transform", l_transform},
+	{nullptr, nullptr}
+};
+
+int luaopen_native_math(lua_State *p_L) {
+	lua_binding_new_lib(p_L, "native_math", math_funcs);
+	return 1;
+}
+
+int math_check_vector3(lua_State *p_L, int p_index, godot::Vector3 &r_value) {
+	const godot::Vector3 *vector = math_test_vector3(p_L, p_index);
+	if (vector != nullptr) {
+		r_value = *vector;
+		return 1;
+	}
+	r_value = godot::Vector3(
+			(real_t)luaL_checknumber(p_L, p_index),
+			(real_t)luaL_checknumber(p_L, p_index + 1),
+			(real_t)luaL_checknumber(p_L, p_index + 2));
+	return 3;
+}
+
+godot::Vector3 *math_test_vector3(lua_State *p_L, int p_index) {
+	if (lua_type(p_L, p_index) != LUA_TUSERDATA) {
+		return nullptr;
+	}
+	return (godot::Vector3 *)luaL_testudata(p_L, p_index, VECTOR3_METATABLE);
+}
+
+godot::Quaternion *math_test_quaternion(lua_State *p_L, int p_index) {
+	if (lua_type(p_L, p_index) != LUA_TUSERDATA) {
+		return nullptr;
+	}
+	return (godot::Quaternion *)luaL_testudata(p_L, p_index, QUATERNION_METATABLE);
+}
+
+godot::Transform3D *math_test_transform(lua_State *p_L, int p_index) {
+	if (lua_type(p_L, p_index) != LUA_TUSERDATA) {
+		return nullptr;
+	}
+	return (godot::Transform3D *)luaL_testudata(p_L, p_index, TRANSFORM_METATABLE);
+}
+
+void math_push_vector3(lua_State *p_L, const godot::Vector3 &p_value) {
+	_new_value(p_L, p_value, _push_vector3_metatable);
+}
+
+void math_push_quaternion(lua_State *p_L, const godot::Quaternion &p_value) {
+	_new_value(p_L, p_value, _push_quaternion_metatable);
+}
+
+void math_push_transform(lua_State *p_L, const godot::Transform3D &p_value) {
+	_new_value(p_L, p_value, _push_transform_metatable);
+}
+
+bool math_write_vector3(lua_State *p_L, int p_index, const godot::Vector3 &p_value) {
+	godot::Vector3 *out = math_test_vector3(p_L, p_index);
+	if (out == nullptr) {
+		return false;
+	}
+	*out = p_value;
+	lua_pushvalue(p_L, p_index);
+	return true;
+}
+
+int math_return_vector3(lua_State *p_L, int p_out_index, const godot::Vector3 &p_value) {
+	if (math_write_vector3(p_L, p_out_index, p_value)) {
+		return 1;
+	}
+	lua_pushnumber(p_L, p_value.x);
+	lua_pushnumber(p_L, p_value.y);
+	lua_pushnumber(p_L, p_value.z);
+	return 3;
+}
+
+} // namespace luagd
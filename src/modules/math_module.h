@@ -0,0 +1,41 @@
+#ifndef LUAGD_MATH_MODULE_H
+#define LUAGD_MATH_MODULE_H
+
+#include <godot_cpp/variant/quaternion.hpp>
+#include <godot_cpp/variant/transform3d.hpp>
+#include <godot_cpp/variant/vector3.hpp>
+
+struct lua_State;
+
+namespace luagd {
+
+// 打开 native_math 模块。
+// 提供 userdata 形式的 Vector3 / Quaternion / Transform3D，支持元表运算与原地修改。
+// 返回：在 Lua 栈上返回 1（模块表）。
+int luaopen_native_math(lua_State *p_L);
+
+// 读取向量参数：p_index 处为 native_math.Vector3 时读取它，否则按三个数字 (x, y, z) 读取（参数错误时报错）。
+// 返回：消耗的参数个数（1 或 3），后续参数从 p_index + 返回值开始。
+int math_check_vector3(lua_State *p_L, int p_index, godot::Vector3 &r_value);
+
+// 返回：p_index 处为对应类型时返回其数据指针，否则返回 nullptr（不报错）。
+godot::Vector3 *math_test_vector3(lua_State *p_L, int p_index);
+godot::Quaternion *math_test_quaternion(lua_State *p_L, int p_index);
+godot::Transform3D *math_test_transform(lua_State *p_L, int p_index);
+
+// 压入新建的 userdata。
+void math_push_vector3(lua_State *p_L, const godot::Vector3 &p_value);
+void math_push_quaternion(lua_State *p_L, const godot::Quaternion &p_value);
+void math_push_transform(lua_State *p_L, const godot::Transform3D &p_value);
+
+// 供 getter 的可选输出参数使用：p_index 处为 native_math.Vector3 时写入 p_value 并把它压入栈顶。
+// 返回：是否写入（否则栈不变，调用方按原方式返回数字）。
+bool math_write_vector3(lua_State *p_L, int p_index, const godot::Vector3 &p_value);
+
+// 返回向量结果：p_out_index 处为 native_math.Vector3 时写入并压入它，否则压入 x, y, z 三个数字。
+// 返回：压入的值个数，可直接作为 lua_CFunction 的返回值。
+int math_return_vector3(lua_State *p_L, int p_out_index, const godot::Vector3 &p_value);
+
+} // namespace luagd
+
+#endif // LUAGD_MATH_MODULE_H
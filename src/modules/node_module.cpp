@@ -1,6 +1,8 @@
 #include "node_module.h"
 
+#include "../host/host_error_sink.h"
 #include "../host/host_thread_check.h"
+#include "../lua/lua_binding_stats.h"
 
 #include <godot_cpp/classes/engine.hpp>
 #include <godot_cpp/classes/node.hpp>
@@ -10,10 +12,12 @@
 #include <godot_cpp/classes/resource_loader.hpp>
 #include <godot_cpp/classes/scene_tree.hpp>
 #include <godot_cpp/classes/window.hpp>
+#include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/core/object.hpp>
 #include <godot_cpp/core/object_id.hpp>
 #include <godot_cpp/templates/hash_map.hpp>
 #include <godot_cpp/templates/hash_set.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
 #include <godot_cpp/variant/node_path.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 
@@ -29,17 +33,85 @@ enum NodeOwnership {
 	NODE_OWNERSHIP_OWNED = 1,
 };
 
-struct NodeRecord {
+// 句柄 = (generation << 32) | slot。generation 从 1 开始，句柄不会为 0 或 -1；
+// 槽位释放时 generation 递增，旧句柄随之失效。
+struct NodeSlot {
 	godot::ObjectID id;
+	// 节点在场景树内时缓存的指针，由 tree_exiting / tree_entered 信号维护，不在树内时为 nullptr
+	godot::Node *node;
+	godot::Node3D *node3d;
+	uint32_t generation;
 	NodeOwnership ownership;
+	// 存活的 userdata 句柄数
+	uint32_t wrappers;
+	// 整数句柄交给过 Lua 时为 true，此后 userdata 回收不再自动释放槽位
+	bool pinned;
+	// 其他模块长期持有句柄的计数（node_retain / node_unretain），非 0 时 userdata 回收不释放槽位
+	uint32_t retains;
+	// 空闲链表中的下一个槽位，-1 表示结束
+	int32_t next_free;
 };
 
-static godot::HashMap<godot::ObjectID, NodeRecord> nodes;
-static godot::HashMap<godot::ObjectID, godot::HashSet<godot::ObjectID>> root_children;
+// native_node.wrap / find 返回的 userdata 句柄
+struct NodeRef {
+	NodeHandle handle;
+};
+
+// userdata 句柄的元表名与注册表中按句柄缓存 userdata 的弱值表
+static const char *NODE_REF_METATABLE = "native_node.Node";
+static const char *NODE_REF_CACHE_KEY = "native_node.refs";
+
+// NodeTreeWatcher：接收已登记节点的 tree_entered / tree_exiting 信号，维护槽位中的缓存指针。
+// 全局一个实例，信号连接时绑定节点句柄。
+class NodeTreeWatcher : public godot::Object {
+	GDCLASS(NodeTreeWatcher, godot::Object);
+
+protected:
+	static void _bind_methods();
+
+public:
+	void on_tree_entered(int64_t p_handle);
+	void on_tree_exiting(int64_t p_handle);
+};
+
+static godot::LocalVector<NodeSlot> slots;
+static int32_t free_slot_head = -1;
+static int live_slot_count = 0;
+// ObjectID -> 槽位，用于去重登记与 find_registered_ancestor
+static godot::HashMap<godot::ObjectID, uint32_t> slot_by_object;
+// 跟踪根节点（owner 或自身）的 ObjectID -> 经 get_child_by_path 登记的子节点句柄
+static godot::HashMap<godot::ObjectID, godot::HashSet<NodeHandle>> root_children;
 static godot::ObjectID root_node_id;
+static NodeTreeWatcher *tree_watcher = nullptr;
 
-static godot::ObjectID _read_object_id(lua_State *p_L, int p_index) {
-	return godot::ObjectID((uint64_t)luaL_checkinteger(p_L, p_index));
+static inline uint32_t _handle_slot(NodeHandle p_handle) {
+	return (uint32_t)(p_handle & 0xFFFFFFFFu);
+}
+
+static inline uint32_t _handle_generation(NodeHandle p_handle) {
+	return (uint32_t)(p_handle >> 32);
+}
+
+static inline NodeHandle _make_handle(uint32_t p_slot) {
+	return ((NodeHandle)slots[p_slot].generation << 32) | (NodeHandle)p_slot;
+}
+
+// 返回：句柄对应的已登记槽位，句柄已失效时返回 nullptr。
+static inline NodeSlot *_get_slot(NodeHandle p_handle) {
+	const uint32_t index = _handle_slot(p_handle);
+	if (index >= slots.size()) {
+		return nullptr;
+	}
+
+	NodeSlot *slot = &slots[index];
+	if (slot->generation != _handle_generation(p_handle) || slot->id.is_null()) {
+		return nullptr;
+	}
+	return slot;
+}
+
+static NodeHandle _read_handle(lua_State *p_L, int p_index) {
+	return node_check_handle(p_L, p_index);
 }
 
 static godot::Node *_resolve_node(godot::ObjectID p_id) {
@@ -50,16 +122,42 @@ static godot::Node *_resolve_node(godot::ObjectID p_id) {
 	return godot::Object::cast_to<godot::Node>(godot::ObjectDB::get_instance((uint64_t)p_id));
 }
 
+void NodeTreeWatcher::_bind_methods() {
+	godot::ClassDB::bind_method(godot::D_METHOD("on_tree_entered", "handle"), &NodeTreeWatcher::on_tree_entered);
+	godot::ClassDB::bind_method(godot::D_METHOD("on_tree_exiting", "handle"), &NodeTreeWatcher::on_tree_exiting);
+}
+
+void NodeTreeWatcher::on_tree_entered(int64_t p_handle) {
+	NodeSlot *slot = _get_slot((NodeHandle)p_handle);
+	if (slot == nullptr) {
+		return;
+	}
+
+	slot->node = _resolve_node(slot->id);
+	slot->node3d = godot::Object::cast_to<godot::Node3D>(slot->node);
+}
+
+void NodeTreeWatcher::on_tree_exiting(int64_t p_handle) {
+	NodeSlot *slot = _get_slot((NodeHandle)p_handle);
+	if (slot == nullptr) {
+		return;
+	}
+
+	// 节点离开场景树（含即将释放）时清空缓存，解析路径不再触碰该指针
+	slot->node = nullptr;
+	slot->node3d = nullptr;
+}
+
 static godot::Node *_get_scene_root_node(const char *p_func_name) {
 	godot::SceneTree *tree = godot::Object::cast_to<godot::SceneTree>(godot::Engine::get_singleton()->get_main_loop());
 	if (tree == nullptr) {
-		godot::UtilityFunctions::printerr("native_node.", p_func_name, ": SceneTree not available");
+		LUAGD_REPORT_ERROR("native_node", p_func_name, "SceneTree not available");
 		return nullptr;
 	}
 
 	godot::Window *root_window = tree->get_root();
 	if (root_window == nullptr) {
-		godot::UtilityFunctions::printerr("native_node.", p_func_name, ": Scene root not available");
+		LUAGD_REPORT_ERROR("native_node", p_func_name, "Scene root not available");
 		return nullptr;
 	}
 
@@ -79,126 +177,288 @@ static godot::ObjectID _get_tracking_root_id(godot::Node *p_node) {
 	return godot::ObjectID(owner->get_instance_id());
 }
 
-static void _remove_child_from_root_table(godot::ObjectID p_root_id, godot::ObjectID p_child_id) {
-	if (!root_children.has(p_root_id)) {
+static void _remove_child_from_root_table(godot::ObjectID p_root_id, NodeHandle p_child_handle) {
+	godot::HashSet<NodeHandle> *children = root_children.getptr(p_root_id);
+	if (children == nullptr) {
 		return;
 	}
 
-	root_children[p_root_id].erase(p_child_id);
-	if (root_children[p_root_id].is_empty()) {
+	children->erase(p_child_handle);
+	if (children->is_empty()) {
 		root_children.erase(p_root_id);
 	}
 }
 
-static void _unregister_reference_node(godot::ObjectID p_id) {
-	if (!nodes.has(p_id)) {
+// 释放槽位：断开树信号、移除索引并递增 generation，使现有句柄全部失效。
+static void _release_slot(NodeHandle p_handle) {
+	NodeSlot *slot = _get_slot(p_handle);
+	if (slot == nullptr) {
 		return;
 	}
 
-	const NodeRecord rec = nodes[p_id];
-	if (rec.ownership == NODE_OWNERSHIP_REFERENCE) {
-		_remove_child_from_root_table(_get_tracking_root_id(_resolve_node(p_id)), p_id);
+	godot::Node *node = _resolve_node(slot->id);
+	if (node != nullptr && tree_watcher != nullptr) {
+		node->disconnect("tree_entered", godot::Callable(tree_watcher, "on_tree_entered").bind((int64_t)p_handle));
+		node->disconnect("tree_exiting", godot::Callable(tree_watcher, "on_tree_exiting").bind((int64_t)p_handle));
+	}
+
+	const uint32_t index = _handle_slot(p_handle);
+	slot_by_object.erase(slot->id);
+	slot->id = godot::ObjectID();
+	slot->node = nullptr;
+	slot->node3d = nullptr;
+	slot->wrappers = 0;
+	slot->pinned = false;
+	slot->retains = 0;
+	slot->generation += 1;
+	slot->next_free = free_slot_head;
+	free_slot_head = (int32_t)index;
+	live_slot_count -= 1;
+}
+
+static void _unregister_reference_node(NodeHandle p_handle) {
+	NodeSlot *slot = _get_slot(p_handle);
+	if (slot == nullptr) {
+		return;
 	}
 
-	nodes.erase(p_id);
+	if (slot->ownership == NODE_OWNERSHIP_REFERENCE) {
+		_remove_child_from_root_table(_get_tracking_root_id(_resolve_node(slot->id)), p_handle);
+	}
+
+	_release_slot(p_handle);
 }
 
-static godot::ObjectID _register_node(godot::Node *p_node, NodeOwnership p_ownership) {
+// 登记节点并返回句柄；已登记的节点返回已有句柄。
+static NodeHandle _register_node(godot::Node *p_node, NodeOwnership p_ownership) {
 	if (p_node == nullptr) {
-		return godot::ObjectID();
+		return 0;
 	}
 
 	const godot::ObjectID id = godot::ObjectID(p_node->get_instance_id());
-	if (nodes.has(id)) {
-		return id;
+	const uint32_t *existing = slot_by_object.getptr(id);
+	if (existing != nullptr) {
+		return _make_handle(*existing);
 	}
 
-	NodeRecord rec;
-	rec.id = id;
-	rec.ownership = p_ownership;
-	nodes[id] = rec;
-	return id;
+	uint32_t index;
+	if (free_slot_head >= 0) {
+		index = (uint32_t)free_slot_head;
+		free_slot_head = slots[index].next_free;
+	} else {
+		index = slots.size();
+		NodeSlot empty_slot;
+		empty_slot.generation = 1;
+		slots.push_back(empty_slot);
+	}
+
+	NodeSlot &slot = slots[index];
+	slot.id = id;
+	slot.ownership = p_ownership;
+	slot.wrappers = 0;
+	slot.pinned = false;
+	slot.retains = 0;
+	slot.next_free = -1;
+	slot.node = p_node->is_inside_tree() ? p_node : nullptr;
+	slot.node3d = godot::Object::cast_to<godot::Node3D>(slot.node);
+	slot_by_object.insert(id, index);
+	live_slot_count += 1;
+
+	const NodeHandle handle = _make_handle(index);
+	if (tree_watcher == nullptr) {
+		tree_watcher = memnew(NodeTreeWatcher);
+	}
+	p_node->connect("tree_entered", godot::Callable(tree_watcher, "on_tree_entered").bind((int64_t)handle));
+	p_node->connect("tree_exiting", godot::Callable(tree_watcher, "on_tree_exiting").bind((int64_t)handle));
+	return handle;
 }
 
-static godot::Node *_get_record_node(const NodeRecord *p_rec) {
-	if (p_rec == nullptr) {
+// 返回：槽位对应的节点。节点在树内时直接返回缓存指针，否则回退到 ObjectDB 查询。
+static godot::Node *_get_slot_node(const NodeSlot *p_slot) {
+	if (p_slot == nullptr) {
 		return nullptr;
 	}
+	if (p_slot->node != nullptr) {
+		return p_slot->node;
+	}
 
-	return _resolve_node(p_rec->id);
+	return _resolve_node(p_slot->id);
 }
 
-static NodeRecord *get_node(godot::ObjectID p_id, const char *p_func_name) {
-	if (!nodes.has(p_id)) {
-		godot::UtilityFunctions::printerr("native_node.", p_func_name, ": invalid id ", p_id);
+static NodeSlot *get_node(NodeHandle p_handle, const char *p_func_name) {
+	NodeSlot *slot = _get_slot(p_handle);
+	if (slot == nullptr) {
+		LUAGD_REPORT_ERROR("native_node", p_func_name, "invalid id ", p_handle);
 		return nullptr;
 	}
 
-	NodeRecord *rec = &nodes[p_id];
-	if (_resolve_node(p_id) == nullptr) {
-		_unregister_reference_node(p_id);
-		godot::UtilityFunctions::printerr("native_node.", p_func_name, ": node is no longer valid, id ", p_id);
+	if (_get_slot_node(slot) == nullptr) {
+		_unregister_reference_node(p_handle);
+		LUAGD_REPORT_ERROR("native_node", p_func_name, "node is no longer valid, id ", p_handle);
 		return nullptr;
 	}
 
-	return rec;
+	return slot;
 }
 
-// get_node_by_path(path) -> id
-// 基于全局节点路径查找节点并返回句柄。
-static int l_get_node_by_path(lua_State *p_L) {
-	const char *path = luaL_checkstring(p_L, 1);
+// 把整数句柄交给 Lua 前调用：整数可能被复制到任意位置，槽位此后只由 destroy 或节点失效释放。
+static NodeHandle _pin(NodeHandle p_handle) {
+	NodeSlot *slot = _get_slot(p_handle);
+	if (slot != nullptr) {
+		slot->pinned = true;
+	}
+	return p_handle;
+}
+
+// 释放节点记录及经 get_child_by_path 挂在它下面的引用子节点。
+// p_free_owned: 为 true 时 queue_free 由 instantiate 创建的节点（destroy），否则只释放记录（userdata 回收）。
+static void _release_node(NodeHandle p_handle, bool p_free_owned) {
+	NodeSlot *slot = _get_slot(p_handle);
+	if (slot == nullptr) {
+		return;
+	}
 
-	godot::Node *root_node = _get_scene_root_node("get_node_by_path");
+	const godot::ObjectID id = slot->id;
+	const NodeOwnership ownership = slot->ownership;
+	godot::Node *node = _resolve_node(id);
+	if (p_free_owned) {
+		godot::HashSet<NodeHandle> *children = root_children.getptr(id);
+		if (children != nullptr) {
+			const godot::HashSet<NodeHandle> child_handles = *children;
+			for (godot::HashSet<NodeHandle>::Iterator it = child_handles.begin(); it != child_handles.end(); ++it) {
+				_unregister_reference_node(*it);
+			}
+			root_children.erase(id);
+		}
+
+		if (ownership == NODE_OWNERSHIP_OWNED && node != nullptr && node->is_inside_tree()) {
+			node->queue_free();
+		}
+	}
+
+	if (ownership == NODE_OWNERSHIP_REFERENCE) {
+		_remove_child_from_root_table(_get_tracking_root_id(node), p_handle);
+	}
+	_release_slot(p_handle);
+}
+
+// 压入句柄对应的 userdata。同一句柄复用缓存中的 userdata，可直接用 == 比较。
+static void _push_ref(lua_State *p_L, NodeHandle p_handle) {
+	NodeSlot *slot = _get_slot(p_handle);
+	if (slot == nullptr) {
+		lua_pushnil(p_L);
+		return;
+	}
+
+	lua_getfield(p_L, LUA_REGISTRYINDEX, NODE_REF_CACHE_KEY);
+	if (lua_rawgeti(p_L, -1, (lua_Integer)p_handle) == LUA_TUSERDATA) {
+		lua_remove(p_L, -2);
+		return;
+	}
+	lua_pop(p_L, 1);
+
+	// 分配可能触发 GC：弱缓存中已清掉的旧 userdata 此时才执行 __gc，可能释放槽位，
+	// 因此分配后重新校验句柄，并在设置元表（之后才可能执行 __gc）之前计数
+	NodeRef *ref = (NodeRef *)lua_newuserdatauv(p_L, sizeof(NodeRef), 0);
+	slot = _get_slot(p_handle);
+	if (slot == nullptr) {
+		lua_pop(p_L, 2);
+		lua_pushnil(p_L);
+		return;
+	}
+	ref->handle = p_handle;
+	slot->wrappers += 1;
+	luaL_setmetatable(p_L, NODE_REF_METATABLE);
+	lua_pushvalue(p_L, -1);
+	lua_rawseti(p_L, -3, (lua_Integer)p_handle);
+	lua_remove(p_L, -2);
+}
+
+// 按全局节点路径查找并登记节点。
+// 返回：句柄，失败返回 0。
+static NodeHandle _find_by_path(const char *p_path, const char *p_func_name) {
+	godot::Node *root_node = _get_scene_root_node(p_func_name);
 	if (root_node == nullptr) {
-		lua_pushinteger(p_L, -1);
-		return 1;
+		return 0;
 	}
 
-	const godot::NodePath node_path((godot::String(path)));
+	const godot::NodePath node_path((godot::String(p_path)));
 	if (!root_node->has_node(node_path)) {
-		godot::UtilityFunctions::printerr("native_node.get_node_by_path: node not found: ", path);
-		lua_pushinteger(p_L, -1);
-		return 1;
+		LUAGD_REPORT_ERROR("native_node", p_func_name, "node not found: ", p_path);
+		return 0;
 	}
 
 	godot::Node *found_node = root_node->get_node<godot::Node>(node_path);
-	const godot::ObjectID node_id = _register_node(found_node, NODE_OWNERSHIP_REFERENCE);
-	lua_pushinteger(p_L, (int64_t)node_id);
-	return 1;
+	return _register_node(found_node, NODE_OWNERSHIP_REFERENCE);
 }
 
-// get_child_by_path(id, path) -> id
-// 基于指定节点查找子节点并返回句柄。
-static int l_get_child_by_path(lua_State *p_L) {
-	const godot::ObjectID id = _read_object_id(p_L, 1);
-	const char *path = luaL_checkstring(p_L, 2);
-
-	NodeRecord *owner_rec = get_node(id, "get_child_by_path");
-	if (owner_rec == nullptr) {
-		lua_pushinteger(p_L, -1);
-		return 1;
+// 按相对路径查找并登记子节点，子节点记入其跟踪根节点的子表，随根节点 destroy 一起释放。
+// 返回：句柄，失败返回 0。
+static NodeHandle _find_child(NodeHandle p_handle, const char *p_path, const char *p_func_name) {
+	NodeSlot *owner_slot = get_node(p_handle, p_func_name);
+	if (owner_slot == nullptr) {
+		return 0;
 	}
 
-	godot::Node *owner_node = _get_record_node(owner_rec);
+	godot::Node *owner_node = _get_slot_node(owner_slot);
 	if (owner_node == nullptr) {
+		return 0;
+	}
+
+	const godot::NodePath node_path((godot::String(p_path)));
+	if (!owner_node->has_node(node_path)) {
+		LUAGD_REPORT_ERROR("native_node", p_func_name, "node not found: ", p_path);
+		return 0;
+	}
+
+	godot::Node *found_node = owner_node->get_node<godot::Node>(node_path);
+	const NodeHandle child_handle = _register_node(found_node, NODE_OWNERSHIP_REFERENCE);
+	const godot::ObjectID root_id = _get_tracking_root_id(owner_node);
+	root_children[root_id].insert(child_handle);
+	return child_handle;
+}
+
+// get_node_by_path(path) -> id
+// 基于全局节点路径查找节点并返回句柄。
+static int l_get_node_by_path(lua_State *p_L) {
+	const char *path = luaL_checkstring(p_L, 1);
+
+	const NodeHandle handle = _find_by_path(path, "get_node_by_path");
+	if (handle == 0) {
 		lua_pushinteger(p_L, -1);
 		return 1;
 	}
+	lua_pushinteger(p_L, (lua_Integer)_pin(handle));
+	return 1;
+}
 
-	const godot::NodePath node_path((godot::String(path)));
-	if (!owner_node->has_node(node_path)) {
-		godot::UtilityFunctions::printerr("native_node.get_child_by_path: node not found: ", path);
+// get_child_by_path(id, path) -> id
+// 基于指定节点查找子节点并返回句柄。
+static int l_get_child_by_path(lua_State *p_L) {
+	const NodeHandle handle = _read_handle(p_L, 1);
+	const char *path = luaL_checkstring(p_L, 2);
+
+	const NodeHandle child_handle = _find_child(handle, path, "get_child_by_path");
+	if (child_handle == 0) {
 		lua_pushinteger(p_L, -1);
 		return 1;
 	}
+	lua_pushinteger(p_L, (lua_Integer)_pin(child_handle));
+	return 1;
+}
 
-	godot::Node *found_node = owner_node->get_node<godot::Node>(node_path);
-	const godot::ObjectID child_id = _register_node(found_node, NODE_OWNERSHIP_REFERENCE);
-	const godot::ObjectID root_id = _get_tracking_root_id(owner_node);
-	root_children[root_id].insert(child_id);
+// find(path) -> Node | nil
+// 同 get_node_by_path，但返回 userdata 句柄；没有整数句柄流出时，userdata 回收后自动释放节点记录。
+static int l_find(lua_State *p_L) {
+	const char *path = luaL_checkstring(p_L, 1);
+	_push_ref(p_L, _find_by_path(path, "find"));
+	return 1;
+}
 
-	lua_pushinteger(p_L, (int64_t)child_id);
+// wrap(id) -> Node | nil
+// 把整数句柄包装为 userdata 句柄。整数句柄已交给 Lua，userdata 回收时不会释放记录。
+static int l_wrap(lua_State *p_L) {
+	_push_ref(p_L, _read_handle(p_L, 1));
 	return 1;
 }
 
@@ -215,7 +475,7 @@ static int l_set_root(lua_State *p_L) {
 
 	const godot::NodePath node_path((godot::String(path)));
 	if (!window_node->has_node(node_path)) {
-		godot::UtilityFunctions::printerr("native_node.set_root: node not found: ", path);
+		LUAGD_REPORT_ERROR("native_node", "set_root", "node not found: ", path);
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
@@ -232,14 +492,14 @@ static int l_instantiate(lua_State *p_L) {
 	const char *scene_path = luaL_checkstring(p_L, 1);
 
 	if (root_node_id.is_null()) {
-		godot::UtilityFunctions::printerr("native_node.instantiate: root not set, call set_root first");
+		LUAGD_REPORT_ERROR("native_node", "instantiate", "root not set, call set_root first");
 		lua_pushinteger(p_L, -1);
 		return 1;
 	}
 
 	godot::Node *root_node = godot::Object::cast_to<godot::Node>(godot::ObjectDB::get_instance((uint64_t)root_node_id));
 	if (root_node == nullptr || !root_node->is_inside_tree()) {
-		godot::UtilityFunctions::printerr("native_node.instantiate: root node is no longer valid");
+		LUAGD_REPORT_ERROR("native_node", "instantiate", "root node is no longer valid");
 		root_node_id = godot::ObjectID();
 		lua_pushinteger(p_L, -1);
 		return 1;
@@ -247,85 +507,56 @@ static int l_instantiate(lua_State *p_L) {
 
 	godot::Ref<godot::Resource> resource = godot::ResourceLoader::get_singleton()->load(godot::String(scene_path));
 	if (resource.is_null()) {
-		godot::UtilityFunctions::printerr("native_node.instantiate: failed to load resource: ", scene_path);
+		LUAGD_REPORT_ERROR("native_node", "instantiate", "failed to load resource: ", scene_path);
 		lua_pushinteger(p_L, -1);
 		return 1;
 	}
 
 	godot::PackedScene *packed_scene = godot::Object::cast_to<godot::PackedScene>(resource.ptr());
 	if (packed_scene == nullptr) {
-		godot::UtilityFunctions::printerr("native_node.instantiate: resource is not a PackedScene: ", scene_path);
+		LUAGD_REPORT_ERROR("native_node", "instantiate", "resource is not a PackedScene: ", scene_path);
 		lua_pushinteger(p_L, -1);
 		return 1;
 	}
 
 	godot::Node *instance = packed_scene->instantiate();
 	if (instance == nullptr) {
-		godot::UtilityFunctions::printerr("native_node.instantiate: failed to instantiate scene: ", scene_path);
+		LUAGD_REPORT_ERROR("native_node", "instantiate", "failed to instantiate scene: ", scene_path);
 		lua_pushinteger(p_L, -1);
 		return 1;
 	}
 
 	root_node->add_child(instance);
-	const godot::ObjectID id = _register_node(instance, NODE_OWNERSHIP_OWNED);
-	lua_pushinteger(p_L, (int64_t)id);
+	const NodeHandle handle = _register_node(instance, NODE_OWNERSHIP_OWNED);
+	lua_pushinteger(p_L, (lua_Integer)_pin(handle));
 	return 1;
 }
 
 // destroy(id) -> void
 // 销毁创建节点或释放引用节点。
 static int l_destroy(lua_State *p_L) {
-	const godot::ObjectID id = _read_object_id(p_L, 1);
-	if (!nodes.has(id)) {
-		return 0;
-	}
-
-	const NodeRecord rec = nodes[id];
-	if (root_children.has(id)) {
-		godot::HashSet<godot::ObjectID> child_ids = root_children[id];
-		for (godot::HashSet<godot::ObjectID>::Iterator it = child_ids.begin(); it != child_ids.end(); ++it) {
-			_unregister_reference_node(*it);
-		}
-		root_children.erase(id);
-	}
-
-	if (rec.ownership == NODE_OWNERSHIP_OWNED) {
-		godot::Node *node = _resolve_node(id);
-		if (node != nullptr && node->is_inside_tree()) {
-			node->queue_free();
-		}
-	} else {
-		_remove_child_from_root_table(_get_tracking_root_id(_resolve_node(id)), id);
-	}
-
-	nodes.erase(id);
+	_release_node(_read_handle(p_L, 1), true);
 	return 0;
 }
 
 // is_valid(id) -> bool
 // 检查节点引用是否仍然有效。
 static int l_is_valid(lua_State *p_L) {
-	const godot::ObjectID id = _read_object_id(p_L, 1);
-	if (!nodes.has(id)) {
-		lua_pushboolean(p_L, false);
-		return 1;
-	}
-
-	godot::Node *node = _resolve_node(id);
-	lua_pushboolean(p_L, node != nullptr && node->is_inside_tree());
+	const NodeSlot *slot = _get_slot(_read_handle(p_L, 1));
+	// 缓存指针只在节点位于场景树内时非空
+	lua_pushboolean(p_L, slot != nullptr && slot->node != nullptr);
 	return 1;
 }
 
 // get_name(id) -> string
 // 获取节点名称。
 static int l_get_name(lua_State *p_L) {
-	const godot::ObjectID id = _read_object_id(p_L, 1);
-	NodeRecord *rec = get_node(id, "get_name");
-	if (rec == nullptr) {
+	NodeSlot *slot = get_node(_read_handle(p_L, 1), "get_name");
+	if (slot == nullptr) {
 		return 0;
 	}
 
-	const godot::CharString utf8_name = godot::String(_get_record_node(rec)->get_name()).utf8();
+	const godot::CharString utf8_name = godot::String(_get_slot_node(slot)->get_name()).utf8();
 	lua_pushstring(p_L, utf8_name.get_data());
 	return 1;
 }
@@ -333,14 +564,13 @@ static int l_get_name(lua_State *p_L) {
 // get_type(id) -> string
 // 返回节点当前的 Godot 运行时类名。
 static int l_get_type(lua_State *p_L) {
-	const godot::ObjectID id = _read_object_id(p_L, 1);
-	NodeRecord *rec = get_node(id, "get_type");
-	if (rec == nullptr) {
+	NodeSlot *slot = get_node(_read_handle(p_L, 1), "get_type");
+	if (slot == nullptr) {
 		lua_pushstring(p_L, "");
 		return 1;
 	}
 
-	const godot::CharString utf8_type = godot::String(_get_record_node(rec)->get_class()).utf8();
+	const godot::CharString utf8_type = godot::String(_get_slot_node(slot)->get_class()).utf8();
 	lua_pushstring(p_L, utf8_type.get_data());
 	return 1;
 }
@@ -349,16 +579,16 @@ static int l_get_type(lua_State *p_L) {
 // 获取节点直接子节点数量。
 // 返回：子节点数量，节点无效时返回 -1。
 static int l_get_child_count(lua_State *p_L) {
-	const godot::ObjectID id = _read_object_id(p_L, 1);
+	const NodeHandle handle = _read_handle(p_L, 1);
 	const bool include_internal = lua_toboolean(p_L, 2);
 
-	NodeRecord *rec = get_node(id, "get_child_count");
-	if (rec == nullptr) {
+	NodeSlot *slot = get_node(handle, "get_child_count");
+	if (slot == nullptr) {
 		lua_pushinteger(p_L, -1);
 		return 1;
 	}
 
-	const int32_t count = _get_record_node(rec)->get_child_count(include_internal);
+	const int32_t count = _get_slot_node(slot)->get_child_count(include_internal);
 	lua_pushinteger(p_L, count);
 	return 1;
 }
@@ -366,12 +596,12 @@ static int l_get_child_count(lua_State *p_L) {
 // find_registered_ancestor(node_id) -> ancestor_id
 // 从给定的 ObjectID 向上查找第一个已注册的祖先节点。
 static int l_find_registered_ancestor(lua_State *p_L) {
-	const godot::ObjectID id = _read_object_id(p_L, 1);
+	const godot::ObjectID id((uint64_t)luaL_checkinteger(p_L, 1));
 
 	// 先检查节点本身是否存在
 	godot::Node *node = godot::Object::cast_to<godot::Node>(godot::ObjectDB::get_instance((uint64_t)id));
 	if (node == nullptr) {
-		godot::UtilityFunctions::printerr("native_node.find_registered_ancestor: node not found, id ", id);
+		LUAGD_REPORT_ERROR("native_node", "find_registered_ancestor", "node not found, id ", id);
 		lua_pushinteger(p_L, -1);
 		return 1;
 	}
@@ -379,11 +609,10 @@ static int l_find_registered_ancestor(lua_State *p_L) {
 	// 向上遍历查找已注册的节点
 	godot::Node *current = node;
 	while (current != nullptr) {
-		godot::ObjectID current_id = godot::ObjectID(current->get_instance_id());
-
 		// 检查当前节点是否已注册
-		if (nodes.has(current_id)) {
-			lua_pushinteger(p_L, (int64_t)current_id);
+		const uint32_t *slot_index = slot_by_object.getptr(godot::ObjectID(current->get_instance_id()));
+		if (slot_index != nullptr) {
+			lua_pushinteger(p_L, (lua_Integer)_pin(_make_handle(*slot_index)));
 			return 1;
 		}
 
@@ -396,6 +625,49 @@ static int l_find_registered_ancestor(lua_State *p_L) {
 	return 1;
 }
 
+// Node:get_child(path) -> Node | nil
+// 同 get_child_by_path，但返回 userdata 句柄。
+static int m_get_child(lua_State *p_L) {
+	const NodeHandle handle = _read_handle(p_L, 1);
+	const char *path = luaL_checkstring(p_L, 2);
+	_push_ref(p_L, _find_child(handle, path, "get_child"));
+	return 1;
+}
+
+// Node:id() -> integer
+// 返回整数句柄，可传给只接受整数的接口。调用后该节点记录不再随 userdata 回收释放。
+static int m_id(lua_State *p_L) {
+	const NodeRef *ref = (const NodeRef *)luaL_checkudata(p_L, 1, NODE_REF_METATABLE);
+	lua_pushinteger(p_L, (lua_Integer)_pin(ref->handle));
+	return 1;
+}
+
+// 没有 userdata、整数句柄从未流出且没有模块持有时，记录已不可达，释放记录（不释放节点本身）。
+static void _release_if_unreachable(NodeHandle p_handle, const NodeSlot *p_slot) {
+	if (p_slot->wrappers == 0 && !p_slot->pinned && p_slot->retains == 0) {
+		_release_node(p_handle, false);
+	}
+}
+
+// __gc：最后一个 userdata 被回收时检查记录是否仍被引用。
+static int m_gc(lua_State *p_L) {
+	const NodeRef *ref = (const NodeRef *)lua_touserdata(p_L, 1);
+	NodeSlot *slot = _get_slot(ref->handle);
+	if (slot == nullptr) {
+		return 0;
+	}
+
+	slot->wrappers -= 1;
+	_release_if_unreachable(ref->handle, slot);
+	return 0;
+}
+
+static int m_tostring(lua_State *p_L) {
+	const NodeRef *ref = (const NodeRef *)lua_touserdata(p_L, 1);
+	lua_pushfstring(p_L, "native_node.Node: %I", (lua_Integer)ref->handle);
+	return 1;
+}
+
 static const luaL_Reg node_funcs[] = {
 	{"set_root", l_set_root},
 	{"instantiate", l_instantiate},
@@ -407,44 +679,162 @@ static const luaL_Reg node_funcs[] = {
 	{"get_type", l_get_type},
 	{"get_child_count", l_get_child_count},
 	{"find_registered_ancestor", l_find_registered_ancestor},
+	{"find", l_find},
+	{"wrap", l_wrap},
 	{nullptr, nullptr}
 };
 
+// userdata 句柄的方法（h:get_name()）。其他模块在打开时通过 node_register_methods 追加各自以节点为第一个参数的函数。
+static const luaL_Reg node_methods[] = {
+	{"get_child", m_get_child},
+	{"get_child_by_path", l_get_child_by_path},
+	{"id", m_id},
+	{"is_valid", l_is_valid},
+	{"destroy", l_destroy},
+	{"get_name", l_get_name},
+	{"get_type", l_get_type},
+	{"get_child_count", l_get_child_count},
+	{nullptr, nullptr}
+};
+
+// 返回后 userdata 元表位于栈顶。首次调用时创建元表、方法表与句柄缓存。
+static void _push_ref_metatable(lua_State *p_L) {
+	if (luaL_newmetatable(p_L, NODE_REF_METATABLE) == 0) {
+		return;
+	}
+
+	lua_binding_new_lib(p_L, NODE_REF_METATABLE, node_methods);
+	lua_setfield(p_L, -2, "__index");
+	lua_pushcfunction(p_L, m_gc);
+	lua_setfield(p_L, -2, "__gc");
+	lua_pushcfunction(p_L, m_tostring);
+	lua_setfield(p_L, -2, "__tostring");
+
+	// 弱值表：句柄 -> userdata，userdata 被回收时条目自动消失
+	lua_newtable(p_L);
+	lua_createtable(p_L, 0, 1);
+	lua_pushliteral(p_L, "v");
+	lua_setfield(p_L, -2, "__mode");
+	lua_setmetatable(p_L, -2);
+	lua_setfield(p_L, LUA_REGISTRYINDEX, NODE_REF_CACHE_KEY);
+}
+
 int luaopen_native_node(lua_State *p_L) {
-	luaL_newlib(p_L, node_funcs);
+	_push_ref_metatable(p_L);
+	lua_pop(p_L, 1);
+	lua_binding_new_lib(p_L, "native_node", node_funcs);
 	return 1;
 }
 
+void node_register_methods(lua_State *p_L, int p_module_index, const char *const *p_names) {
+	const int module_index = lua_absindex(p_L, p_module_index);
+	_push_ref_metatable(p_L);
+	lua_getfield(p_L, -1, "__index");
+	for (const char *const *name = p_names; *name != nullptr; name++) {
+		// 从模块表取函数，保留 lua_binding_new_lib 包装的调用统计
+		if (lua_getfield(p_L, module_index, *name) != LUA_TFUNCTION) {
+			godot::UtilityFunctions::printerr("native_node: method '", *name, "' not found in module table");
+			lua_pop(p_L, 1);
+			continue;
+		}
+		// 各模块的方法名互不重复，重名说明方法列表有误，保留先注册的方法
+		if (lua_getfield(p_L, -2, *name) != LUA_TNIL) {
+			godot::UtilityFunctions::printerr("native_node: duplicate Node method '", *name, "'");
+			lua_pop(p_L, 2);
+			continue;
+		}
+		lua_pop(p_L, 1);
+		lua_setfield(p_L, -2, *name);
+	}
+	lua_pop(p_L, 2);
+}
+
+bool node_is_alive(NodeHandle p_handle) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_node.node_is_alive")) {
+		return false;
+	}
+
+	return _get_slot_node(_get_slot(p_handle)) != nullptr;
+}
+
+void node_retain(NodeHandle p_handle) {
+	NodeSlot *slot = _get_slot(p_handle);
+	if (slot != nullptr) {
+		slot->retains += 1;
+	}
+}
+
+void node_unretain(NodeHandle p_handle) {
+	NodeSlot *slot = _get_slot(p_handle);
+	if (slot == nullptr || slot->retains == 0) {
+		return;
+	}
+
+	slot->retains -= 1;
+	_release_if_unreachable(p_handle, slot);
+}
+
+NodeHandle node_check_handle(lua_State *p_L, int p_index) {
+	if (lua_type(p_L, p_index) == LUA_TUSERDATA) {
+		const NodeRef *ref = (const NodeRef *)luaL_testudata(p_L, p_index, NODE_REF_METATABLE);
+		if (ref != nullptr) {
+			return ref->handle;
+		}
+	}
+	return (NodeHandle)luaL_checkinteger(p_L, p_index);
+}
+
 void node_cleanup() {
-	nodes.clear();
+	// 释放观察者时 Godot 会自动断开所有指向它的信号连接
+	if (tree_watcher != nullptr) {
+		memdelete(tree_watcher);
+		tree_watcher = nullptr;
+	}
+	slots.clear();
+	free_slot_head = -1;
+	live_slot_count = 0;
+	slot_by_object.clear();
 	root_children.clear();
 	root_node_id = godot::ObjectID();
 }
 
-godot::Node *node_resolve_any(godot::ObjectID p_id) {
-	if (!ensure_main_thread("native_node.node_resolve_any")) {
-		return nullptr;
-	}
+void node_register_types() {
+	GDREGISTER_CLASS(NodeTreeWatcher);
+}
 
-	if (!nodes.has(p_id)) {
-		return nullptr;
+void node_collect_memory(godot::LocalVector<HostMemoryTable> &r_tables) {
+	const int64_t slot_bytes = (int64_t)slots.size() * (int64_t)sizeof(NodeSlot) + host_memory_hash_map_bytes(slot_by_object);
+	r_tables.push_back({"native_node.nodes", (int64_t)live_slot_count, slot_bytes});
+
+	int64_t child_entries = 0;
+	int64_t child_bytes = host_memory_hash_map_bytes(root_children);
+	for (const godot::KeyValue<godot::ObjectID, godot::HashSet<NodeHandle>> &entry : root_children) {
+		child_entries += entry.value.size();
+		child_bytes += host_memory_hash_set_bytes(entry.value);
 	}
+	r_tables.push_back({"native_node.root_children", child_entries, child_bytes});
+}
 
-	godot::Node *node = _resolve_node(p_id);
-	if (node == nullptr || !node->is_inside_tree()) {
+int node_get_count() {
+	return live_slot_count;
+}
+
+godot::Node *node_resolve_any(NodeHandle p_handle) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_node.node_resolve_any")) {
 		return nullptr;
 	}
 
-	return node;
+	const NodeSlot *slot = _get_slot(p_handle);
+	return slot != nullptr ? slot->node : nullptr;
 }
 
-godot::Node3D *node_resolve(godot::ObjectID p_id) {
-	godot::Node *node = node_resolve_any(p_id);
-	if (node == nullptr) {
+godot::Node3D *node_resolve(NodeHandle p_handle) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_node.node_resolve")) {
 		return nullptr;
 	}
 
-	return godot::Object::cast_to<godot::Node3D>(node);
+	const NodeSlot *slot = _get_slot(p_handle);
+	return slot != nullptr ? slot->node3d : nullptr;
 }
 
 } // namespace luagd
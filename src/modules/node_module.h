@@ -1,16 +1,24 @@
 #ifndef LUAGD_NODE_MODULE_H
 #define LUAGD_NODE_MODULE_H
 
+#include <cstdint>
+
+#include "../host/host_memory_stats.h"
+
 struct lua_State;
 
 namespace godot {
 class Node;
 class Node3D;
-class ObjectID;
 }
 
 namespace luagd {
 
+// native_node 句柄：(generation << 32) | slot。
+// 槽位缓存节点指针，解析只需一次数组下标与 generation 比较；节点释放或 destroy 后旧句柄失效。
+// 句柄不是 ObjectID，碰撞回调等返回的 ObjectID 需经 find_registered_ancestor 转为句柄。
+typedef uint64_t NodeHandle;
+
 // 打开 native_node 模块。
 // 提供基于 id 句柄的节点操作 API。
 // 返回：在 Lua 栈上返回 1（模块表）。
@@ -20,15 +28,47 @@ int luaopen_native_node(lua_State *p_L);
 // 释放所有节点引用。
 void node_cleanup();
 
-// 通过 native_node id 解析 Node3D。
+// 注册模块内部使用的 Godot 类型（场景树信号观察者）。在扩展初始化时调用。
+void node_register_types();
+
+// 返回：已登记的节点记录数。
+int node_get_count();
+
+// 把模块表的条目数与估算字节数追加到 r_tables，供 host_memory_collect 使用。
+void node_collect_memory(godot::LocalVector<HostMemoryTable> &r_tables);
+
+// 通过 native_node 句柄解析 Node3D。
 // 约束：只允许在主线程调用。
-// 仅供其他 native 模块内部使用，失败返回 nullptr。
-godot::Node3D *node_resolve(godot::ObjectID p_id);
+// 仅供其他 native 模块内部使用，句柄失效、节点不在场景树内或不是 Node3D 时返回 nullptr。
+godot::Node3D *node_resolve(NodeHandle p_handle);
 
-// 通过 native_node id 解析任意 Node。
+// 通过 native_node 句柄解析任意 Node。
 // 约束：只允许在主线程调用。
-// 仅供其他 native 模块内部使用，失败返回 nullptr。
-godot::Node *node_resolve_any(godot::ObjectID p_id);
+// 仅供其他 native 模块内部使用，句柄失效或节点不在场景树内时返回 nullptr。
+godot::Node *node_resolve_any(NodeHandle p_handle);
+
+// 句柄记录仍有效且节点对象尚未释放时返回 true，不要求节点在场景树内。
+// 约束：只允许在主线程调用。
+// 供长期保存句柄的模块区分“节点已失效”和“节点暂时离开场景树”（例如 reparent 过程中）。
+bool node_is_alive(NodeHandle p_handle);
+
+// 增加句柄对应记录的持有计数：计数非 0 时记录不随 native_node.Node userdata 回收释放。
+// 长期保存句柄的模块（transform 组、插值登记、动画器等）在保存时调用，不再持有时调用 node_unretain。
+// 句柄无效时忽略。
+void node_retain(NodeHandle p_handle);
+
+// 减少持有计数。计数归零且已没有 userdata、整数句柄也从未交给 Lua 时释放记录（不释放节点本身），
+// 之后该句柄失效。句柄无效时忽略。
+void node_unretain(NodeHandle p_handle);
+
+// 读取节点参数：接受 native_node.Node userdata 或整数句柄，其他类型按 luaL_checkinteger 报参数错误。
+// 供以节点为参数的模块统一读取句柄。
+NodeHandle node_check_handle(lua_State *p_L, int p_index);
+
+// 把 p_module_index 处模块表中 p_names 列出的函数追加为 native_node.Node 的方法，使 h:set_position(v) 等价于
+// module.set_position(h, v)。在模块的 luaopen 中调用。
+// p_names: 以 nullptr 结尾的函数名列表，只应包含以节点为第一个参数的函数；各模块之间不能重名。
+void node_register_methods(lua_State *p_L, int p_module_index, const char *const *p_names);
 
 } // namespace luagd
 
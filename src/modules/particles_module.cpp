@@ -1,5 +1,11 @@
 #include "particles_module.h"
 
+#include "node_module.h"
+
+#include "../host/host_error_sink.h"
+#include "../host/host_thread_check.h"
+#include "../lua/lua_binding_stats.h"
+
 #include <godot_cpp/classes/gpu_particles3d.hpp>
 #include <godot_cpp/classes/rendering_server.hpp>
 #include <godot_cpp/core/object.hpp>
@@ -13,29 +19,29 @@ extern "C" {
 
 namespace luagd {
 
-static godot::ObjectID _read_node_id(lua_State *p_L, int p_index) {
-	return godot::ObjectID((uint64_t)luaL_checkinteger(p_L, p_index));
+static NodeHandle _read_node_id(lua_State *p_L, int p_index) {
+	return node_check_handle(p_L, p_index);
 }
 
 static void _push_bool(lua_State *p_L, bool p_value) {
 	lua_pushboolean(p_L, p_value);
 }
 
-static godot::GPUParticles3D *_resolve_particles(godot::ObjectID p_node_id, const char *p_func_name) {
-	if (p_node_id.is_null()) {
-		godot::UtilityFunctions::printerr("native_particles.", p_func_name, ": node id is 0");
+static godot::GPUParticles3D *_resolve_particles(NodeHandle p_node_id, const char *p_func_name) {
+	if (p_node_id == 0) {
+		LUAGD_REPORT_ERROR("native_particles", p_func_name, "node id is 0");
 		return nullptr;
 	}
 
-	godot::Object *object = godot::ObjectDB::get_instance((uint64_t)p_node_id);
-	if (object == nullptr) {
-		godot::UtilityFunctions::printerr("native_particles.", p_func_name, ": node is no longer valid, id ", p_node_id);
+	godot::Node *node = node_resolve_any(p_node_id);
+	if (node == nullptr) {
+		LUAGD_REPORT_ERROR("native_particles", p_func_name, "node is no longer valid, id ", p_node_id);
 		return nullptr;
 	}
 
-	godot::GPUParticles3D *particles = godot::Object::cast_to<godot::GPUParticles3D>(object);
+	godot::GPUParticles3D *particles = godot::Object::cast_to<godot::GPUParticles3D>(node);
 	if (particles == nullptr) {
-		godot::UtilityFunctions::printerr("native_particles.", p_func_name, ": node is not GPUParticles3D, id ", p_node_id);
+		LUAGD_REPORT_ERROR("native_particles", p_func_name, "node is not GPUParticles3D, id ", p_node_id);
 		return nullptr;
 	}
 
@@ -45,7 +51,7 @@ static godot::GPUParticles3D *_resolve_particles(godot::ObjectID p_node_id, cons
 // play(node_id) -> bool
 // 开始发射粒子。
 static int l_play(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	godot::GPUParticles3D *particles = _resolve_particles(node_id, "play");
 	if (particles == nullptr) {
 		_push_bool(p_L, false);
@@ -60,7 +66,7 @@ static int l_play(lua_State *p_L) {
 // stop(node_id) -> bool
 // 停止继续发射，不清空现有粒子。
 static int l_stop(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	godot::GPUParticles3D *particles = _resolve_particles(node_id, "stop");
 	if (particles == nullptr) {
 		_push_bool(p_L, false);
@@ -75,7 +81,7 @@ static int l_stop(lua_State *p_L) {
 // clear(node_id) -> bool
 // 清空现有粒子，同时保持调用前的播放状态。
 static int l_clear(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	godot::GPUParticles3D *particles = _resolve_particles(node_id, "clear");
 	if (particles == nullptr) {
 		_push_bool(p_L, false);
@@ -95,7 +101,7 @@ static int l_clear(lua_State *p_L) {
 // set_speed_scale(node_id, speed_scale) -> bool
 // 设置粒子模拟速度倍率。
 static int l_set_speed_scale(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	const double speed_scale = luaL_checknumber(p_L, 2);
 	godot::GPUParticles3D *particles = _resolve_particles(node_id, "set_speed_scale");
 	if (particles == nullptr) {
@@ -111,7 +117,7 @@ static int l_set_speed_scale(lua_State *p_L) {
 // is_playing(node_id) -> bool
 // 查询当前是否仍在发射新粒子。
 static int l_is_playing(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	godot::GPUParticles3D *particles = _resolve_particles(node_id, "is_playing");
 	if (particles == nullptr) {
 		_push_bool(p_L, false);
@@ -126,7 +132,7 @@ static int l_is_playing(lua_State *p_L) {
 // 查询粒子系统是否仍处于活跃状态。
 // 该接口依赖真实粒子渲染后端维护 inactive 状态；在 dummy/headless 后端下不保证结果可靠。
 static int l_is_alive(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	godot::GPUParticles3D *particles = _resolve_particles(node_id, "is_alive");
 	if (particles == nullptr) {
 		_push_bool(p_L, false);
@@ -148,8 +154,20 @@ static const luaL_Reg particles_funcs[] = {
 	{nullptr, nullptr}
 };
 
+// 以节点为第一个参数、作为 native_node.Node 方法暴露的函数
+static const char *const particles_node_methods[] = {
+	"play",
+	"stop",
+	"clear",
+	"set_speed_scale",
+	"is_playing",
+	"is_alive",
+	nullptr
+};
+
 int luaopen_native_particles(lua_State *p_L) {
-	luaL_newlib(p_L, particles_funcs);
+	lua_binding_new_lib(p_L, "native_particles", particles_funcs);
+	node_register_methods(p_L, -1, particles_node_methods);
 	return 1;
 }
 
@@ -1,7 +1,12 @@
 #include "physics_module.h"
 
+#include "math_module.h"
 #include "node_module.h"
 
+#include "../host/host_error_sink.h"
+#include "../host/host_thread_check.h"
+#include "../lua/lua_binding_stats.h"
+
 #include <godot_cpp/classes/character_body3d.hpp>
 #include <godot_cpp/classes/collision_object3d.hpp>
 #include <godot_cpp/core/object.hpp>
@@ -17,26 +22,26 @@ extern "C" {
 
 namespace luagd {
 
-static godot::ObjectID _read_node_id(lua_State *p_L, int p_index) {
-	return godot::ObjectID((uint64_t)luaL_checkinteger(p_L, p_index));
+static NodeHandle _read_node_id(lua_State *p_L, int p_index) {
+	return node_check_handle(p_L, p_index);
 }
 
-static godot::Node3D *_resolve_node(godot::ObjectID p_node_id, const char *p_func_name) {
-	if (p_node_id.is_null()) {
-		godot::UtilityFunctions::printerr("native_physics.", p_func_name, ": node id is 0");
+static godot::Node3D *_resolve_node(NodeHandle p_node_id, const char *p_func_name) {
+	if (p_node_id == 0) {
+		LUAGD_REPORT_ERROR("native_physics", p_func_name, "node id is 0");
 		return nullptr;
 	}
 
 	godot::Node3D *node = node_resolve(p_node_id);
 	if (node == nullptr) {
-		godot::UtilityFunctions::printerr("native_physics.", p_func_name, ": node is no longer valid, id ", p_node_id);
+		LUAGD_REPORT_ERROR("native_physics", p_func_name, "node is no longer valid, id ", p_node_id);
 		return nullptr;
 	}
 
 	return node;
 }
 
-static godot::CharacterBody3D *_resolve_character_body(godot::ObjectID p_node_id, const char *p_func_name) {
+static godot::CharacterBody3D *_resolve_character_body(NodeHandle p_node_id, const char *p_func_name) {
 	godot::Node3D *node = _resolve_node(p_node_id, p_func_name);
 	if (node == nullptr) {
 		return nullptr;
@@ -44,14 +49,14 @@ static godot::CharacterBody3D *_resolve_character_body(godot::ObjectID p_node_id
 
 	godot::CharacterBody3D *body = godot::Object::cast_to<godot::CharacterBody3D>(node);
 	if (body == nullptr) {
-		godot::UtilityFunctions::printerr("native_physics.", p_func_name, ": node is not CharacterBody3D, id ", p_node_id);
+		LUAGD_REPORT_ERROR("native_physics", p_func_name, "node is not CharacterBody3D, id ", p_node_id);
 		return nullptr;
 	}
 
 	return body;
 }
 
-static godot::CollisionObject3D *_resolve_collision_object(godot::ObjectID p_node_id, const char *p_func_name) {
+static godot::CollisionObject3D *_resolve_collision_object(NodeHandle p_node_id, const char *p_func_name) {
 	godot::Node3D *node = _resolve_node(p_node_id, p_func_name);
 	if (node == nullptr) {
 		return nullptr;
@@ -73,13 +78,12 @@ static godot::CollisionObject3D *_resolve_collision_object(godot::ObjectID p_nod
 	}
 
 	// 节点及其子节点都不是 CollisionObject3D
-	godot::UtilityFunctions::printerr(
-		"native_physics.", p_func_name,
-		": node is not CollisionObject3D and no CollisionObject3D child found, id ", p_node_id);
+	LUAGD_REPORT_ERROR("native_physics", p_func_name,
+		"node is not CollisionObject3D and no CollisionObject3D child found, id ", p_node_id);
 	return nullptr;
 }
 
-static godot::PhysicsBody3D *_resolve_physics_body(godot::ObjectID p_node_id, const char *p_func_name) {
+static godot::PhysicsBody3D *_resolve_physics_body(NodeHandle p_node_id, const char *p_func_name) {
 	godot::Node3D *node = _resolve_node(p_node_id, p_func_name);
 	if (node == nullptr) {
 		return nullptr;
@@ -87,7 +91,7 @@ static godot::PhysicsBody3D *_resolve_physics_body(godot::ObjectID p_node_id, co
 
 	godot::PhysicsBody3D *body = godot::Object::cast_to<godot::PhysicsBody3D>(node);
 	if (body == nullptr) {
-		godot::UtilityFunctions::printerr("native_physics.", p_func_name, ": node is not PhysicsBody3D, id ", p_node_id);
+		LUAGD_REPORT_ERROR("native_physics", p_func_name, "node is not PhysicsBody3D, id ", p_node_id);
 		return nullptr;
 	}
 
@@ -97,7 +101,7 @@ static godot::PhysicsBody3D *_resolve_physics_body(godot::ObjectID p_node_id, co
 // move_and_slide(node_id) -> bool
 // 执行移动并滑动。
 static int l_move_and_slide(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	godot::CharacterBody3D *body = _resolve_character_body(node_id, "move_and_slide");
 	if (body == nullptr) {
 		lua_pushboolean(p_L, false);
@@ -112,15 +116,15 @@ static int l_move_and_slide(lua_State *p_L) {
 // -> collided, travel_x, travel_y, travel_z, remainder_x, remainder_y, remainder_z,
 //    normal_x, normal_y, normal_z, position_x, position_y, position_z, collider_id
 // 按位移移动 PhysicsBody3D，并返回首个碰撞信息。
+// 位移可为 native_math.Vector3，此时其余参数依次前移两位。
 static int l_move_and_collide(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
-	const double x = luaL_checknumber(p_L, 2);
-	const double y = luaL_checknumber(p_L, 3);
-	const double z = luaL_checknumber(p_L, 4);
-	const bool test_only = lua_toboolean(p_L, 5);
-	const float safe_margin = (float)luaL_optnumber(p_L, 6, 0.001);
-	const bool recovery_as_collision = lua_toboolean(p_L, 7);
-	const int max_collisions = (int)luaL_optinteger(p_L, 8, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
+	godot::Vector3 motion;
+	const int next = 2 + math_check_vector3(p_L, 2, motion);
+	const bool test_only = lua_toboolean(p_L, next);
+	const float safe_margin = (float)luaL_optnumber(p_L, next + 1, 0.001);
+	const bool recovery_as_collision = lua_toboolean(p_L, next + 2);
+	const int max_collisions = (int)luaL_optinteger(p_L, next + 3, 1);
 
 	godot::PhysicsBody3D *body = _resolve_physics_body(node_id, "move_and_collide");
 	if (body == nullptr) {
@@ -130,7 +134,6 @@ static int l_move_and_collide(lua_State *p_L) {
 		return 14;
 	}
 
-	const godot::Vector3 motion((float)x, (float)y, (float)z);
 	godot::Ref<godot::KinematicCollision3D> collision = body->move_and_collide(motion, test_only, safe_margin, recovery_as_collision, max_collisions);
 
 	if (collision.is_null()) {
@@ -157,64 +160,50 @@ static int l_move_and_collide(lua_State *p_L) {
 }
 
 // set_velocity(node_id, x, y, z) -> void
-// 设置速度向量。
+// set_velocity(node_id, v) -> void
+// 设置速度向量，可传入 native_math.Vector3。
 static int l_set_velocity(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
-	const double x = luaL_checknumber(p_L, 2);
-	const double y = luaL_checknumber(p_L, 3);
-	const double z = luaL_checknumber(p_L, 4);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
+	godot::Vector3 velocity;
+	math_check_vector3(p_L, 2, velocity);
 
 	godot::CharacterBody3D *body = _resolve_character_body(node_id, "set_velocity");
 	if (body == nullptr) {
 		return 0;
 	}
 
-	body->set_velocity(godot::Vector3((float)x, (float)y, (float)z));
+	body->set_velocity(velocity);
 	return 0;
 }
 
-// get_velocity(node_id) -> x, y, z
-// 获取速度向量。
+// get_velocity(node_id, out) -> x, y, z | out
+// 获取速度向量。out 为 native_math.Vector3 时写入 out 并返回它。
 static int l_get_velocity(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	godot::CharacterBody3D *body = _resolve_character_body(node_id, "get_velocity");
 	if (body == nullptr) {
-		lua_pushnumber(p_L, 0);
-		lua_pushnumber(p_L, 0);
-		lua_pushnumber(p_L, 0);
-		return 3;
+		return math_return_vector3(p_L, 2, godot::Vector3());
 	}
 
-	const godot::Vector3 velocity = body->get_velocity();
-	lua_pushnumber(p_L, velocity.x);
-	lua_pushnumber(p_L, velocity.y);
-	lua_pushnumber(p_L, velocity.z);
-	return 3;
+	return math_return_vector3(p_L, 2, body->get_velocity());
 }
 
-// get_real_velocity(node_id) -> x, y, z
-// 获取实际移动速度。
+// get_real_velocity(node_id, out) -> x, y, z | out
+// 获取实际移动速度。out 为 native_math.Vector3 时写入 out 并返回它。
 static int l_get_real_velocity(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	godot::CharacterBody3D *body = _resolve_character_body(node_id, "get_real_velocity");
 	if (body == nullptr) {
-		lua_pushnumber(p_L, 0);
-		lua_pushnumber(p_L, 0);
-		lua_pushnumber(p_L, 0);
-		return 3;
+		return math_return_vector3(p_L, 2, godot::Vector3());
 	}
 
-	const godot::Vector3 velocity = body->get_real_velocity();
-	lua_pushnumber(p_L, velocity.x);
-	lua_pushnumber(p_L, velocity.y);
-	lua_pushnumber(p_L, velocity.z);
-	return 3;
+	return math_return_vector3(p_L, 2, body->get_real_velocity());
 }
 
 // is_on_floor(node_id) -> bool
 // 检查是否在地面上。
 static int l_is_on_floor(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	godot::CharacterBody3D *body = _resolve_character_body(node_id, "is_on_floor");
 	if (body == nullptr) {
 		lua_pushboolean(p_L, false);
@@ -228,7 +217,7 @@ static int l_is_on_floor(lua_State *p_L) {
 // is_on_wall(node_id) -> bool
 // 检查是否在墙上。
 static int l_is_on_wall(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	godot::CharacterBody3D *body = _resolve_character_body(node_id, "is_on_wall");
 	if (body == nullptr) {
 		lua_pushboolean(p_L, false);
@@ -242,7 +231,7 @@ static int l_is_on_wall(lua_State *p_L) {
 // is_on_ceiling(node_id) -> bool
 // 检查是否在天花板上。
 static int l_is_on_ceiling(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	godot::CharacterBody3D *body = _resolve_character_body(node_id, "is_on_ceiling");
 	if (body == nullptr) {
 		lua_pushboolean(p_L, false);
@@ -253,29 +242,22 @@ static int l_is_on_ceiling(lua_State *p_L) {
 	return 1;
 }
 
-// get_floor_normal(node_id) -> x, y, z
-// 获取地面法线。
+// get_floor_normal(node_id, out) -> x, y, z | out
+// 获取地面法线。out 为 native_math.Vector3 时写入 out 并返回它。
 static int l_get_floor_normal(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	godot::CharacterBody3D *body = _resolve_character_body(node_id, "get_floor_normal");
 	if (body == nullptr) {
-		lua_pushnumber(p_L, 0);
-		lua_pushnumber(p_L, 0);
-		lua_pushnumber(p_L, 0);
-		return 3;
+		return math_return_vector3(p_L, 2, godot::Vector3());
 	}
 
-	const godot::Vector3 normal = body->get_floor_normal();
-	lua_pushnumber(p_L, normal.x);
-	lua_pushnumber(p_L, normal.y);
-	lua_pushnumber(p_L, normal.z);
-	return 3;
+	return math_return_vector3(p_L, 2, body->get_floor_normal());
 }
 
 // set_collision_layer(node_id, layer) -> void
 // 设置 CollisionObject3D 的碰撞层。
 static int l_set_collision_layer(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	const uint32_t layer = (uint32_t)luaL_checkinteger(p_L, 2);
 
 	godot::CollisionObject3D *collision_object = _resolve_collision_object(node_id, "set_collision_layer");
@@ -290,7 +272,7 @@ static int l_set_collision_layer(lua_State *p_L) {
 // get_collision_layer(node_id) -> integer
 // 获取 CollisionObject3D 的碰撞层。
 static int l_get_collision_layer(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	godot::CollisionObject3D *collision_object = _resolve_collision_object(node_id, "get_collision_layer");
 	if (collision_object == nullptr) {
 		lua_pushinteger(p_L, 0);
@@ -304,7 +286,7 @@ static int l_get_collision_layer(lua_State *p_L) {
 // set_collision_mask(node_id, mask) -> void
 // 设置 CollisionObject3D 的碰撞掩码。
 static int l_set_collision_mask(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	const uint32_t mask = (uint32_t)luaL_checkinteger(p_L, 2);
 
 	godot::CollisionObject3D *collision_object = _resolve_collision_object(node_id, "set_collision_mask");
@@ -319,7 +301,7 @@ static int l_set_collision_mask(lua_State *p_L) {
 // get_collision_mask(node_id) -> integer
 // 获取 CollisionObject3D 的碰撞掩码。
 static int l_get_collision_mask(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	godot::CollisionObject3D *collision_object = _resolve_collision_object(node_id, "get_collision_mask");
 	if (collision_object == nullptr) {
 		lua_pushinteger(p_L, 0);
@@ -347,8 +329,27 @@ static const luaL_Reg physics_funcs[] = {
 	{nullptr, nullptr}
 };
 
+// 以节点为第一个参数、作为 native_node.Node 方法暴露的函数
+static const char *const physics_node_methods[] = {
+	"move_and_slide",
+	"move_and_collide",
+	"set_velocity",
+	"get_velocity",
+	"get_real_velocity",
+	"is_on_floor",
+	"is_on_wall",
+	"is_on_ceiling",
+	"get_floor_normal",
+	"set_collision_layer",
+	"get_collision_layer",
+	"set_collision_mask",
+	"get_collision_mask",
+	nullptr
+};
+
 int luaopen_native_physics(lua_State *p_L) {
-	luaL_newlib(p_L, physics_funcs);
+	lua_binding_new_lib(p_L, "native_physics", physics_funcs);
+	node_register_methods(p_L, -1, physics_node_methods);
 	return 1;
 }
 
@@ -1,5 +1,9 @@
 #include "res_module.h"
 
+#include "../host/host_error_sink.h"
+#include "../host/host_thread_check.h"
+#include "../lua/lua_binding_stats.h"
+
 #include <godot_cpp/classes/resource.hpp>
 #include <godot_cpp/classes/resource_loader.hpp>
 #include <godot_cpp/templates/hash_map.hpp>
@@ -32,7 +36,7 @@ static int l_load(lua_State *p_L) {
 	// 加载资源
 	godot::Ref<godot::Resource> resource = godot::ResourceLoader::get_singleton()->load(res_path);
 	if (resource.is_null()) {
-		godot::UtilityFunctions::printerr("native_res.load: failed to load resource: ", path);
+		LUAGD_REPORT_ERROR("native_res", "load", "failed to load resource: ", path);
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
@@ -77,7 +81,7 @@ static const luaL_Reg res_funcs[] = {
 };
 
 int luaopen_native_res(lua_State *p_L) {
-	luaL_newlib(p_L, res_funcs);
+	lua_binding_new_lib(p_L, "native_res", res_funcs);
 	return 1;
 }
 
@@ -85,4 +89,13 @@ void res_cleanup() {
 	loaded_resources.clear();
 }
 
+void res_collect_memory(godot::LocalVector<HostMemoryTable> &r_tables) {
+	int64_t bytes = host_memory_hash_map_bytes(loaded_resources);
+	for (const godot::KeyValue<godot::String, godot::Ref<godot::Resource>> &entry : loaded_resources) {
+		// 只计路径字符串，资源本身由 Godot 管理
+		bytes += (int64_t)entry.key.length() * 4;
+	}
+	r_tables.push_back({"native_res.loaded_resources", (int64_t)loaded_resources.size(), bytes});
+}
+
 } // namespace luagd
@@ -1,6 +1,8 @@
 #ifndef LUAGD_RES_MODULE_H
 #define LUAGD_RES_MODULE_H
 
+#include "../host/host_memory_stats.h"
+
 struct lua_State;
 
 namespace luagd {
@@ -10,6 +12,9 @@ namespace luagd {
 // 返回：在 Lua 栈上返回 1（模块表）。
 int luaopen_native_res(lua_State *p_L);
 
+// 把模块表的条目数与估算字节数追加到 r_tables，供 host_memory_collect 使用。
+void res_collect_memory(godot::LocalVector<HostMemoryTable> &r_tables);
+
 // 清理所有已加载的资源。
 // 在 LuaRuntime::shutdown() 时调用。
 void res_cleanup();
@@ -1,7 +1,12 @@
 #include "skeleton_module.h"
 
+#include "math_module.h"
 #include "node_module.h"
 
+#include "../host/host_error_sink.h"
+#include "../host/host_thread_check.h"
+#include "../lua/lua_binding_stats.h"
+
 #include <godot_cpp/classes/skeleton3d.hpp>
 #include <godot_cpp/core/math.hpp>
 #include <godot_cpp/core/object.hpp>
@@ -19,25 +24,25 @@ extern "C" {
 
 namespace luagd {
 
-static godot::ObjectID _read_node_id(lua_State *p_L, int p_index) {
-	return godot::ObjectID((uint64_t)luaL_checkinteger(p_L, p_index));
+static NodeHandle _read_node_id(lua_State *p_L, int p_index) {
+	return node_check_handle(p_L, p_index);
 }
 
-static godot::Skeleton3D *_resolve_skeleton(godot::ObjectID p_node_id, const char *p_func_name) {
-	if (p_node_id.is_null()) {
-		godot::UtilityFunctions::printerr("native_skeleton.", p_func_name, ": node id is 0");
+static godot::Skeleton3D *_resolve_skeleton(NodeHandle p_node_id, const char *p_func_name) {
+	if (p_node_id == 0) {
+		LUAGD_REPORT_ERROR("native_skeleton", p_func_name, "node id is 0");
 		return nullptr;
 	}
 
 	godot::Node3D *node = node_resolve(p_node_id);
 	if (node == nullptr) {
-		godot::UtilityFunctions::printerr("native_skeleton.", p_func_name, ": node is no longer valid, id ", p_node_id);
+		LUAGD_REPORT_ERROR("native_skeleton", p_func_name, "node is no longer valid, id ", p_node_id);
 		return nullptr;
 	}
 
 	godot::Skeleton3D *skeleton = godot::Object::cast_to<godot::Skeleton3D>(node);
 	if (skeleton == nullptr) {
-		godot::UtilityFunctions::printerr("native_skeleton.", p_func_name, ": node is not Skeleton3D, id ", p_node_id);
+		LUAGD_REPORT_ERROR("native_skeleton", p_func_name, "node is not Skeleton3D, id ", p_node_id);
 		return nullptr;
 	}
 
@@ -47,7 +52,7 @@ static godot::Skeleton3D *_resolve_skeleton(godot::ObjectID p_node_id, const cha
 static bool _resolve_bone(godot::Skeleton3D *p_skeleton, const char *p_bone_name, int &r_bone_idx, const char *p_func_name) {
 	r_bone_idx = p_skeleton->find_bone(godot::String(p_bone_name));
 	if (r_bone_idx == -1) {
-		godot::UtilityFunctions::printerr("native_skeleton.", p_func_name, ": bone \"", p_bone_name, "\" not found");
+		LUAGD_REPORT_ERROR("native_skeleton", p_func_name, "bone \"", p_bone_name, "\" not found");
 		return false;
 	}
 	return true;
@@ -55,7 +60,7 @@ static bool _resolve_bone(godot::Skeleton3D *p_skeleton, const char *p_bone_name
 
 // bone_exists(skeleton_node_id, bone_name) -> bool
 static int l_bone_exists(lua_State *p_L) {
-	const godot::ObjectID skeleton_id = _read_node_id(p_L, 1);
+	const NodeHandle skeleton_id = _read_node_id(p_L, 1);
 	const char *bone_name = luaL_checkstring(p_L, 2);
 
 	godot::Skeleton3D *skeleton = _resolve_skeleton(skeleton_id, "bone_exists");
@@ -71,7 +76,7 @@ static int l_bone_exists(lua_State *p_L) {
 
 // get_bone_count(skeleton_node_id) -> count
 static int l_get_bone_count(lua_State *p_L) {
-	const godot::ObjectID skeleton_id = _read_node_id(p_L, 1);
+	const NodeHandle skeleton_id = _read_node_id(p_L, 1);
 
 	godot::Skeleton3D *skeleton = _resolve_skeleton(skeleton_id, "get_bone_count");
 	if (skeleton == nullptr) {
@@ -85,7 +90,7 @@ static int l_get_bone_count(lua_State *p_L) {
 
 // get_bone_name(skeleton_node_id, bone_idx) -> name
 static int l_get_bone_name(lua_State *p_L) {
-	const godot::ObjectID skeleton_id = _read_node_id(p_L, 1);
+	const NodeHandle skeleton_id = _read_node_id(p_L, 1);
 	const int bone_idx = luaL_checkinteger(p_L, 2);
 
 	godot::Skeleton3D *skeleton = _resolve_skeleton(skeleton_id, "get_bone_name");
@@ -101,13 +106,16 @@ static int l_get_bone_name(lua_State *p_L) {
 // --- 位置操作 ---
 
 // set_bone_position(skeleton_node_id, bone_name, x, y, z, is_global) -> void
+// set_bone_position(skeleton_node_id, bone_name, v, is_global) -> void
 static int l_set_bone_position(lua_State *p_L) {
-	const godot::ObjectID skeleton_id = _read_node_id(p_L, 1);
+	const NodeHandle skeleton_id = _read_node_id(p_L, 1);
 	const char *bone_name = luaL_checkstring(p_L, 2);
-	const double x = luaL_checknumber(p_L, 3);
-	const double y = luaL_checknumber(p_L, 4);
-	const double z = luaL_checknumber(p_L, 5);
-	const bool is_global = lua_toboolean(p_L, 6);
+	godot::Vector3 value;
+	const int consumed = math_check_vector3(p_L, 3, value);
+	const double x = value.x;
+	const double y = value.y;
+	const double z = value.z;
+	const bool is_global = lua_toboolean(p_L, 3 + consumed);
 
 	godot::Skeleton3D *skeleton = _resolve_skeleton(skeleton_id, "set_bone_position");
 	if (skeleton == nullptr) {
@@ -135,7 +143,7 @@ static int l_set_bone_position(lua_State *p_L) {
 
 // get_bone_position(skeleton_node_id, bone_name, is_global) -> x, y, z
 static int l_get_bone_position(lua_State *p_L) {
-	const godot::ObjectID skeleton_id = _read_node_id(p_L, 1);
+	const NodeHandle skeleton_id = _read_node_id(p_L, 1);
 	const char *bone_name = luaL_checkstring(p_L, 2);
 	const bool is_global = lua_toboolean(p_L, 3);
 
@@ -174,13 +182,16 @@ static int l_get_bone_position(lua_State *p_L) {
 // --- 旋转操作 ---
 
 // set_bone_rotation(skeleton_node_id, bone_name, x, y, z, is_global) -> void
+// set_bone_rotation(skeleton_node_id, bone_name, v, is_global) -> void
 static int l_set_bone_rotation(lua_State *p_L) {
-	const godot::ObjectID skeleton_id = _read_node_id(p_L, 1);
+	const NodeHandle skeleton_id = _read_node_id(p_L, 1);
 	const char *bone_name = luaL_checkstring(p_L, 2);
-	const double x = luaL_checknumber(p_L, 3);
-	const double y = luaL_checknumber(p_L, 4);
-	const double z = luaL_checknumber(p_L, 5);
-	const bool is_global = lua_toboolean(p_L, 6);
+	godot::Vector3 value;
+	const int consumed = math_check_vector3(p_L, 3, value);
+	const double x = value.x;
+	const double y = value.y;
+	const double z = value.z;
+	const bool is_global = lua_toboolean(p_L, 3 + consumed);
 
 	godot::Skeleton3D *skeleton = _resolve_skeleton(skeleton_id, "set_bone_rotation");
 	if (skeleton == nullptr) {
@@ -220,7 +231,7 @@ static int l_set_bone_rotation(lua_State *p_L) {
 
 // get_bone_rotation(skeleton_node_id, bone_name, is_global) -> x, y, z
 static int l_get_bone_rotation(lua_State *p_L) {
-	const godot::ObjectID skeleton_id = _read_node_id(p_L, 1);
+	const NodeHandle skeleton_id = _read_node_id(p_L, 1);
 	const char *bone_name = luaL_checkstring(p_L, 2);
 	const bool is_global = lua_toboolean(p_L, 3);
 
@@ -259,13 +270,16 @@ static int l_get_bone_rotation(lua_State *p_L) {
 // --- 缩放操作 ---
 
 // set_bone_scale(skeleton_node_id, bone_name, x, y, z, is_global) -> void
+// set_bone_scale(skeleton_node_id, bone_name, v, is_global) -> void
 static int l_set_bone_scale(lua_State *p_L) {
-	const godot::ObjectID skeleton_id = _read_node_id(p_L, 1);
+	const NodeHandle skeleton_id = _read_node_id(p_L, 1);
 	const char *bone_name = luaL_checkstring(p_L, 2);
-	const double x = luaL_checknumber(p_L, 3);
-	const double y = luaL_checknumber(p_L, 4);
-	const double z = luaL_checknumber(p_L, 5);
-	const bool is_global = lua_toboolean(p_L, 6);
+	godot::Vector3 value;
+	const int consumed = math_check_vector3(p_L, 3, value);
+	const double x = value.x;
+	const double y = value.y;
+	const double z = value.z;
+	const bool is_global = lua_toboolean(p_L, 3 + consumed);
 
 	godot::Skeleton3D *skeleton = _resolve_skeleton(skeleton_id, "set_bone_scale");
 	if (skeleton == nullptr) {
@@ -300,7 +314,7 @@ static int l_set_bone_scale(lua_State *p_L) {
 
 // get_bone_scale(skeleton_node_id, bone_name, is_global) -> x, y, z
 static int l_get_bone_scale(lua_State *p_L) {
-	const godot::ObjectID skeleton_id = _read_node_id(p_L, 1);
+	const NodeHandle skeleton_id = _read_node_id(p_L, 1);
 	const char *bone_name = luaL_checkstring(p_L, 2);
 	const bool is_global = lua_toboolean(p_L, 3);
 
@@ -339,8 +353,8 @@ static int l_get_bone_scale(lua_State *p_L) {
 // copy_pose(src_skeleton_id, dst_skeleton_id) -> bool
 // 从源骨架复制所有骨骼姿势到目标骨架。
 static int l_copy_pose(lua_State *p_L) {
-	const godot::ObjectID src_id = _read_node_id(p_L, 1);
-	const godot::ObjectID dst_id = _read_node_id(p_L, 2);
+	const NodeHandle src_id = _read_node_id(p_L, 1);
+	const NodeHandle dst_id = _read_node_id(p_L, 2);
 
 	godot::Skeleton3D *src_skeleton = _resolve_skeleton(src_id, "copy_pose");
 	if (src_skeleton == nullptr) {
@@ -357,7 +371,7 @@ static int l_copy_pose(lua_State *p_L) {
 	int src_bone_count = src_skeleton->get_bone_count();
 	int dst_bone_count = dst_skeleton->get_bone_count();
 	if (src_bone_count != dst_bone_count) {
-		godot::UtilityFunctions::printerr("native_skeleton.copy_pose: bone count mismatch, src=", src_bone_count, " dst=", dst_bone_count);
+		LUAGD_REPORT_ERROR("native_skeleton", "copy_pose", "bone count mismatch, src=", src_bone_count, " dst=", dst_bone_count);
 		lua_pushboolean(p_L, false);
 		return 1;
 	}
@@ -385,8 +399,24 @@ static const luaL_Reg skeleton_funcs[] = {
 	{nullptr, nullptr}
 };
 
+// 以节点为第一个参数、作为 native_node.Node 方法暴露的函数
+static const char *const skeleton_node_methods[] = {
+	"bone_exists",
+	"get_bone_count",
+	"get_bone_name",
+	"set_bone_position",
+	"get_bone_position",
+	"set_bone_rotation",
+	"get_bone_rotation",
+	"set_bone_scale",
+	"get_bone_scale",
+	"copy_pose",
+	nullptr
+};
+
 int luaopen_native_skeleton(lua_State *p_L) {
-	luaL_newlib(p_L, skeleton_funcs);
+	lua_binding_new_lib(p_L, "native_skeleton", skeleton_funcs);
+	node_register_methods(p_L, -1, skeleton_node_methods);
 	return 1;
 }
 
@@ -1,5 +1,9 @@
 #include "system_module.h"
 
+#include "../host/host_error_sink.h"
+#include "../host/host_thread_check.h"
+#include "../lua/lua_binding_stats.h"
+
 #include <godot_cpp/classes/os.hpp>
 #include <godot_cpp/classes/rendering_server.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
@@ -17,7 +21,7 @@ namespace luagd {
 static int l_get_name(lua_State *p_L) {
 	godot::OS *os = godot::OS::get_singleton();
 	if (os == nullptr) {
-		godot::UtilityFunctions::printerr("native_system.get_name: OS not available");
+		LUAGD_REPORT_ERROR("native_system", "get_name", "OS not available");
 		lua_pushliteral(p_L, "Unknown");
 		return 1;
 	}
@@ -33,7 +37,7 @@ static int l_get_name(lua_State *p_L) {
 static int l_get_rendering_method(lua_State *p_L) {
 	godot::OS *os = godot::OS::get_singleton();
 	if (os == nullptr) {
-		godot::UtilityFunctions::printerr("native_system.get_rendering_method: OS not available");
+		LUAGD_REPORT_ERROR("native_system", "get_rendering_method", "OS not available");
 		lua_pushliteral(p_L, "Unknown");
 		return 1;
 	}
@@ -51,7 +55,7 @@ static const luaL_Reg system_funcs[] = {
 };
 
 int luaopen_native_system(lua_State *p_L) {
-	luaL_newlib(p_L, system_funcs);
+	lua_binding_new_lib(p_L, "native_system", system_funcs);
 	return 1;
 }
 
@@ -0,0 +1,421 @@
+#include "timer_module.h"
+
+#include "../host/host_error_sink.h"
+#include "../host/host_thread_check.h"
+#include "../lua/lua_binding_stats.h"
+#include "../lua/lua_runtime.h"
+
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+extern "C" {
+#include <lua.h>
+#include <lauxlib.h>
+}
+
+namespace luagd {
+
+// 时间轮刻度：1 tick = 1 毫秒。
+static const double TICKS_PER_SECOND = 1000.0;
+
+// 分层时间轮：第 0 层 256 格（256 ms），其余 3 层各 64 格，
+// 覆盖 2^26 ms（约 18.6 小时），更远的定时器挂在最高层最远的格子里、逐层下落。
+static const int WHEEL_ROOT_BITS = 8;
+static const int WHEEL_LEVEL_BITS = 6;
+static const int WHEEL_ROOT_SIZE = 1 << WHEEL_ROOT_BITS;
+static const int WHEEL_LEVEL_SIZE = 1 << WHEEL_LEVEL_BITS;
+static const int WHEEL_LEVEL_COUNT = 3;
+static const int WHEEL_BUCKET_COUNT = WHEEL_ROOT_SIZE + WHEEL_LEVEL_COUNT * WHEEL_LEVEL_SIZE;
+static const uint64_t WHEEL_MAX_DELTA = (1ULL << (WHEEL_ROOT_BITS + WHEEL_LEVEL_COUNT * WHEEL_LEVEL_BITS)) - 1;
+
+static const int32_t TIMER_NONE = -1;
+
+enum TimerState {
+	TIMER_FREE = 0,
+	TIMER_SCHEDULED = 1,
+	// 已从时间轮摘下，等待本帧派发
+	TIMER_DUE = 2,
+};
+
+// 定时器节点，存放在对象池中，通过 prev / next 挂入时间轮格子的双向链表。
+struct TimerNode {
+	uint64_t expire_tick;
+	uint64_t interval_ticks;
+	int callback_ref;
+	uint32_t generation;
+	int32_t prev;
+	int32_t next;
+	int32_t bucket;
+	TimerState state;
+};
+
+// 派发列表条目：节点在派发前可能被回调取消或复用，按 generation 校验
+struct TimerDue {
+	int32_t index;
+	uint32_t generation;
+};
+
+static godot::LocalVector<TimerNode> timer_nodes;
+static int32_t free_head = TIMER_NONE;
+static int32_t bucket_heads[WHEEL_BUCKET_COUNT];
+static bool buckets_initialized = false;
+// 下一个待处理的 tick
+static uint64_t wheel_tick = 0;
+static double tick_remainder = 0.0;
+static int32_t active_count = 0;
+static godot::LocalVector<TimerDue> due_timers;
+
+// 句柄：高 32 位 generation，低 32 位池索引；generation 从 1 开始，0 永远无效
+static lua_Integer _make_handle(int32_t p_index, uint32_t p_generation) {
+	return (lua_Integer)(((uint64_t)p_generation << 32) | (uint32_t)p_index);
+}
+
+static TimerNode *_resolve_handle(lua_Integer p_handle, int32_t *r_index) {
+	const uint64_t handle = (uint64_t)p_handle;
+	const int32_t index = (int32_t)(handle & 0xFFFFFFFFu);
+	const uint32_t generation = (uint32_t)(handle >> 32);
+	if (index < 0 || (uint32_t)index >= timer_nodes.size()) {
+		return nullptr;
+	}
+
+	TimerNode *node = &timer_nodes[index];
+	if (node->state == TIMER_FREE || node->generation != generation) {
+		return nullptr;
+	}
+	*r_index = index;
+	return node;
+}
+
+static void _ensure_buckets() {
+	if (buckets_initialized) {
+		return;
+	}
+	for (int i = 0; i < WHEEL_BUCKET_COUNT; i++) {
+		bucket_heads[i] = TIMER_NONE;
+	}
+	buckets_initialized = true;
+}
+
+static int32_t _alloc_node() {
+	if (free_head != TIMER_NONE) {
+		const int32_t index = free_head;
+		free_head = timer_nodes[index].next;
+		return index;
+	}
+
+	TimerNode node;
+	node.generation = 1;
+	node.state = TIMER_FREE;
+	timer_nodes.push_back(node);
+	return (int32_t)timer_nodes.size() - 1;
+}
+
+static void _free_node(int32_t p_index) {
+	TimerNode &node = timer_nodes[p_index];
+	node.state = TIMER_FREE;
+	node.callback_ref = LUA_NOREF;
+	node.bucket = TIMER_NONE;
+	node.prev = TIMER_NONE;
+	// generation 递增使旧句柄失效；保持为正数，句柄转为 lua_Integer 后不为负
+	node.generation = node.generation >= 0x7FFFFFFFu ? 1 : node.generation + 1;
+	node.next = free_head;
+	free_head = p_index;
+	active_count -= 1;
+}
+
+// 按到期 tick 选择格子（与 Linux 经典时间轮相同的索引方式）
+static int32_t _bucket_for(uint64_t p_expire_tick) {
+	const uint64_t delta = p_expire_tick > wheel_tick ? p_expire_tick - wheel_tick : 0;
+	if (delta < WHEEL_ROOT_SIZE) {
+		return (int32_t)(p_expire_tick & (WHEEL_ROOT_SIZE - 1));
+	}
+
+	for (int level = 0; level < WHEEL_LEVEL_COUNT; level++) {
+		const int shift = WHEEL_ROOT_BITS + (level + 1) * WHEEL_LEVEL_BITS;
+		if (delta < (1ULL << shift) || level == WHEEL_LEVEL_COUNT - 1) {
+			const int slot_shift = WHEEL_ROOT_BITS + level * WHEEL_LEVEL_BITS;
+			return WHEEL_ROOT_SIZE + level * WHEEL_LEVEL_SIZE + (int32_t)((p_expire_tick >> slot_shift) & (WHEEL_LEVEL_SIZE - 1));
+		}
+	}
+	return 0;
+}
+
+static void _link_node(int32_t p_index) {
+	TimerNode &node = timer_nodes[p_index];
+	const int32_t bucket = _bucket_for(node.expire_tick);
+	node.bucket = bucket;
+	node.prev = TIMER_NONE;
+	node.next = bucket_heads[bucket];
+	if (node.next != TIMER_NONE) {
+		timer_nodes[node.next].prev = p_index;
+	}
+	bucket_heads[bucket] = p_index;
+	node.state = TIMER_SCHEDULED;
+}
+
+static void _unlink_node(int32_t p_index) {
+	TimerNode &node = timer_nodes[p_index];
+	if (node.prev != TIMER_NONE) {
+		timer_nodes[node.prev].next = node.next;
+	} else {
+		bucket_heads[node.bucket] = node.next;
+	}
+	if (node.next != TIMER_NONE) {
+		timer_nodes[node.next].prev = node.prev;
+	}
+	node.prev = TIMER_NONE;
+	node.next = TIMER_NONE;
+	node.bucket = TIMER_NONE;
+}
+
+// 将高层格子中的定时器按剩余时间重新分配到更低层。
+// 返回：该层的格子索引；为 0 表示本层转完一圈，需继续处理更高一层。
+static int _cascade(int p_level) {
+	const int slot_shift = WHEEL_ROOT_BITS + p_level * WHEEL_LEVEL_BITS;
+	const int slot = (int)((wheel_tick >> slot_shift) & (WHEEL_LEVEL_SIZE - 1));
+	const int32_t bucket = WHEEL_ROOT_SIZE + p_level * WHEEL_LEVEL_SIZE + slot;
+
+	int32_t index = bucket_heads[bucket];
+	bucket_heads[bucket] = TIMER_NONE;
+	while (index != TIMER_NONE) {
+		const int32_t next = timer_nodes[index].next;
+		_link_node(index);
+		index = next;
+	}
+	return slot;
+}
+
+// 推进到 p_target_tick（不含），到期定时器移入 due_timers。
+static void _advance(uint64_t p_target_tick) {
+	while (wheel_tick < p_target_tick) {
+		const int root_slot = (int)(wheel_tick & (WHEEL_ROOT_SIZE - 1));
+		if (root_slot == 0) {
+			for (int level = 0; level < WHEEL_LEVEL_COUNT; level++) {
+				if (_cascade(level) != 0) {
+					break;
+				}
+			}
+		}
+
+		int32_t index = bucket_heads[root_slot];
+		bucket_heads[root_slot] = TIMER_NONE;
+		while (index != TIMER_NONE) {
+			TimerNode &node = timer_nodes[index];
+			const int32_t next = node.next;
+			node.prev = TIMER_NONE;
+			node.next = TIMER_NONE;
+			node.bucket = TIMER_NONE;
+			node.state = TIMER_DUE;
+			due_timers.push_back({index, node.generation});
+			index = next;
+		}
+
+		wheel_tick += 1;
+	}
+}
+
+static uint64_t _seconds_to_ticks(double p_seconds) {
+	if (!(p_seconds > 0.0)) {
+		return 0;
+	}
+	const double ticks = p_seconds * TICKS_PER_SECOND + 0.5;
+	if (ticks >= (double)WHEEL_MAX_DELTA) {
+		return WHEEL_MAX_DELTA;
+	}
+	return (uint64_t)ticks;
+}
+
+static int32_t _schedule(lua_State *p_L, double p_seconds, bool p_repeat) {
+	_ensure_buckets();
+
+	const int32_t index = _alloc_node();
+	TimerNode &node = timer_nodes[index];
+	uint64_t delay_ticks = _seconds_to_ticks(p_seconds);
+	if (p_repeat && delay_ticks == 0) {
+		// 重复定时器间隔至少 1 tick
+		delay_ticks = 1;
+	}
+
+	lua_pushvalue(p_L, 2);
+	node.callback_ref = luaL_ref(p_L, LUA_REGISTRYINDEX);
+	// wheel_tick 是下一个待处理的 tick，延迟为 0 时在下一帧触发
+	node.expire_tick = wheel_tick + delay_ticks;
+	node.interval_ticks = p_repeat ? delay_ticks : 0;
+	_link_node(index);
+	active_count += 1;
+	return index;
+}
+
+// native_timer.after(seconds, callback) -> integer
+// 在 seconds 秒（游戏时间）后调用 callback(handle) 一次。
+// 返回：定时器句柄。
+static int l_after(lua_State *p_L) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_timer.after")) {
+		return 0;
+	}
+
+	const double seconds = luaL_checknumber(p_L, 1);
+	luaL_checktype(p_L, 2, LUA_TFUNCTION);
+	const int32_t index = _schedule(p_L, seconds, false);
+	lua_pushinteger(p_L, _make_handle(index, timer_nodes[index].generation));
+	return 1;
+}
+
+// native_timer.every(seconds, callback) -> integer
+// 每隔 seconds 秒调用 callback(handle)，直到 cancel。
+// 返回：定时器句柄。
+static int l_every(lua_State *p_L) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_timer.every")) {
+		return 0;
+	}
+
+	const double seconds = luaL_checknumber(p_L, 1);
+	luaL_checktype(p_L, 2, LUA_TFUNCTION);
+	const int32_t index = _schedule(p_L, seconds, true);
+	lua_pushinteger(p_L, _make_handle(index, timer_nodes[index].generation));
+	return 1;
+}
+
+// native_timer.cancel(handle) -> bool
+// 返回：句柄有效（定时器尚未结束）时返回 true。
+static int l_cancel(lua_State *p_L) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_timer.cancel")) {
+		lua_pushboolean(p_L, 0);
+		return 1;
+	}
+
+	int32_t index = TIMER_NONE;
+	TimerNode *node = _resolve_handle(luaL_checkinteger(p_L, 1), &index);
+	if (node == nullptr) {
+		lua_pushboolean(p_L, 0);
+		return 1;
+	}
+
+	if (node->state == TIMER_SCHEDULED) {
+		_unlink_node(index);
+	}
+	// TIMER_DUE 的节点释放后 generation 变化，派发时自动跳过
+	luaL_unref(p_L, LUA_REGISTRYINDEX, node->callback_ref);
+	_free_node(index);
+	lua_pushboolean(p_L, 1);
+	return 1;
+}
+
+// native_timer.is_active(handle) -> bool
+static int l_is_active(lua_State *p_L) {
+	int32_t index = TIMER_NONE;
+	lua_pushboolean(p_L, _resolve_handle(luaL_checkinteger(p_L, 1), &index) != nullptr);
+	return 1;
+}
+
+// native_timer.remaining(handle) -> number | nil
+// 返回：距下次触发的秒数；句柄无效时返回 nil。
+static int l_remaining(lua_State *p_L) {
+	int32_t index = TIMER_NONE;
+	const TimerNode *node = _resolve_handle(luaL_checkinteger(p_L, 1), &index);
+	if (node == nullptr) {
+		return 0;
+	}
+
+	const uint64_t ticks = node->expire_tick > wheel_tick ? node->expire_tick - wheel_tick : 0;
+	lua_pushnumber(p_L, (double)ticks / TICKS_PER_SECOND);
+	return 1;
+}
+
+// native_timer.count() -> integer
+// 返回：活动定时器数量。
+static int l_count(lua_State *p_L) {
+	lua_pushinteger(p_L, active_count);
+	return 1;
+}
+
+static const luaL_Reg timer_funcs[] = {
+	{"after", l_after},
+	{"every", l_every},
+	{"cancel", l_cancel},
+	{"is_active", l_is_active},
+	{"remaining", l_remaining},
+	{"count", l_count},
+	{nullptr, nullptr}
+};
+
+int luaopen_native_timer(lua_State *p_L) {
+	lua_binding_new_lib(p_L, "native_timer", timer_funcs);
+	return 1;
+}
+
+void timer_tick(lua_State *p_L, double p_delta) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_timer.timer_tick")) {
+		return;
+	}
+	if (active_count == 0) {
+		// 没有定时器时时间轮照常前进，保持 remaining() 与新定时器的基准一致
+		tick_remainder = 0.0;
+		wheel_tick += _seconds_to_ticks(p_delta);
+		return;
+	}
+
+	tick_remainder += p_delta * TICKS_PER_SECOND;
+	const uint64_t elapsed = tick_remainder > 0.0 ? (uint64_t)tick_remainder : 0;
+	tick_remainder -= (double)elapsed;
+	_advance(wheel_tick + elapsed);
+	if (due_timers.is_empty()) {
+		return;
+	}
+
+	// 单个错误处理函数服务整个派发循环
+	lua_pushcfunction(p_L, lua_traceback_handler);
+	const int handler_index = lua_gettop(p_L);
+
+	for (uint32_t i = 0; i < due_timers.size(); i++) {
+		const TimerDue due = due_timers[i];
+		TimerNode &node = timer_nodes[due.index];
+		if (node.state != TIMER_DUE || node.generation != due.generation) {
+			continue;
+		}
+
+		const lua_Integer handle = _make_handle(due.index, due.generation);
+		const int callback_ref = node.callback_ref;
+		bool release_ref = false;
+		if (node.interval_ticks > 0) {
+			// 重复定时器先重新挂入，回调中可直接 cancel；落后超过一个周期时不补发
+			uint64_t next_tick = node.expire_tick + node.interval_ticks;
+			if (next_tick < wheel_tick) {
+				next_tick = wheel_tick;
+			}
+			node.expire_tick = next_tick;
+			_link_node(due.index);
+		} else {
+			_free_node(due.index);
+			release_ref = true;
+		}
+
+		lua_rawgeti(p_L, LUA_REGISTRYINDEX, callback_ref);
+		lua_pushinteger(p_L, handle);
+		if (lua_pcall(p_L, 1, 0, handler_index) != LUA_OK) {
+			const char *err = lua_tostring(p_L, -1);
+			LUAGD_REPORT_ERROR("native_timer", "callback", err ? err : "(unknown)");
+			lua_pop(p_L, 1);
+		}
+
+		if (release_ref) {
+			luaL_unref(p_L, LUA_REGISTRYINDEX, callback_ref);
+		}
+	}
+
+	lua_pop(p_L, 1);
+	due_timers.clear();
+}
+
+void timer_cleanup() {
+	// 回调引用随 lua_close 一并释放，这里只清理记录
+	timer_nodes.clear();
+	due_timers.clear();
+	free_head = TIMER_NONE;
+	buckets_initialized = false;
+	wheel_tick = 0;
+	tick_remainder = 0.0;
+	active_count = 0;
+}
+
+} // namespace luagd
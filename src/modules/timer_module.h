@@ -0,0 +1,23 @@
+#ifndef LUAGD_TIMER_MODULE_H
+#define LUAGD_TIMER_MODULE_H
+
+struct lua_State;
+
+namespace luagd {
+
+// 打开 native_timer 模块。
+// 提供基于分层时间轮的一次性与重复定时器，调度与取消均为 O(1)。
+// 返回：在 Lua 栈上返回 1（模块表）。
+int luaopen_native_timer(lua_State *p_L);
+
+// 推进时间轮并在同一个派发循环中调用本帧到期的所有回调。
+// p_delta: 本帧时间（秒）。
+// 约束：只允许在主线程调用。由 LuaHost::tick 调用。
+void timer_tick(lua_State *p_L, double p_delta);
+
+// 清理所有定时器记录。在 LuaRuntime::shutdown 时调用。
+void timer_cleanup();
+
+} // namespace luagd
+
+#endif // LUAGD_TIMER_MODULE_H
@@ -1,12 +1,23 @@
 #include "transform_module.h"
 
+#include "math_module.h"
 #include "node_module.h"
 
+#include "../host/host_error_sink.h"
+#include "../host/host_thread_check.h"
+#include "../host/host_trace.h"
+#include "../lua/lua_binding_stats.h"
+#include "../lua/lua_float_buffer.h"
+
 #include <godot_cpp/classes/control.hpp>
 #include <godot_cpp/classes/node3d.hpp>
 #include <godot_cpp/core/object_id.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 
+#include <cstring>
+
 extern "C" {
 #include <lua.h>
 #include <lauxlib.h>
@@ -14,29 +25,21 @@ extern "C" {
 
 namespace luagd {
 
-static godot::ObjectID _read_node_id(lua_State *p_L, int p_index) {
-	return godot::ObjectID((uint64_t)luaL_checkinteger(p_L, p_index));
+static NodeHandle _read_node_id(lua_State *p_L, int p_index) {
+	return node_check_handle(p_L, p_index);
 }
 
 // 尝试解析为 Node3D。
 // 返回：成功返回 Node3D 指针；句柄为空或类型不符时返回 nullptr（不输出错误）。
-static godot::Node3D *_try_resolve_node3d(godot::ObjectID p_id) {
-	if (p_id.is_null()) {
-		return nullptr;
-	}
-
-	godot::Node *node = node_resolve_any(p_id);
-	if (node == nullptr) {
-		return nullptr;
-	}
-
-	return godot::Object::cast_to<godot::Node3D>(node);
+static godot::Node3D *_try_resolve_node3d(NodeHandle p_id) {
+	// 槽位缓存了 Node3D 指针，无需再 cast
+	return node_resolve(p_id);
 }
 
 // 尝试解析为 Control。
 // 返回：成功返回 Control 指针；句柄为空或类型不符时返回 nullptr（不输出错误）。
-static godot::Control *_try_resolve_control(godot::ObjectID p_id) {
-	if (p_id.is_null()) {
+static godot::Control *_try_resolve_control(NodeHandle p_id) {
+	if (p_id == 0) {
 		return nullptr;
 	}
 
@@ -49,21 +52,20 @@ static godot::Control *_try_resolve_control(godot::ObjectID p_id) {
 }
 
 // set_position(node_id, x, y, z?, is_global?) -> void
-// 设置节点位置。
+// set_position(node_id, v, is_global?) -> void
+// 设置节点位置。位置可为 native_math.Vector3，此时 is_global 紧随其后。
 // Node3D: 需要 x, y, z 三个参数，第 5 个参数为 is_global。
-// Control: 需要 x, y 两个参数，第 3 或第 4 个参数为 is_global。
+// Control: 需要 x, y 两个参数，第 3 或第 4 个参数为 is_global；传入 Vector3 时忽略 z。
 static int l_set_position(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 
 	// 尝试 Node3D
 	godot::Node3D *node3d = _try_resolve_node3d(node_id);
 	if (node3d != nullptr) {
-		const double x = luaL_checknumber(p_L, 2);
-		const double y = luaL_checknumber(p_L, 3);
-		const double z = luaL_checknumber(p_L, 4);
-		const bool is_global = lua_toboolean(p_L, 5);
+		godot::Vector3 position;
+		const int consumed = math_check_vector3(p_L, 2, position);
+		const bool is_global = lua_toboolean(p_L, 2 + consumed);
 
-		const godot::Vector3 position((float)x, (float)y, (float)z);
 		if (is_global) {
 			node3d->set_global_position(position);
 		} else {
@@ -75,9 +77,10 @@ static int l_set_position(lua_State *p_L) {
 	// 尝试 Control
 	godot::Control *control = _try_resolve_control(node_id);
 	if (control != nullptr) {
-		const double x = luaL_checknumber(p_L, 2);
-		const double y = luaL_checknumber(p_L, 3);
-		const bool is_global = lua_toboolean(p_L, 4);
+		const godot::Vector3 *vector = math_test_vector3(p_L, 2);
+		const double x = vector != nullptr ? vector->x : luaL_checknumber(p_L, 2);
+		const double y = vector != nullptr ? vector->y : luaL_checknumber(p_L, 3);
+		const bool is_global = lua_toboolean(p_L, vector != nullptr ? 3 : 4);
 
 		const godot::Vector2 position((float)x, (float)y);
 		if (is_global) {
@@ -88,21 +91,25 @@ static int l_set_position(lua_State *p_L) {
 		return 0;
 	}
 
-	godot::UtilityFunctions::printerr("native_transform.set_position: node is not Node3D or Control, id=", (uint64_t)node_id);
+	LUAGD_REPORT_ERROR("native_transform", "set_position", "node is not Node3D or Control, id=", (uint64_t)node_id);
 	return 0;
 }
 
-// get_position(node_id, is_global) -> x, y, z | x, y
+// get_position(node_id, is_global, out) -> x, y, z | x, y | out
 // 获取节点位置。
 // Node3D 返回 3 个值 (x, y, z)，Control 返回 2 个值 (x, y)。
+// out 为 native_math.Vector3 时写入 out 并返回它（Control 的 z 为 0），不产生新对象。
 static int l_get_position(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	const bool is_global = lua_toboolean(p_L, 2);
 
 	// 尝试 Node3D
 	godot::Node3D *node3d = _try_resolve_node3d(node_id);
 	if (node3d != nullptr) {
 		const godot::Vector3 position = is_global ? node3d->get_global_position() : node3d->get_position();
+		if (math_write_vector3(p_L, 3, position)) {
+			return 1;
+		}
 		lua_pushnumber(p_L, position.x);
 		lua_pushnumber(p_L, position.y);
 		lua_pushnumber(p_L, position.z);
@@ -113,27 +120,34 @@ static int l_get_position(lua_State *p_L) {
 	godot::Control *control = _try_resolve_control(node_id);
 	if (control != nullptr) {
 		const godot::Vector2 position = is_global ? control->get_global_position() : control->get_position();
+		if (math_write_vector3(p_L, 3, godot::Vector3(position.x, position.y, 0.0f))) {
+			return 1;
+		}
 		lua_pushnumber(p_L, position.x);
 		lua_pushnumber(p_L, position.y);
 		return 2;
 	}
 
-	godot::UtilityFunctions::printerr("native_transform.get_position: node is not Node3D or Control, id=", (uint64_t)node_id);
+	LUAGD_REPORT_ERROR("native_transform", "get_position", "node is not Node3D or Control, id=", (uint64_t)node_id);
 	return 0;
 }
 
-// get_scale(node_id, is_global) -> x, y, z | x, y
+// get_scale(node_id, is_global, out) -> x, y, z | x, y | out
 // 获取节点缩放。
 // Node3D 返回 3 个值 (x, y, z)，支持 is_global。
 // Control 返回 2 个值 (x, y)，is_global 参数被忽略（Control 无全局缩放）。
+// out 为 native_math.Vector3 时写入 out 并返回它（Control 的 z 为 1）。
 static int l_get_scale(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	const bool is_global = lua_toboolean(p_L, 2);
 
 	// 尝试 Node3D
 	godot::Node3D *node3d = _try_resolve_node3d(node_id);
 	if (node3d != nullptr) {
 		const godot::Vector3 scale = is_global ? node3d->get_global_basis().get_scale() : node3d->get_scale();
+		if (math_write_vector3(p_L, 3, scale)) {
+			return 1;
+		}
 		lua_pushnumber(p_L, scale.x);
 		lua_pushnumber(p_L, scale.y);
 		lua_pushnumber(p_L, scale.z);
@@ -144,29 +158,30 @@ static int l_get_scale(lua_State *p_L) {
 	godot::Control *control = _try_resolve_control(node_id);
 	if (control != nullptr) {
 		const godot::Vector2 scale = control->get_scale();
+		if (math_write_vector3(p_L, 3, godot::Vector3(scale.x, scale.y, 1.0f))) {
+			return 1;
+		}
 		lua_pushnumber(p_L, scale.x);
 		lua_pushnumber(p_L, scale.y);
 		return 2;
 	}
 
-	godot::UtilityFunctions::printerr("native_transform.get_scale: node is not Node3D or Control, id=", (uint64_t)node_id);
+	LUAGD_REPORT_ERROR("native_transform", "get_scale", "node is not Node3D or Control, id=", (uint64_t)node_id);
 	return 0;
 }
 
 // set_scale(node_id, x, y, z?) -> void
+// set_scale(node_id, v) -> void
 // 设置节点缩放（局部）。
-// Node3D 需要 x, y, z 三个参数，Control 需要 x, y 两个参数。
+// Node3D 需要 x, y, z 三个参数，Control 需要 x, y 两个参数；也可传入 native_math.Vector3。
 static int l_set_scale(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 
 	// 尝试 Node3D
 	godot::Node3D *node3d = _try_resolve_node3d(node_id);
 	if (node3d != nullptr) {
-		const double x = luaL_checknumber(p_L, 2);
-		const double y = luaL_checknumber(p_L, 3);
-		const double z = luaL_checknumber(p_L, 4);
-
-		const godot::Vector3 scale((float)x, (float)y, (float)z);
+		godot::Vector3 scale;
+		math_check_vector3(p_L, 2, scale);
 		node3d->set_scale(scale);
 		return 0;
 	}
@@ -174,34 +189,46 @@ static int l_set_scale(lua_State *p_L) {
 	// 尝试 Control
 	godot::Control *control = _try_resolve_control(node_id);
 	if (control != nullptr) {
-		const double x = luaL_checknumber(p_L, 2);
-		const double y = luaL_checknumber(p_L, 3);
+		const godot::Vector3 *vector = math_test_vector3(p_L, 2);
+		const double x = vector != nullptr ? vector->x : luaL_checknumber(p_L, 2);
+		const double y = vector != nullptr ? vector->y : luaL_checknumber(p_L, 3);
 
 		const godot::Vector2 scale((float)x, (float)y);
 		control->set_scale(scale);
 		return 0;
 	}
 
-	godot::UtilityFunctions::printerr("native_transform.set_scale: node is not Node3D or Control, id=", (uint64_t)node_id);
+	LUAGD_REPORT_ERROR("native_transform", "set_scale", "node is not Node3D or Control, id=", (uint64_t)node_id);
 	return 0;
 }
 
 // set_rotation(node_id, x, y, z, is_global) -> void
-// 设置节点旋转（度数）。
+// set_rotation(node_id, v | q, is_global) -> void
+// 设置节点旋转：三个数字或 native_math.Vector3 为欧拉角（度数），native_math.Quaternion 直接设置朝向（保留缩放）。
 static int l_set_rotation(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
-	const double x = luaL_checknumber(p_L, 2);
-	const double y = luaL_checknumber(p_L, 3);
-	const double z = luaL_checknumber(p_L, 4);
-	const bool is_global = lua_toboolean(p_L, 5);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
+	const godot::Quaternion *quaternion = math_test_quaternion(p_L, 2);
+	godot::Vector3 rotation;
+	const int consumed = quaternion != nullptr ? 1 : math_check_vector3(p_L, 2, rotation);
+	const bool is_global = lua_toboolean(p_L, 2 + consumed);
 
 	godot::Node3D *node = _try_resolve_node3d(node_id);
 	if (node == nullptr) {
-		godot::UtilityFunctions::printerr("native_transform.set_rotation: node is not Node3D, id=", (uint64_t)node_id);
+		LUAGD_REPORT_ERROR("native_transform", "set_rotation", "node is not Node3D, id=", (uint64_t)node_id);
+		return 0;
+	}
+
+	if (quaternion != nullptr) {
+		if (is_global) {
+			godot::Transform3D transform = node->get_global_transform();
+			transform.basis.set_quaternion_scale(*quaternion, transform.basis.get_scale());
+			node->set_global_transform(transform);
+		} else {
+			node->set_quaternion(*quaternion);
+		}
 		return 0;
 	}
 
-	const godot::Vector3 rotation((float)x, (float)y, (float)z);
 	if (is_global) {
 		node->set_global_rotation_degrees(rotation);
 	} else {
@@ -210,66 +237,700 @@ static int l_set_rotation(lua_State *p_L) {
 	return 0;
 }
 
-// get_rotation(node_id, is_global) -> x, y, z
-// 获取节点旋转（度数）。
+// get_rotation(node_id, is_global, out) -> x, y, z | out
+// 获取节点旋转（度数）。out 为 native_math.Vector3 时写入 out 并返回它。
 static int l_get_rotation(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	const bool is_global = lua_toboolean(p_L, 2);
 
 	godot::Node3D *node = _try_resolve_node3d(node_id);
 	if (node == nullptr) {
-		godot::UtilityFunctions::printerr("native_transform.get_rotation: node is not Node3D, id=", (uint64_t)node_id);
+		LUAGD_REPORT_ERROR("native_transform", "get_rotation", "node is not Node3D, id=", (uint64_t)node_id);
 		return 0;
 	}
 
 	const godot::Vector3 rotation = is_global ? node->get_global_rotation_degrees() : node->get_rotation_degrees();
-	lua_pushnumber(p_L, rotation.x);
-	lua_pushnumber(p_L, rotation.y);
-	lua_pushnumber(p_L, rotation.z);
-	return 3;
+	return math_return_vector3(p_L, 3, rotation);
 }
 
 // look_at(node_id, target_x, target_y, target_z, use_model_front) -> void
-// 使节点朝向目标位置。
+// look_at(node_id, target, use_model_front) -> void
+// 使节点朝向目标位置。目标可为 native_math.Vector3。
 static int l_look_at(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
-	const double x = luaL_checknumber(p_L, 2);
-	const double y = luaL_checknumber(p_L, 3);
-	const double z = luaL_checknumber(p_L, 4);
-	const bool use_model_front = lua_toboolean(p_L, 5);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
+	godot::Vector3 target;
+	const int consumed = math_check_vector3(p_L, 2, target);
+	const bool use_model_front = lua_toboolean(p_L, 2 + consumed);
 
 	godot::Node3D *node = _try_resolve_node3d(node_id);
 	if (node == nullptr) {
-		godot::UtilityFunctions::printerr("native_transform.look_at: node is not Node3D, id=", (uint64_t)node_id);
+		LUAGD_REPORT_ERROR("native_transform", "look_at", "node is not Node3D, id=", (uint64_t)node_id);
 		return 0;
 	}
 
-	const godot::Vector3 target((float)x, (float)y, (float)z);
 	node->look_at(target, godot::Vector3(0.0f, 1.0f, 0.0f), use_model_front);
 	return 0;
 }
 
-// get_forward(node_id, is_global, use_model_front) -> x, y, z
-// 获取节点前向向量。
+// get_forward(node_id, is_global, use_model_front, out) -> x, y, z | out
+// 获取节点前向向量。out 为 native_math.Vector3 时写入 out 并返回它。
 static int l_get_forward(lua_State *p_L) {
-	const godot::ObjectID node_id = _read_node_id(p_L, 1);
+	const NodeHandle node_id = _read_node_id(p_L, 1);
 	const bool is_global = lua_toboolean(p_L, 2);
 	const bool use_model_front = lua_toboolean(p_L, 3);
 
 	godot::Node3D *node = _try_resolve_node3d(node_id);
 	if (node == nullptr) {
-		godot::UtilityFunctions::printerr("native_transform.get_forward: node is not Node3D, id=", (uint64_t)node_id);
+		LUAGD_REPORT_ERROR("native_transform", "get_forward", "node is not Node3D, id=", (uint64_t)node_id);
 		return 0;
 	}
 
 	const godot::Basis basis = is_global ? node->get_global_transform().basis : node->get_transform().basis;
 	const godot::Vector3 forward = use_model_front ? basis.get_column(2) : -basis.get_column(2);
-	lua_pushnumber(p_L, forward.x);
-	lua_pushnumber(p_L, forward.y);
-	lua_pushnumber(p_L, forward.z);
+	return math_return_vector3(p_L, 4, forward);
+}
+
+// set_transform(node_id, transform, is_global) -> void
+// 以 native_math.Transform3D 设置节点变换。仅支持 Node3D。
+static int l_set_transform(lua_State *p_L) {
+	const NodeHandle node_id = _read_node_id(p_L, 1);
+	const godot::Transform3D *transform = math_test_transform(p_L, 2);
+	luaL_argexpected(p_L, transform != nullptr, 2, "native_math.Transform3D");
+	const bool is_global = lua_toboolean(p_L, 3);
+
+	godot::Node3D *node = _try_resolve_node3d(node_id);
+	if (node == nullptr) {
+		LUAGD_REPORT_ERROR("native_transform", "set_transform", "node is not Node3D, id=", (uint64_t)node_id);
+		return 0;
+	}
+
+	if (is_global) {
+		node->set_global_transform(*transform);
+	} else {
+		node->set_transform(*transform);
+	}
+	return 0;
+}
+
+// get_transform(node_id, is_global, out) -> Transform3D | nil
+// 获取节点变换。out 为 native_math.Transform3D 时写入 out 并返回它，否则新建。仅支持 Node3D。
+static int l_get_transform(lua_State *p_L) {
+	const NodeHandle node_id = _read_node_id(p_L, 1);
+	const bool is_global = lua_toboolean(p_L, 2);
+
+	godot::Node3D *node = _try_resolve_node3d(node_id);
+	if (node == nullptr) {
+		LUAGD_REPORT_ERROR("native_transform", "get_transform", "node is not Node3D, id=", (uint64_t)node_id);
+		return 0;
+	}
+
+	const godot::Transform3D transform = is_global ? node->get_global_transform() : node->get_transform();
+	godot::Transform3D *out = math_test_transform(p_L, 3);
+	if (out != nullptr) {
+		*out = transform;
+		lua_pushvalue(p_L, 3);
+	} else {
+		math_push_transform(p_L, transform);
+	}
+	return 1;
+}
+
+// ============================================================================
+// 批量接口：ids 为句柄数组，values 为按实体连续排列的 float 数据（FloatBuffer 或 Lua 数组），
+// 一次调用处理所有实体。单个实体无效时报告错误并跳过，不影响其余实体。
+// ============================================================================
+
+static const float DEG_TO_RAD = 0.017453292519943295f;
+static const float RAD_TO_DEG = 57.29577951308232f;
+
+// 批量接口的 float 数据：FloatBuffer 直接读写内存，Lua 表逐项 rawget / rawset。
+struct BatchFloats {
+	float *data;
+	int table_index;
+	uint32_t size;
+};
+
+static void _open_floats(lua_State *p_L, int p_index, BatchFloats &r_floats) {
+	r_floats.table_index = lua_absindex(p_L, p_index);
+	r_floats.data = lua_float_buffer_test(p_L, p_index, &r_floats.size);
+	if (r_floats.data == nullptr) {
+		luaL_argexpected(p_L, lua_istable(p_L, p_index), p_index, "FloatBuffer or table");
+		r_floats.size = (uint32_t)lua_rawlen(p_L, p_index);
+	}
+}
+
+static float _read_float(lua_State *p_L, const BatchFloats &p_floats, uint32_t p_offset) {
+	if (p_floats.data != nullptr) {
+		return p_floats.data[p_offset];
+	}
+	lua_rawgeti(p_L, p_floats.table_index, (lua_Integer)p_offset + 1);
+	const float value = (float)lua_tonumber(p_L, -1);
+	lua_pop(p_L, 1);
+	return value;
+}
+
+static void _write_float(lua_State *p_L, const BatchFloats &p_floats, uint32_t p_offset, float p_value) {
+	if (p_floats.data != nullptr) {
+		p_floats.data[p_offset] = p_value;
+		return;
+	}
+	lua_pushnumber(p_L, p_value);
+	lua_rawseti(p_L, p_floats.table_index, (lua_Integer)p_offset + 1);
+}
+
+static godot::Vector3 _read_vector3(lua_State *p_L, const BatchFloats &p_floats, uint32_t p_offset) {
+	return godot::Vector3(
+			_read_float(p_L, p_floats, p_offset),
+			_read_float(p_L, p_floats, p_offset + 1),
+			_read_float(p_L, p_floats, p_offset + 2));
+}
+
+// 检查句柄数组并返回实体数；p_values_index 处的数据至少需要 实体数 * p_stride 个元素。
+static uint32_t _open_batch(lua_State *p_L, int p_values_index, uint32_t p_stride, BatchFloats &r_values) {
+	luaL_checktype(p_L, 1, LUA_TTABLE);
+	const uint32_t count = (uint32_t)lua_rawlen(p_L, 1);
+	_open_floats(p_L, p_values_index, r_values);
+	luaL_argcheck(p_L, (uint64_t)r_values.size >= (uint64_t)count * p_stride, p_values_index, "not enough values for ids");
+	return count;
+}
+
+static NodeHandle _read_batch_id(lua_State *p_L, uint32_t p_index) {
+	lua_rawgeti(p_L, 1, (lua_Integer)p_index + 1);
+	const NodeHandle node_id = node_check_handle(p_L, -1);
+	lua_pop(p_L, 1);
+	return node_id;
+}
+
+// set_positions(ids, values, is_global) -> integer
+// 批量设置位置，values 每个实体 3 个元素 (x, y, z)。Control 使用 (x, y)，忽略 z。
+// 返回：成功设置的实体数。
+static int l_set_positions(lua_State *p_L) {
+	LUAGD_TRACE_ZONE("native_transform.set_positions");
+	BatchFloats values;
+	const uint32_t count = _open_batch(p_L, 2, 3, values);
+	const bool is_global = lua_toboolean(p_L, 3);
+
+	uint32_t applied = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		const NodeHandle node_id = _read_batch_id(p_L, i);
+		const godot::Vector3 position = _read_vector3(p_L, values, i * 3);
+
+		godot::Node3D *node3d = _try_resolve_node3d(node_id);
+		if (node3d != nullptr) {
+			if (is_global) {
+				node3d->set_global_position(position);
+			} else {
+				node3d->set_position(position);
+			}
+			applied++;
+			continue;
+		}
+
+		godot::Control *control = _try_resolve_control(node_id);
+		if (control != nullptr) {
+			const godot::Vector2 position_2d(position.x, position.y);
+			if (is_global) {
+				control->set_global_position(position_2d);
+			} else {
+				control->set_position(position_2d);
+			}
+			applied++;
+			continue;
+		}
+
+		LUAGD_REPORT_ERROR("native_transform", "set_positions", "node is not Node3D or Control, id=", (uint64_t)node_id);
+	}
+
+	lua_pushinteger(p_L, (lua_Integer)applied);
+	return 1;
+}
+
+// get_positions(ids, is_global, out) -> out
+// 批量读取位置，每个实体写入 3 个元素 (x, y, z)。Control 写入 (x, y, 0)，无效实体写入 (0, 0, 0)。
+// out 可为 FloatBuffer 或 Lua 表，省略时新建 Lua 表。
+static int l_get_positions(lua_State *p_L) {
+	LUAGD_TRACE_ZONE("native_transform.get_positions");
+	luaL_checktype(p_L, 1, LUA_TTABLE);
+	const bool is_global = lua_toboolean(p_L, 2);
+	const uint32_t count = (uint32_t)lua_rawlen(p_L, 1);
+	if (lua_isnoneornil(p_L, 3)) {
+		lua_settop(p_L, 2);
+		lua_createtable(p_L, (int)(count * 3), 0);
+	}
+
+	BatchFloats out;
+	_open_floats(p_L, 3, out);
+	if (out.data != nullptr) {
+		luaL_argcheck(p_L, (uint64_t)out.size >= (uint64_t)count * 3, 3, "buffer too small for ids");
+	}
+
+	for (uint32_t i = 0; i < count; i++) {
+		const NodeHandle node_id = _read_batch_id(p_L, i);
+		godot::Vector3 position;
+
+		godot::Node3D *node3d = _try_resolve_node3d(node_id);
+		if (node3d != nullptr) {
+			position = is_global ? node3d->get_global_position() : node3d->get_position();
+		} else {
+			godot::Control *control = _try_resolve_control(node_id);
+			if (control != nullptr) {
+				const godot::Vector2 position_2d = is_global ? control->get_global_position() : control->get_position();
+				position = godot::Vector3(position_2d.x, position_2d.y, 0.0f);
+			} else {
+				LUAGD_REPORT_ERROR("native_transform", "get_positions", "node is not Node3D or Control, id=", (uint64_t)node_id);
+			}
+		}
+
+		_write_float(p_L, out, i * 3, position.x);
+		_write_float(p_L, out, i * 3 + 1, position.y);
+		_write_float(p_L, out, i * 3 + 2, position.z);
+	}
+
+	lua_settop(p_L, 3);
+	return 1;
+}
+
+// set_rotations(ids, values, is_global) -> integer
+// 批量设置旋转（度数），values 每个实体 3 个元素 (x, y, z)。仅支持 Node3D。
+// 返回：成功设置的实体数。
+static int l_set_rotations(lua_State *p_L) {
+	LUAGD_TRACE_ZONE("native_transform.set_rotations");
+	BatchFloats values;
+	const uint32_t count = _open_batch(p_L, 2, 3, values);
+	const bool is_global = lua_toboolean(p_L, 3);
+
+	uint32_t applied = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		const NodeHandle node_id = _read_batch_id(p_L, i);
+		godot::Node3D *node = _try_resolve_node3d(node_id);
+		if (node == nullptr) {
+			LUAGD_REPORT_ERROR("native_transform", "set_rotations", "node is not Node3D, id=", (uint64_t)node_id);
+			continue;
+		}
+
+		const godot::Vector3 rotation = _read_vector3(p_L, values, i * 3);
+		if (is_global) {
+			node->set_global_rotation_degrees(rotation);
+		} else {
+			node->set_rotation_degrees(rotation);
+		}
+		applied++;
+	}
+
+	lua_pushinteger(p_L, (lua_Integer)applied);
+	return 1;
+}
+
+// set_transforms(ids, values, is_global) -> integer
+// 批量设置位置、旋转（度数）与缩放，values 每个实体 9 个元素：
+// (px, py, pz, rx, ry, rz, sx, sy, sz)。
+// Node3D: 按节点的 rotation_order 合成 Transform3D，每个实体只调用一次 set_transform / set_global_transform。
+// Control: 使用 (px, py)、rz 与 (sx, sy)；is_global 只影响位置（Control 无全局旋转与缩放）。
+// 返回：成功设置的实体数。
+static int l_set_transforms(lua_State *p_L) {
+	LUAGD_TRACE_ZONE("native_transform.set_transforms");
+	BatchFloats values;
+	const uint32_t count = _open_batch(p_L, 2, 9, values);
+	const bool is_global = lua_toboolean(p_L, 3);
+
+	uint32_t applied = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		const NodeHandle node_id = _read_batch_id(p_L, i);
+		const uint32_t offset = i * 9;
+		const godot::Vector3 position = _read_vector3(p_L, values, offset);
+		const godot::Vector3 rotation = _read_vector3(p_L, values, offset + 3);
+		const godot::Vector3 scale = _read_vector3(p_L, values, offset + 6);
+
+		godot::Node3D *node3d = _try_resolve_node3d(node_id);
+		if (node3d != nullptr) {
+			godot::Basis basis;
+			basis.set_euler_scale(rotation * DEG_TO_RAD, scale, node3d->get_rotation_order());
+			const godot::Transform3D transform(basis, position);
+			if (is_global) {
+				node3d->set_global_transform(transform);
+			} else {
+				node3d->set_transform(transform);
+			}
+			applied++;
+			continue;
+		}
+
+		godot::Control *control = _try_resolve_control(node_id);
+		if (control != nullptr) {
+			const godot::Vector2 position_2d(position.x, position.y);
+			if (is_global) {
+				control->set_global_position(position_2d);
+			} else {
+				control->set_position(position_2d);
+			}
+			control->set_rotation_degrees(rotation.z);
+			control->set_scale(godot::Vector2(scale.x, scale.y));
+			applied++;
+			continue;
+		}
+
+		LUAGD_REPORT_ERROR("native_transform", "set_transforms", "node is not Node3D or Control, id=", (uint64_t)node_id);
+	}
+
+	lua_pushinteger(p_L, (lua_Integer)applied);
+	return 1;
+}
+
+// ============================================================================
+// 变换组：登记的 Node3D 的位置 / 旋转（度数）/ 缩放分别保存在三个 FloatBuffer 中（每个实体 3 个元素），
+// 脚本直接读写数组；flush 时只把有变化的实体写回节点，每个实体一次 set_transform。
+// ============================================================================
+
+static const uint32_t GROUP_VALUES_PER_ENTITY = 9;
+
+struct TransformGroup {
+	// 三个 FloatBuffer 由 Lua 持有（registry 引用），组销毁后脚本仍持有的缓冲区照常有效
+	float *positions;
+	float *rotations;
+	float *scales;
+	int positions_ref;
+	int rotations_ref;
+	int scales_ref;
+	uint32_t capacity;
+	godot::LocalVector<NodeHandle> nodes;
+	// 添加时缓存节点的 rotation_order，flush 时不再逐个查询
+	godot::LocalVector<godot::EulerOrder> rotation_orders;
+	// 每个实体上次写回（或读取）时的 9 个值，flush 时与缓冲区比较以发现脚本的写入
+	godot::LocalVector<float> flushed;
+	// 脏位：每个实体 1 位，flush 时与比较结果合并
+	godot::LocalVector<uint64_t> dirty;
+	bool is_global;
+	bool auto_flush;
+};
+
+static godot::HashMap<int32_t, TransformGroup> groups;
+static int32_t next_group_id = 1;
+
+static TransformGroup *_get_group(lua_State *p_L, const char *p_func_name) {
+	const int32_t group_id = (int32_t)luaL_checkinteger(p_L, 1);
+	TransformGroup *group = groups.getptr(group_id);
+	if (group == nullptr) {
+		LUAGD_REPORT_ERROR("native_transform", p_func_name, "invalid group id=", group_id);
+	}
+	return group;
+}
+
+// 读取 1 起始的实体序号，返回 0 起始下标。
+static uint32_t _check_entity_index(lua_State *p_L, const TransformGroup &p_group, int p_arg) {
+	const lua_Integer index = luaL_checkinteger(p_L, p_arg);
+	luaL_argcheck(p_L, index >= 1 && (lua_Unsigned)index <= p_group.nodes.size(), p_arg, "entity index out of range");
+	return (uint32_t)(index - 1);
+}
+
+static void _gather_entity(const TransformGroup &p_group, uint32_t p_index, float *r_values) {
+	memcpy(r_values, p_group.positions + p_index * 3, 3 * sizeof(float));
+	memcpy(r_values + 3, p_group.rotations + p_index * 3, 3 * sizeof(float));
+	memcpy(r_values + 6, p_group.scales + p_index * 3, 3 * sizeof(float));
+}
+
+static void _scatter_entity(TransformGroup &p_group, uint32_t p_index, const float *p_values) {
+	memcpy(p_group.positions + p_index * 3, p_values, 3 * sizeof(float));
+	memcpy(p_group.rotations + p_index * 3, p_values + 3, 3 * sizeof(float));
+	memcpy(p_group.scales + p_index * 3, p_values + 6, 3 * sizeof(float));
+	memcpy(&p_group.flushed[p_index * GROUP_VALUES_PER_ENTITY], p_values, GROUP_VALUES_PER_ENTITY * sizeof(float));
+}
+
+// 从节点读取变换写入缓冲区与快照。
+static void _pull_entity(TransformGroup &p_group, uint32_t p_index, godot::Node3D *p_node) {
+	const godot::Transform3D transform = p_group.is_global ? p_node->get_global_transform() : p_node->get_transform();
+	const godot::Vector3 rotation = transform.basis.orthonormalized().get_euler(p_group.rotation_orders[p_index]) * RAD_TO_DEG;
+	const godot::Vector3 scale = transform.basis.get_scale();
+	const float values[GROUP_VALUES_PER_ENTITY] = {
+		(float)transform.origin.x, (float)transform.origin.y, (float)transform.origin.z,
+		(float)rotation.x, (float)rotation.y, (float)rotation.z,
+		(float)scale.x, (float)scale.y, (float)scale.z
+	};
+	_scatter_entity(p_group, p_index, values);
+}
+
+static bool _push_entity(TransformGroup &p_group, uint32_t p_index, const float *p_values) {
+	godot::Node3D *node = _try_resolve_node3d(p_group.nodes[p_index]);
+	if (node == nullptr) {
+		return false;
+	}
+
+	godot::Basis basis;
+	basis.set_euler_scale(godot::Vector3(p_values[3], p_values[4], p_values[5]) * DEG_TO_RAD,
+			godot::Vector3(p_values[6], p_values[7], p_values[8]), p_group.rotation_orders[p_index]);
+	const godot::Transform3D transform(basis, godot::Vector3(p_values[0], p_values[1], p_values[2]));
+	if (p_group.is_global) {
+		node->set_global_transform(transform);
+	} else {
+		node->set_transform(transform);
+	}
+	return true;
+}
+
+// 把有变化或被标记的实体写回节点。
+// 返回：写回的实体数。
+static uint32_t _flush_group(TransformGroup &p_group) {
+	const uint32_t count = p_group.nodes.size();
+	uint32_t written = 0;
+	for (uint32_t base = 0; base < count; base += 64) {
+		const uint32_t end = base + 64 < count ? base + 64 : count;
+		uint64_t mask = p_group.dirty[base / 64];
+		for (uint32_t i = base; i < end; i++) {
+			float values[GROUP_VALUES_PER_ENTITY];
+			_gather_entity(p_group, i, values);
+			if (memcmp(values, &p_group.flushed[i * GROUP_VALUES_PER_ENTITY], sizeof(values)) != 0) {
+				mask |= (uint64_t)1 << (i - base);
+			}
+		}
+		p_group.dirty[base / 64] = 0;
+		if (mask == 0) {
+			continue;
+		}
+
+		for (uint32_t i = base; i < end; i++) {
+			if ((mask & ((uint64_t)1 << (i - base))) == 0) {
+				continue;
+			}
+			float *snapshot = &p_group.flushed[i * GROUP_VALUES_PER_ENTITY];
+			_gather_entity(p_group, i, snapshot);
+			// 节点失效时同样更新快照，避免每帧重复尝试
+			if (_push_entity(p_group, i, snapshot)) {
+				written++;
+			} else {
+				LUAGD_REPORT_ERROR("native_transform", "group_flush", "node is not Node3D, id=", (uint64_t)p_group.nodes[i]);
+			}
+		}
+	}
+	return written;
+}
+
+static int _push_group_buffer(lua_State *p_L, int p_ref) {
+	lua_rawgeti(p_L, LUA_REGISTRYINDEX, p_ref);
+	return 1;
+}
+
+// create_group(capacity, is_global) -> group_id
+// 创建变换组。缓冲区按容量一次分配，之后地址不变。
+// is_global 为 true 时读写世界变换，否则为局部变换。
+static int l_create_group(lua_State *p_L) {
+	const lua_Integer capacity = luaL_checkinteger(p_L, 1);
+	luaL_argcheck(p_L, capacity >= 1 && capacity <= (lua_Integer)(LUA_FLOAT_BUFFER_MAX_SIZE / 3), 1, "capacity out of range");
+	const bool is_global = lua_toboolean(p_L, 2);
+
+	TransformGroup group;
+	group.capacity = (uint32_t)capacity;
+	group.positions = lua_float_buffer_new(p_L, group.capacity * 3);
+	group.positions_ref = luaL_ref(p_L, LUA_REGISTRYINDEX);
+	group.rotations = lua_float_buffer_new(p_L, group.capacity * 3);
+	group.rotations_ref = luaL_ref(p_L, LUA_REGISTRYINDEX);
+	group.scales = lua_float_buffer_new(p_L, group.capacity * 3);
+	group.scales_ref = luaL_ref(p_L, LUA_REGISTRYINDEX);
+	group.nodes.reserve(group.capacity);
+	group.rotation_orders.reserve(group.capacity);
+	group.flushed.resize(group.capacity * GROUP_VALUES_PER_ENTITY);
+	group.dirty.resize((group.capacity + 63) / 64);
+	for (uint32_t i = 0; i < group.dirty.size(); i++) {
+		group.dirty[i] = 0;
+	}
+	group.is_global = is_global;
+	group.auto_flush = true;
+
+	const int32_t group_id = next_group_id++;
+	groups.insert(group_id, group);
+	lua_pushinteger(p_L, group_id);
+	return 1;
+}
+
+// destroy_group(group_id) -> void
+// 销毁变换组，不影响节点。脚本仍持有的缓冲区保持有效，但不再写回。
+static int l_destroy_group(lua_State *p_L) {
+	TransformGroup *group = _get_group(p_L, "destroy_group");
+	if (group == nullptr) {
+		return 0;
+	}
+
+	luaL_unref(p_L, LUA_REGISTRYINDEX, group->positions_ref);
+	luaL_unref(p_L, LUA_REGISTRYINDEX, group->rotations_ref);
+	luaL_unref(p_L, LUA_REGISTRYINDEX, group->scales_ref);
+	for (uint32_t i = 0; i < group->nodes.size(); i++) {
+		node_unretain(group->nodes[i]);
+	}
+	groups.erase((int32_t)lua_tointeger(p_L, 1));
+	return 0;
+}
+
+// group_add(group_id, node_id) -> index | nil
+// 把 Node3D 加入组，读取其当前变换作为初值。
+// 返回：1 起始的实体序号；组已满或节点不是 Node3D 时返回 nil。
+static int l_group_add(lua_State *p_L) {
+	TransformGroup *group = _get_group(p_L, "group_add");
+	const NodeHandle node_id = _read_node_id(p_L, 2);
+	if (group == nullptr) {
+		return 0;
+	}
+
+	godot::Node3D *node = _try_resolve_node3d(node_id);
+	if (node == nullptr) {
+		LUAGD_REPORT_ERROR("native_transform", "group_add", "node is not Node3D, id=", (uint64_t)node_id);
+		return 0;
+	}
+	if (group->nodes.size() >= group->capacity) {
+		LUAGD_REPORT_ERROR("native_transform", "group_add", "group is full, capacity=", group->capacity);
+		return 0;
+	}
+
+	// 组长期持有句柄，记录不能随 userdata 回收释放
+	node_retain(node_id);
+	const uint32_t index = group->nodes.size();
+	group->nodes.push_back(node_id);
+	group->rotation_orders.push_back(node->get_rotation_order());
+	_pull_entity(*group, index, node);
+	lua_pushinteger(p_L, (lua_Integer)index + 1);
+	return 1;
+}
+
+// group_remove(group_id, index) -> moved_from | nil
+// 移除实体：最后一个实体移动到 index 以保持数组紧密。
+// 返回：被移动实体原来的序号；移除的就是最后一个时返回 nil。
+static int l_group_remove(lua_State *p_L) {
+	TransformGroup *group = _get_group(p_L, "group_remove");
+	if (group == nullptr) {
+		return 0;
+	}
+
+	const uint32_t index = _check_entity_index(p_L, *group, 2);
+	const uint32_t last = group->nodes.size() - 1;
+	const NodeHandle removed_node = group->nodes[index];
+	if (index != last) {
+		float values[GROUP_VALUES_PER_ENTITY];
+		_gather_entity(*group, last, values);
+		_scatter_entity(*group, index, values);
+		// 被移动实体的快照随之移动，保留其未写回的变化
+		memcpy(&group->flushed[index * GROUP_VALUES_PER_ENTITY], &group->flushed[last * GROUP_VALUES_PER_ENTITY],
+				GROUP_VALUES_PER_ENTITY * sizeof(float));
+		group->nodes[index] = group->nodes[last];
+		group->rotation_orders[index] = group->rotation_orders[last];
+
+		const uint64_t index_bit = (uint64_t)1 << (index % 64);
+		if ((group->dirty[last / 64] & ((uint64_t)1 << (last % 64))) != 0) {
+			group->dirty[index / 64] |= index_bit;
+		} else {
+			group->dirty[index / 64] &= ~index_bit;
+		}
+	}
+
+	const float zeros[GROUP_VALUES_PER_ENTITY] = {};
+	_scatter_entity(*group, last, zeros);
+	group->dirty[last / 64] &= ~((uint64_t)1 << (last % 64));
+	group->nodes.resize(last);
+	group->rotation_orders.resize(last);
+	node_unretain(removed_node);
+
+	if (index == last) {
+		return 0;
+	}
+	lua_pushinteger(p_L, (lua_Integer)last + 1);
+	return 1;
+}
+
+// group_count(group_id) -> integer
+static int l_group_count(lua_State *p_L) {
+	TransformGroup *group = _get_group(p_L, "group_count");
+	lua_pushinteger(p_L, group != nullptr ? (lua_Integer)group->nodes.size() : 0);
+	return 1;
+}
+
+// group_get_node(group_id, index) -> node_id
+static int l_group_get_node(lua_State *p_L) {
+	TransformGroup *group = _get_group(p_L, "group_get_node");
+	if (group == nullptr) {
+		return 0;
+	}
+	lua_pushinteger(p_L, (lua_Integer)group->nodes[_check_entity_index(p_L, *group, 2)]);
+	return 1;
+}
+
+// group_buffers(group_id) -> positions, rotations, scales
+// 返回组的三个 FloatBuffer，实体 i 的 x, y, z 位于 [(i - 1) * 3 + 1, (i - 1) * 3 + 3]。
+static int l_group_buffers(lua_State *p_L) {
+	TransformGroup *group = _get_group(p_L, "group_buffers");
+	if (group == nullptr) {
+		return 0;
+	}
+	_push_group_buffer(p_L, group->positions_ref);
+	_push_group_buffer(p_L, group->rotations_ref);
+	_push_group_buffer(p_L, group->scales_ref);
 	return 3;
 }
 
+// group_mark_dirty(group_id, index, count) -> void
+// 强制下一次 flush 写回 [index, index + count) 的实体（节点被其他逻辑改动后用缓冲区的值覆盖）。
+static int l_group_mark_dirty(lua_State *p_L) {
+	TransformGroup *group = _get_group(p_L, "group_mark_dirty");
+	if (group == nullptr) {
+		return 0;
+	}
+
+	const uint32_t first = _check_entity_index(p_L, *group, 2);
+	const lua_Integer remaining = (lua_Integer)(group->nodes.size() - first);
+	const lua_Integer count = luaL_optinteger(p_L, 3, 1);
+	const uint32_t end = first + (uint32_t)(count < 0 ? 0 : (count > remaining ? remaining : count));
+	for (uint32_t i = first; i < end; i++) {
+		group->dirty[i / 64] |= (uint64_t)1 << (i % 64);
+	}
+	return 0;
+}
+
+// group_pull(group_id) -> integer
+// 从节点重新读取所有实体的变换（丢弃未写回的修改）。
+// 返回：成功读取的实体数。
+static int l_group_pull(lua_State *p_L) {
+	TransformGroup *group = _get_group(p_L, "group_pull");
+	if (group == nullptr) {
+		return 0;
+	}
+
+	uint32_t pulled = 0;
+	for (uint32_t i = 0; i < group->nodes.size(); i++) {
+		godot::Node3D *node = _try_resolve_node3d(group->nodes[i]);
+		if (node == nullptr) {
+			LUAGD_REPORT_ERROR("native_transform", "group_pull", "node is not Node3D, id=", (uint64_t)group->nodes[i]);
+			continue;
+		}
+		_pull_entity(*group, i, node);
+		pulled++;
+	}
+	for (uint32_t i = 0; i < group->dirty.size(); i++) {
+		group->dirty[i] = 0;
+	}
+
+	lua_pushinteger(p_L, (lua_Integer)pulled);
+	return 1;
+}
+
+// group_flush(group_id) -> integer
+// 立即把有变化的实体写回节点。
+// 返回：写回的实体数。
+static int l_group_flush(lua_State *p_L) {
+	LUAGD_TRACE_ZONE("native_transform.group_flush");
+	TransformGroup *group = _get_group(p_L, "group_flush");
+	if (group == nullptr) {
+		return 0;
+	}
+	lua_pushinteger(p_L, (lua_Integer)_flush_group(*group));
+	return 1;
+}
+
+// group_set_auto_flush(group_id, enabled) -> void
+// 设置是否在每次 update 之后自动 flush（默认开启）。
+static int l_group_set_auto_flush(lua_State *p_L) {
+	TransformGroup *group = _get_group(p_L, "group_set_auto_flush");
+	if (group == nullptr) {
+		return 0;
+	}
+	group->auto_flush = lua_toboolean(p_L, 2);
+	return 0;
+}
+
 static const luaL_Reg transform_funcs[] = {
 	{"set_position", l_set_position},
 	{"get_position", l_get_position},
@@ -279,12 +940,82 @@ static const luaL_Reg transform_funcs[] = {
 	{"get_rotation", l_get_rotation},
 	{"look_at", l_look_at},
 	{"get_forward", l_get_forward},
+	{"set_transform", l_set_transform},
+	{"get_transform", l_get_transform},
+	{"set_positions", l_set_positions},
+	{"get_positions", l_get_positions},
+	{"set_rotations", l_set_rotations},
+	{"set_transforms", l_set_transforms},
+	{"create_group", l_create_group},
+	{"destroy_group", l_destroy_group},
+	{"group_add", l_group_add},
+	{"group_remove", l_group_remove},
+	{"group_count", l_group_count},
+	{"group_get_node", l_group_get_node},
+	{"group_buffers", l_group_buffers},
+	{"group_mark_dirty", l_group_mark_dirty},
+	{"group_pull", l_group_pull},
+	{"group_flush", l_group_flush},
+	{"group_set_auto_flush", l_group_set_auto_flush},
 	{nullptr, nullptr}
 };
 
+// 以节点为第一个参数、作为 native_node.Node 方法暴露的函数
+static const char *const transform_node_methods[] = {
+	"set_position",
+	"get_position",
+	"get_scale",
+	"set_scale",
+	"set_rotation",
+	"get_rotation",
+	"look_at",
+	"get_forward",
+	"set_transform",
+	"get_transform",
+	nullptr
+};
+
 int luaopen_native_transform(lua_State *p_L) {
-	luaL_newlib(p_L, transform_funcs);
+	lua_binding_new_lib(p_L, "native_transform", transform_funcs);
+	node_register_methods(p_L, -1, transform_node_methods);
 	return 1;
 }
 
+void transform_flush_groups() {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_transform.transform_flush_groups") || groups.is_empty()) {
+		return;
+	}
+	LUAGD_TRACE_ZONE("native_transform.flush_groups");
+	for (godot::KeyValue<int32_t, TransformGroup> &entry : groups) {
+		if (entry.value.auto_flush) {
+			_flush_group(entry.value);
+		}
+	}
+}
+
+void transform_collect_memory(godot::LocalVector<HostMemoryTable> &r_tables) {
+	int64_t entities = 0;
+	int64_t bytes = host_memory_hash_map_bytes(groups);
+	for (const godot::KeyValue<int32_t, TransformGroup> &entry : groups) {
+		const TransformGroup &group = entry.value;
+		entities += group.nodes.size();
+		// 三个缓冲区由 Lua 堆持有，同样计入
+		bytes += (int64_t)group.capacity * (3 * 3 * sizeof(float) + sizeof(NodeHandle) + sizeof(godot::EulerOrder) +
+				GROUP_VALUES_PER_ENTITY * sizeof(float));
+		bytes += (int64_t)group.dirty.size() * sizeof(uint64_t);
+	}
+	r_tables.push_back({"native_transform.groups", entities, bytes});
+}
+
+void transform_cleanup() {
+	// 缓冲区引用随 lua_close 一并释放，这里只清理记录并归还节点持有计数
+	for (const godot::KeyValue<int32_t, TransformGroup> &entry : groups) {
+		for (uint32_t i = 0; i < entry.value.nodes.size(); i++) {
+			node_unretain(entry.value.nodes[i]);
+		}
+	}
+	groups.clear();
+	next_group_id = 1;
+}
+
 } // namespace luagd
@@ -1,6 +1,8 @@
 #ifndef LUAGD_TRANSFORM_MODULE_H
 #define LUAGD_TRANSFORM_MODULE_H
 
+#include "../host/host_memory_stats.h"
+
 struct lua_State;
 
 namespace luagd {
@@ -9,6 +11,16 @@ namespace luagd {
 // 提供 Node3D 的基础变换 API。
 int luaopen_native_transform(lua_State *p_L);
 
+// 把所有开启自动 flush 的变换组中有变化的实体写回节点。
+// 约束：只允许在主线程调用。由 LuaHost 在每次 update 之后调用。
+void transform_flush_groups();
+
+// 把模块表的条目数与估算字节数追加到 r_tables，供 host_memory_collect 使用。
+void transform_collect_memory(godot::LocalVector<HostMemoryTable> &r_tables);
+
+// 清理所有变换组。在 LuaRuntime::shutdown 时调用。
+void transform_cleanup();
+
 } // namespace luagd
 
 #endif // LUAGD_TRANSFORM_MODULE_H
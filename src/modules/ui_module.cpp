@@ -2,6 +2,10 @@
 
 #include "node_module.h"
 
+#include "../host/host_error_sink.h"
+#include "../host/host_thread_check.h"
+#include "../lua/lua_binding_stats.h"
+
 #include <godot_cpp/classes/canvas_item.hpp>
 #include <godot_cpp/classes/control.hpp>
 #include <godot_cpp/classes/node.hpp>
@@ -19,28 +23,28 @@ extern "C" {
 
 namespace luagd {
 
-// 从 Lua 栈读取 ObjectID 句柄。
-static godot::ObjectID _read_object_id(lua_State *p_L, int p_index) {
-	return godot::ObjectID((uint64_t)luaL_checkinteger(p_L, p_index));
+// 从 Lua 栈读取 native_node 句柄。
+static NodeHandle _read_object_id(lua_State *p_L, int p_index) {
+	return node_check_handle(p_L, p_index);
 }
 
 // 解析 CanvasItem 节点。
 // 返回：节点对象；句柄为空、对象不存在或类型不符时返回 nullptr。
-static godot::CanvasItem *_resolve_canvas_item(godot::ObjectID p_id, const char *p_func_name) {
-	if (p_id.is_null()) {
-		godot::UtilityFunctions::printerr("native_ui.", p_func_name, ": handle is null");
+static godot::CanvasItem *_resolve_canvas_item(NodeHandle p_id, const char *p_func_name) {
+	if (p_id == 0) {
+		LUAGD_REPORT_ERROR("native_ui", p_func_name, "handle is null");
 		return nullptr;
 	}
 
 	godot::Node *node = node_resolve_any(p_id);
 	if (node == nullptr) {
-		godot::UtilityFunctions::printerr("native_ui.", p_func_name, ": node is no longer valid, handle=", (uint64_t)p_id);
+		LUAGD_REPORT_ERROR("native_ui", p_func_name, "node is no longer valid, handle=", (uint64_t)p_id);
 		return nullptr;
 	}
 
 	godot::CanvasItem *canvas_item = godot::Object::cast_to<godot::CanvasItem>(node);
 	if (canvas_item == nullptr) {
-		godot::UtilityFunctions::printerr("native_ui.", p_func_name, ": node is not a CanvasItem, handle=", (uint64_t)p_id);
+		LUAGD_REPORT_ERROR("native_ui", p_func_name, "node is not a CanvasItem, handle=", (uint64_t)p_id);
 		return nullptr;
 	}
 
@@ -49,7 +53,7 @@ static godot::CanvasItem *_resolve_canvas_item(godot::ObjectID p_id, const char
 
 // 解析 Control 节点。
 // 返回：节点对象；句柄为空、对象不存在或类型不符时返回 nullptr。
-static godot::Control *_resolve_control(godot::ObjectID p_id, const char *p_func_name) {
+static godot::Control *_resolve_control(NodeHandle p_id, const char *p_func_name) {
 	godot::CanvasItem *canvas_item = _resolve_canvas_item(p_id, p_func_name);
 	if (canvas_item == nullptr) {
 		return nullptr;
@@ -57,7 +61,7 @@ static godot::Control *_resolve_control(godot::ObjectID p_id, const char *p_func
 
 	godot::Control *control = godot::Object::cast_to<godot::Control>(canvas_item);
 	if (control == nullptr) {
-		godot::UtilityFunctions::printerr("native_ui.", p_func_name, ": object is not a Control, handle=", (uint64_t)p_id);
+		LUAGD_REPORT_ERROR("native_ui", p_func_name, "object is not a Control, handle=", (uint64_t)p_id);
 		return nullptr;
 	}
 
@@ -66,7 +70,7 @@ static godot::Control *_resolve_control(godot::ObjectID p_id, const char *p_func
 
 // 解析 Range 节点。
 // 返回：节点对象；句柄为空、对象不存在或类型不符时返回 nullptr。
-static godot::Range *_resolve_range(godot::ObjectID p_id, const char *p_func_name) {
+static godot::Range *_resolve_range(NodeHandle p_id, const char *p_func_name) {
 	godot::Control *control = _resolve_control(p_id, p_func_name);
 	if (control == nullptr) {
 		return nullptr;
@@ -74,7 +78,7 @@ static godot::Range *_resolve_range(godot::ObjectID p_id, const char *p_func_nam
 
 	godot::Range *range = godot::Object::cast_to<godot::Range>(control);
 	if (range == nullptr) {
-		godot::UtilityFunctions::printerr("native_ui.", p_func_name, ": object is not a Range, handle=", (uint64_t)p_id);
+		LUAGD_REPORT_ERROR("native_ui", p_func_name, "object is not a Range, handle=", (uint64_t)p_id);
 		return nullptr;
 	}
 
@@ -83,7 +87,7 @@ static godot::Range *_resolve_range(godot::ObjectID p_id, const char *p_func_nam
 
 // 解析 RichTextLabel 节点。
 // 返回：节点对象；句柄为空、对象不存在或类型不符时返回 nullptr。
-static godot::RichTextLabel *_resolve_rich_text_label(godot::ObjectID p_id, const char *p_func_name) {
+static godot::RichTextLabel *_resolve_rich_text_label(NodeHandle p_id, const char *p_func_name) {
 	godot::Control *control = _resolve_control(p_id, p_func_name);
 	if (control == nullptr) {
 		return nullptr;
@@ -91,7 +95,7 @@ static godot::RichTextLabel *_resolve_rich_text_label(godot::ObjectID p_id, cons
 
 	godot::RichTextLabel *rich_text_label = godot::Object::cast_to<godot::RichTextLabel>(control);
 	if (rich_text_label == nullptr) {
-		godot::UtilityFunctions::printerr("native_ui.", p_func_name, ": object is not a RichTextLabel, handle=", (uint64_t)p_id);
+		LUAGD_REPORT_ERROR("native_ui", p_func_name, "object is not a RichTextLabel, handle=", (uint64_t)p_id);
 		return nullptr;
 	}
 
@@ -102,7 +106,7 @@ static godot::RichTextLabel *_resolve_rich_text_label(godot::ObjectID p_id, cons
 // 获取 CanvasItem 的可见性。
 // 返回：节点无效时返回 false。
 static int l_get_visible(lua_State *p_L) {
-	const godot::ObjectID id = _read_object_id(p_L, 1);
+	const NodeHandle id = _read_object_id(p_L, 1);
 
 	godot::CanvasItem *canvas_item = _resolve_canvas_item(id, "get_visible");
 	if (canvas_item == nullptr) {
@@ -119,11 +123,11 @@ static int l_get_visible(lua_State *p_L) {
 static int l_set_visible(lua_State *p_L) {
 	int argc = lua_gettop(p_L);
 	if (argc < 2) {
-		godot::UtilityFunctions::printerr("native_ui.set_visible: expected 2 args (handle, visible), got ", argc);
+		LUAGD_REPORT_ERROR("native_ui", "set_visible", "expected 2 args (handle, visible), got ", argc);
 		return 0;
 	}
 
-	const godot::ObjectID id = _read_object_id(p_L, 1);
+	const NodeHandle id = _read_object_id(p_L, 1);
 	const bool visible = lua_toboolean(p_L, 2);
 
 	godot::CanvasItem *canvas_item = _resolve_canvas_item(id, "set_visible");
@@ -141,11 +145,11 @@ static int l_set_visible(lua_State *p_L) {
 static int l_set_modulate(lua_State *p_L) {
 	int argc = lua_gettop(p_L);
 	if (argc < 5) {
-		godot::UtilityFunctions::printerr("native_ui.set_modulate: expected 5 args (handle, r, g, b, a), got ", argc);
+		LUAGD_REPORT_ERROR("native_ui", "set_modulate", "expected 5 args (handle, r, g, b, a), got ", argc);
 		return 0;
 	}
 
-	const godot::ObjectID id = _read_object_id(p_L, 1);
+	const NodeHandle id = _read_object_id(p_L, 1);
 	const double r = luaL_checknumber(p_L, 2);
 	const double g = luaL_checknumber(p_L, 3);
 	const double b = luaL_checknumber(p_L, 4);
@@ -165,7 +169,7 @@ static int l_set_modulate(lua_State *p_L) {
 // 获取 Range 的值。
 // 返回：节点无效时返回 0.0。
 static int l_get_bar_value(lua_State *p_L) {
-	const godot::ObjectID id = _read_object_id(p_L, 1);
+	const NodeHandle id = _read_object_id(p_L, 1);
 
 	godot::Range *range = _resolve_range(id, "get_bar_value");
 	if (range == nullptr) {
@@ -183,11 +187,11 @@ static int l_get_bar_value(lua_State *p_L) {
 static int l_set_bar_value(lua_State *p_L) {
 	int argc = lua_gettop(p_L);
 	if (argc < 2) {
-		godot::UtilityFunctions::printerr("native_ui.set_bar_value: expected 2 args (handle, value), got ", argc);
+		LUAGD_REPORT_ERROR("native_ui", "set_bar_value", "expected 2 args (handle, value), got ", argc);
 		return 0;
 	}
 
-	const godot::ObjectID id = _read_object_id(p_L, 1);
+	const NodeHandle id = _read_object_id(p_L, 1);
 	const double value = luaL_checknumber(p_L, 2);
 
 	godot::Range *range = _resolve_range(id, "set_bar_value");
@@ -203,7 +207,7 @@ static int l_set_bar_value(lua_State *p_L) {
 // 获取 Control 节点的尺寸（宽度与高度）。
 // 返回：节点无效时返回 0.0, 0.0。
 static int l_get_size(lua_State *p_L) {
-	const godot::ObjectID id = _read_object_id(p_L, 1);
+	const NodeHandle id = _read_object_id(p_L, 1);
 
 	godot::Control *control = _resolve_control(id, "get_size");
 	if (control == nullptr) {
@@ -222,7 +226,7 @@ static int l_get_size(lua_State *p_L) {
 // 获取 RichTextLabel 的文本内容。
 // 返回：节点无效时返回空字符串。
 static int l_get_text(lua_State *p_L) {
-	const godot::ObjectID id = _read_object_id(p_L, 1);
+	const NodeHandle id = _read_object_id(p_L, 1);
 
 	godot::RichTextLabel *rich_text_label = _resolve_rich_text_label(id, "get_text");
 	if (rich_text_label == nullptr) {
@@ -240,11 +244,11 @@ static int l_get_text(lua_State *p_L) {
 static int l_set_text(lua_State *p_L) {
 	int argc = lua_gettop(p_L);
 	if (argc < 2) {
-		godot::UtilityFunctions::printerr("native_ui.set_text: expected 2 args (handle, text), got ", argc);
+		LUAGD_REPORT_ERROR("native_ui", "set_text", "expected 2 args (handle, text), got ", argc);
 		return 0;
 	}
 
-	const godot::ObjectID id = _read_object_id(p_L, 1);
+	const NodeHandle id = _read_object_id(p_L, 1);
 	const char *text = luaL_checkstring(p_L, 2);
 
 	godot::RichTextLabel *rich_text_label = _resolve_rich_text_label(id, "set_text");
@@ -268,8 +272,22 @@ static const luaL_Reg ui_funcs[] = {
 	{nullptr, nullptr}
 };
 
+// 以节点为第一个参数、作为 native_node.Node 方法暴露的函数
+static const char *const ui_node_methods[] = {
+	"get_visible",
+	"set_visible",
+	"set_modulate",
+	"get_bar_value",
+	"set_bar_value",
+	"get_size",
+	"get_text",
+	"set_text",
+	nullptr
+};
+
 int luaopen_native_ui(lua_State *p_L) {
-	luaL_newlib(p_L, ui_funcs);
+	lua_binding_new_lib(p_L, "native_ui", ui_funcs);
+	node_register_methods(p_L, -1, ui_node_methods);
 	return 1;
 }
 
@@ -0,0 +1,74 @@
+#include "worker_module.h"
+
+#include "../host/host_thread_check.h"
+#include "../lua/lua_binding_stats.h"
+#include "../lua/lua_worker_pool.h"
+
+extern "C" {
+#include <lua.h>
+#include <lauxlib.h>
+}
+
+namespace luagd {
+
+// native_worker.configure(script_path, [worker_count]) -> bool
+// 设置任务脚本与 worker 数量。仍有未完成任务时失败。
+// worker_count: 默认（或 <= 0）为 CPU 核数 - 1。
+static int l_configure(lua_State *p_L) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_worker.configure")) {
+		lua_pushboolean(p_L, 0);
+		return 1;
+	}
+
+	const char *script_path = luaL_checkstring(p_L, 1);
+	const int worker_count = (int)luaL_optinteger(p_L, 2, 0);
+	lua_pushboolean(p_L, lua_worker_pool_configure(godot::String::utf8(script_path), worker_count));
+	return 1;
+}
+
+// native_worker.submit(job_name, callback, ...) -> integer | nil
+// 提交任务，参数经序列化传给 worker。
+// callback: fun(ok, ...)，在主线程 tick 中调用；为 nil 时忽略结果。
+// 返回：任务 id，失败返回 nil。
+static int l_submit(lua_State *p_L) {
+	if (!LUAGD_ENSURE_MAIN_THREAD("native_worker.submit")) {
+		return 0;
+	}
+
+	const char *job_name = luaL_checkstring(p_L, 1);
+	const int64_t job_id = lua_worker_pool_submit(p_L, job_name, 2, 3);
+	if (job_id < 0) {
+		return 0;
+	}
+	lua_pushinteger(p_L, (lua_Integer)job_id);
+	return 1;
+}
+
+// native_worker.pending() -> integer
+// 返回：排队中与执行中的任务数。
+static int l_pending(lua_State *p_L) {
+	lua_pushinteger(p_L, lua_worker_pool_get_pending_count());
+	return 1;
+}
+
+// native_worker.worker_count() -> integer
+// 返回：worker 数量，未配置时为 0。
+static int l_worker_count(lua_State *p_L) {
+	lua_pushinteger(p_L, lua_worker_pool_get_worker_count());
+	return 1;
+}
+
+static const luaL_Reg worker_funcs[] = {
+	{"configure", l_configure},
+	{"submit", l_submit},
+	{"pending", l_pending},
+	{"worker_count", l_worker_count},
+	{nullptr, nullptr}
+};
+
+int luaopen_native_worker(lua_State *p_L) {
+	lua_binding_new_lib(p_L, "native_worker", worker_funcs);
+	return 1;
+}
+
+} // namespace luagd
@@ -0,0 +1,15 @@
+#ifndef LUAGD_WORKER_MODULE_H
+#define LUAGD_WORKER_MODULE_H
+
+struct lua_State;
+
+namespace luagd {
+
+// 打开 native_worker 模块。
+// 提供工作线程任务池的配置与任务提交，详见 lua_worker_pool.h。
+// 返回：在 Lua 栈上返回 1（模块表）。
+int luaopen_native_worker(lua_State *p_L);
+
+} // namespace luagd
+
+#endif // LUAGD_WORKER_MODULE_H